@@ -27,6 +27,7 @@ Please remove when issue is resolved
 #include "Petra_Converters.hpp"
 #include "Epetra_LinearProblem.h"
 #include "AztecOO.h"
+#include "BoundingBoxGrid.h"
 
 #ifdef ATO_USES_ISOLIB
 #include "Albany_STKDiscretization.hpp"
@@ -1850,52 +1851,63 @@ ATO::SpatialFilter::buildOperator(
     std::map< GlobalPoint, std::set<GlobalPoint> > neighbors;
   
     double filter_radius_sqrd = filterRadius*filterRadius;
-    // awful n^2 search... all against all
     size_t dimension   = app->getDiscretization()->getNumDim();
-    GlobalPoint homeNode;
     size_t num_worksets = coords.size();
-    for (size_t home_ws=0; home_ws<num_worksets; home_ws++) {
-      int home_num_cells = coords[home_ws].size();
-      for (int home_cell=0; home_cell<home_num_cells; home_cell++) {
-        size_t num_nodes = coords[home_ws][home_cell].size();
-        for (int home_node=0; home_node<num_nodes; home_node++) {
-          homeNode.gid = wsElNodeID[home_ws][home_cell][home_node];
-          if(neighbors.find(homeNode)==neighbors.end()) {  // if this node was already accessed just skip
-            for (int dim=0; dim<dimension; dim++)  {
-              homeNode.coords[dim] = coords[home_ws][home_cell][home_node][dim];
-            }
-            std::set<GlobalPoint> my_neighbors;
-            if( excludeNodes.find(homeNode.gid) == excludeNodes.end() ){
-              for (size_t trial_ws=0; trial_ws<num_worksets; trial_ws++) {
-                if( blocks.size() > 0 && 
-                    find(blocks.begin(), blocks.end(), wsEBNames[trial_ws]) == blocks.end() ) continue;
-                int trial_num_cells = coords[trial_ws].size();
-                for (int trial_cell=0; trial_cell<trial_num_cells; trial_cell++) {
-                  size_t trial_num_nodes = coords[trial_ws][trial_cell].size();
-                  for (int trial_node=0; trial_node<trial_num_nodes; trial_node++) {
-                    int gid = wsElNodeID[trial_ws][trial_cell][trial_node];
-                    if( excludeNodes.find(gid) != excludeNodes.end() ) continue; // don't add excluded nodes
-                    double tmp;
-                    double delta_norm_sqr = 0.;
-                    for (int dim=0; dim<dimension; dim++)  { //individual coordinates
-                      tmp = homeNode.coords[dim]-coords[trial_ws][trial_cell][trial_node][dim];
-                      delta_norm_sqr += tmp*tmp;
-                    }
-                    if(delta_norm_sqr<=filter_radius_sqrd) {
-                      GlobalPoint newIntx;
-                      newIntx.gid = wsElNodeID[trial_ws][trial_cell][trial_node];
-                      for (int dim=0; dim<dimension; dim++) 
-                        newIntx.coords[dim] = coords[trial_ws][trial_cell][trial_node][dim];
-                      my_neighbors.insert(newIntx);
-                    }
-                  }
-                }
-              }
-            }
-            neighbors.insert( std::pair<GlobalPoint,std::set<GlobalPoint> >(homeNode,my_neighbors) );
+
+    // gather the unique nodes, and the subset of them that can be neighbors
+    std::vector<GlobalPoint> homeNodes;
+    std::vector<GlobalPoint> trialNodes;
+    std::set<int> visitedHome, visitedTrial;
+    for (size_t ws=0; ws<num_worksets; ws++) {
+      bool trialBlock = blocks.size() == 0 || 
+        find(blocks.begin(), blocks.end(), wsEBNames[ws]) != blocks.end();
+      int num_cells = coords[ws].size();
+      for (int cell=0; cell<num_cells; cell++) {
+        size_t num_nodes = coords[ws][cell].size();
+        for (int node=0; node<num_nodes; node++) {
+          GlobalPoint point;
+          point.gid = wsElNodeID[ws][cell][node];
+          for (int dim=0; dim<dimension; dim++)
+            point.coords[dim] = coords[ws][cell][node][dim];
+          if( visitedHome.insert(point.gid).second ) homeNodes.push_back(point);
+          if( trialBlock == false ) continue;
+          if( excludeNodes.find(point.gid) != excludeNodes.end() ) continue; // don't add excluded nodes
+          if( visitedTrial.insert(point.gid).second ) trialNodes.push_back(point);
+        }
+      }
+    }
+
+    // bin the trial nodes in a bucket grid with cells about the filter radius
+    // in size so each node is only compared with the trial nodes nearby.
+    std::vector<LCM::BoundingBoxGrid::Box> trialBoxes(trialNodes.size());
+    for (size_t i=0; i<trialNodes.size(); i++) {
+      for (int dim=0; dim<dimension; dim++) {
+        trialBoxes[i].lo[dim] = trialNodes[i].coords[dim];
+        trialBoxes[i].hi[dim] = trialNodes[i].coords[dim];
+      }
+      LCM::BoundingBoxGrid::inflate(trialBoxes[i], dimension, 0.0, filterRadius/2.0);
+    }
+    LCM::BoundingBoxGrid trialGrid;
+    trialGrid.build(dimension, trialBoxes);
+
+    std::vector<int> candidates;
+    for (size_t home=0; home<homeNodes.size(); home++) {
+      GlobalPoint& homeNode = homeNodes[home];
+      std::set<GlobalPoint> my_neighbors;
+      if( excludeNodes.find(homeNode.gid) == excludeNodes.end() ){
+        trialGrid.query(homeNode.coords, filterRadius, candidates);
+        for (size_t i=0; i<candidates.size(); i++) {
+          const GlobalPoint& trialNode = trialNodes[candidates[i]];
+          double tmp;
+          double delta_norm_sqr = 0.;
+          for (int dim=0; dim<dimension; dim++)  { //individual coordinates
+            tmp = homeNode.coords[dim]-trialNode.coords[dim];
+            delta_norm_sqr += tmp*tmp;
           }
+          if(delta_norm_sqr<=filter_radius_sqrd) my_neighbors.insert(trialNode);
         }
       }
+      neighbors.insert( std::pair<GlobalPoint,std::set<GlobalPoint> >(homeNode,my_neighbors) );
     }
 
     // communicate neighbor data
@@ -1903,39 +1915,46 @@ ATO::SpatialFilter::buildOperator(
     
     // for each interior node, search boundary nodes for additional interactions off processor.
     
-    // now build filter operator
-    int numnonzeros = 0;
-    Teuchos::RCP<const Epetra_Comm> comm = 
-      Albany::createEpetraCommFromTeuchosComm(localNodeMapT->getComm());
-    Teuchos::RCP<const Epetra_Map> localNodeMap = Petra::TpetraMap_To_EpetraMap(localNodeMapT, comm);
-    filterOperatorT = Teuchos::rcp(new Tpetra_CrsMatrix(localNodeMapT,numnonzeros));
+    // now build filter operator.  Only locally owned rows are assembled, rows 
+    // of ghosted nodes would only contribute structural zeros to their owners.
+    // Preallocate each row with the size of its neighborhood.
+    size_t numLocalRows = localNodeMapT->getNodeNumElements();
+    Teuchos::ArrayRCP<size_t> numEntriesPerRow(numLocalRows, 1);
+    for (std::map<GlobalPoint,std::set<GlobalPoint> >::iterator 
+        it=neighbors.begin(); it!=neighbors.end(); ++it) { 
+      Tpetra_LO home_node_lid = localNodeMapT->getLocalElement(it->first.gid);
+      if( home_node_lid == Teuchos::OrdinalTraits<Tpetra_LO>::invalid() ) continue;
+      numEntriesPerRow[home_node_lid] = std::max<size_t>(it->second.size(), 1);
+    }
+    filterOperatorT = Teuchos::rcp(new Tpetra_CrsMatrix(localNodeMapT,
+        Teuchos::ArrayRCP<const size_t>(numEntriesPerRow), Tpetra::StaticProfile));
+    Teuchos::Array<Tpetra_GO> indicesT;
+    Teuchos::Array<ST> weightsT;
     for (std::map<GlobalPoint,std::set<GlobalPoint> >::iterator 
         it=neighbors.begin(); it!=neighbors.end(); ++it) { 
-      GlobalPoint homeNode = it->first;
+      const GlobalPoint& homeNode = it->first;
       Tpetra_GO home_node_gid = homeNode.gid;
-      std::set<GlobalPoint> connected_nodes = it->second;
-      ST weight; 
-      ST zero = 0.0;  
-      Teuchos::Array<ST> weightT(1);
+      if( !localNodeMapT->isNodeGlobalElement(home_node_gid) ) continue;
+      const std::set<GlobalPoint>& connected_nodes = it->second;
+      indicesT.clear();
+      weightsT.clear();
       if( connected_nodes.size() > 0 ){
-        for (std::set<GlobalPoint>::iterator 
+        for (std::set<GlobalPoint>::const_iterator 
              set_it=connected_nodes.begin(); set_it!=connected_nodes.end(); ++set_it) {
-           Tpetra_GO neighbor_node_gid = set_it->gid;
            const double* coords = &(set_it->coords[0]);
            double distance = 0.0;
            for (int dim=0; dim<dimension; dim++) 
              distance += (coords[dim]-homeNode.coords[dim])*(coords[dim]-homeNode.coords[dim]);
            distance = (distance > 0.0) ? sqrt(distance) : 0.0;
-           weight = filterRadius - distance;
-           filterOperatorT->insertGlobalValues(home_node_gid,1,&zero,&neighbor_node_gid); 
-           filterOperatorT->replaceGlobalValues(home_node_gid,1,&weight,&neighbor_node_gid); 
+           indicesT.push_back(set_it->gid);
+           weightsT.push_back(filterRadius - distance);
         }
       } else {
          // if the list of connected nodes is empty, still add a one on the diagonal.
-         weight = 1.0;
-         filterOperatorT->insertGlobalValues(home_node_gid,1,&zero,&home_node_gid); 
-         filterOperatorT->replaceGlobalValues(home_node_gid,1,&weight,&home_node_gid); 
+         indicesT.push_back(home_node_gid);
+         weightsT.push_back(1.0);
       }
+      filterOperatorT->insertGlobalValues(home_node_gid,indicesT(),weightsT());
     }
   
     filterOperatorT->fillComplete();
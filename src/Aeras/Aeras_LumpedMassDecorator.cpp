@@ -0,0 +1,145 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include "Aeras_LumpedMassDecorator.hpp"
+#include "Albany_ThyraUtils.hpp"
+#include "Teuchos_TestForException.hpp"
+#include "Thyra_VectorStdOps.hpp"
+
+Aeras::LumpedMassDecorator::LumpedMassDecorator(
+    const Teuchos::RCP<Thyra::ModelEvaluator<ST>>& model)
+    : Thyra::ModelEvaluatorDelegatorBase<ST>(model)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(!model->createInArgs().supports(MEB::IN_ARG_x_dot), std::logic_error,
+      "Error! The lumped mass decorator requires a model with a time derivative.\n");
+
+  // M_L = M*1 = f(x,1,t) - f(x,0,t)
+  MEB::InArgs<ST> inArgs = model->createInArgs();
+  inArgs.setArgs(model->getNominalValues());
+
+  x_dot_zero_ = Thyra::createMember(model->get_x_space());
+  x_dot_zero_->assign(0.0);
+  const Teuchos::RCP<Thyra_Vector> x_dot_one = Thyra::createMember(model->get_x_space());
+  x_dot_one->assign(1.0);
+
+  const Teuchos::RCP<Thyra_Vector> f_zero = Thyra::createMember(model->get_f_space());
+  neg_inv_mass_diag_ = Thyra::createMember(model->get_f_space());
+
+  MEB::OutArgs<ST> outArgs = model->createOutArgs();
+  inArgs.set_x_dot(x_dot_zero_);
+  outArgs.set_f(f_zero);
+  model->evalModel(inArgs,outArgs);
+
+  inArgs.set_x_dot(x_dot_one);
+  outArgs.set_f(neg_inv_mass_diag_);
+  model->evalModel(inArgs,outArgs);
+
+  neg_inv_mass_diag_->update(-1.0,*f_zero);
+
+  // Rows without a time derivative get a zero rate
+  Teuchos::ArrayRCP<ST> mass = Albany::getNonconstLocalData(neg_inv_mass_diag_);
+  for (int i=0; i<mass.size(); ++i) {
+    mass[i] = (mass[i]!=0.0 ? -1.0/mass[i] : 0.0);
+  }
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+Aeras::LumpedMassDecorator::createInArgs() const
+{
+  const MEB::InArgs<ST> modelInArgs = getUnderlyingModel()->createInArgs();
+
+  MEB::InArgsSetup<ST> inArgs;
+  inArgs.setModelEvalDescription(this->description());
+  inArgs.setSupports(modelInArgs);
+  inArgs.setUnsupportsAndRelated(MEB::IN_ARG_x_dot);
+  inArgs.setUnsupportsAndRelated(MEB::IN_ARG_x_dot_dot);
+  return inArgs;
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+Aeras::LumpedMassDecorator::getNominalValues() const
+{
+  return restrictInArgs(getUnderlyingModel()->getNominalValues());
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+Aeras::LumpedMassDecorator::getLowerBounds() const
+{
+  return restrictInArgs(getUnderlyingModel()->getLowerBounds());
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+Aeras::LumpedMassDecorator::getUpperBounds() const
+{
+  return restrictInArgs(getUnderlyingModel()->getUpperBounds());
+}
+
+Teuchos::RCP<Thyra::LinearOpBase<ST>>
+Aeras::LumpedMassDecorator::create_W_op() const
+{
+  return Teuchos::null;
+}
+
+Teuchos::RCP<Thyra::PreconditionerBase<ST>>
+Aeras::LumpedMassDecorator::create_W_prec() const
+{
+  return Teuchos::null;
+}
+
+Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>>
+Aeras::LumpedMassDecorator::get_W_factory() const
+{
+  return Teuchos::null;
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+Aeras::LumpedMassDecorator::restrictInArgs(const MEB::InArgs<ST>& modelInArgs) const
+{
+  MEB::InArgs<ST> inArgs = createInArgs();
+  inArgs.setArgs(modelInArgs,true);
+  return inArgs;
+}
+
+Thyra::ModelEvaluatorBase::OutArgs<ST>
+Aeras::LumpedMassDecorator::createOutArgsImpl() const
+{
+  const MEB::OutArgs<ST> modelOutArgs = getUnderlyingModel()->createOutArgs();
+
+  // Only the residual and the responses: the derivatives of the underlying
+  // model do not account for the mass scaling.
+  MEB::OutArgsSetup<ST> outArgs;
+  outArgs.setModelEvalDescription(this->description());
+  outArgs.set_Np_Ng(modelOutArgs.Np(),modelOutArgs.Ng());
+  outArgs.setSupports(MEB::OUT_ARG_f,true);
+  return outArgs;
+}
+
+void
+Aeras::LumpedMassDecorator::evalModelImpl(
+    const Thyra::ModelEvaluatorBase::InArgs<ST>& inArgs,
+    const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const
+{
+  const Teuchos::RCP<const Thyra::ModelEvaluator<ST>> model = getUnderlyingModel();
+
+  MEB::InArgs<ST> modelInArgs = model->createInArgs();
+  modelInArgs.setArgs(inArgs,true);
+  modelInArgs.set_x_dot(x_dot_zero_);
+  if (modelInArgs.supports(MEB::IN_ARG_alpha)) modelInArgs.set_alpha(0.0);
+  if (modelInArgs.supports(MEB::IN_ARG_beta)) modelInArgs.set_beta(1.0);
+
+  MEB::OutArgs<ST> modelOutArgs = model->createOutArgs();
+  const Teuchos::RCP<Thyra_Vector> f = outArgs.get_f();
+  modelOutArgs.set_f(f);
+  for (int j=0; j<outArgs.Ng(); ++j) {
+    modelOutArgs.set_g(j,outArgs.get_g(j));
+  }
+
+  model->evalModel(modelInArgs,modelOutArgs);
+
+  // x_dot = -inv(M_L) f(x,0,t)
+  if (Teuchos::nonnull(f)) {
+    Thyra::ele_wise_scale(*neg_inv_mass_diag_,f.ptr());
+  }
+}
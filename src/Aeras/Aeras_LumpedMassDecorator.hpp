@@ -0,0 +1,69 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#if !defined(Aeras_LumpedMassDecorator_hpp)
+#define Aeras_LumpedMassDecorator_hpp
+
+#include "Albany_DataTypes.hpp"
+#include "Albany_ThyraTypes.hpp"
+
+#include "Thyra_ModelEvaluatorDelegatorBase.hpp"
+
+namespace Aeras {
+
+///
+/// \brief Presents an Aeras model in explicit form, x_dot = -inv(M_L) f(x,0,t)
+///
+/// With GLL quadrature on spectral elements the mass matrix is diagonal, so
+/// there is no need to assemble it and solve with it at every stage of an
+/// explicit integrator. The lumped mass M_L = M*1 is computed once, from two
+/// residual evaluations, as f(x,1,t) - f(x,0,t) (the residual is linear in
+/// x_dot), and applied as a vector scaling afterwards.
+///
+/// The decorated model supports neither x_dot nor W, so an explicit Rythmos
+/// or Tempus stepper only evaluates residuals, and no Jacobian operator is
+/// ever created for it.
+///
+class LumpedMassDecorator : public Thyra::ModelEvaluatorDelegatorBase<ST> {
+
+public:
+
+  /// Constructor
+  LumpedMassDecorator(const Teuchos::RCP<Thyra::ModelEvaluator<ST>>& model);
+
+  Thyra::ModelEvaluatorBase::InArgs<ST> createInArgs() const;
+  Thyra::ModelEvaluatorBase::InArgs<ST> getNominalValues() const;
+  Thyra::ModelEvaluatorBase::InArgs<ST> getLowerBounds() const;
+  Thyra::ModelEvaluatorBase::InArgs<ST> getUpperBounds() const;
+
+  //! There is no W: these do not forward to the underlying model
+  Teuchos::RCP<Thyra::LinearOpBase<ST>> create_W_op() const;
+  Teuchos::RCP<Thyra::PreconditionerBase<ST>> create_W_prec() const;
+  Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>> get_W_factory() const;
+
+private:
+
+  typedef Thyra::ModelEvaluatorBase MEB;
+
+  Thyra::ModelEvaluatorBase::OutArgs<ST> createOutArgsImpl() const;
+
+  //! Evaluate model on InArgs
+  void evalModelImpl(
+      const Thyra::ModelEvaluatorBase::InArgs<ST>& inArgs,
+      const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const;
+
+  //! Copy the arguments of the underlying model that this model supports
+  Thyra::ModelEvaluatorBase::InArgs<ST>
+  restrictInArgs(const Thyra::ModelEvaluatorBase::InArgs<ST>& modelInArgs) const;
+
+  // -inv(M_L), zero on rows without a time derivative
+  Teuchos::RCP<Thyra_Vector> neg_inv_mass_diag_;
+  Teuchos::RCP<Thyra_Vector> x_dot_zero_;
+};
+
+}
+
+#endif // Aeras_LumpedMassDecorator_hpp
@@ -142,7 +142,20 @@ postRegistrationSetup(typename Traits::SetupData d,
 #endif
 
   d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields());
-  if (d.memoizer_active()) memoizer.enable_memoizer();
+  if (d.memoizer_active()) {
+    memoizer.enable_memoizer();
+    memoizer.memoize_field(weighted_measure);
+    memoizer.memoize_field(sphere_coord);
+    memoizer.memoize_field(lambda_nodal);
+    memoizer.memoize_field(theta_nodal);
+    memoizer.memoize_field(jacobian_det);
+    memoizer.memoize_field(jacobian_inv);
+    memoizer.memoize_field(jacobian);
+    memoizer.memoize_field(BF);
+    memoizer.memoize_field(wBF);
+    memoizer.memoize_field(GradBF);
+    memoizer.memoize_field(wGradBF);
+  }
 }
 
 //**********************************************************************
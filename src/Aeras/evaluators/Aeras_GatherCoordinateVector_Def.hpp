@@ -38,7 +38,10 @@ void GatherCoordinateVector<EvalT, Traits>::postRegistrationSetup(typename Trait
   numCoords = dims[2];
 
   d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields());
-  if (d.memoizer_active()) memoizer.enable_memoizer();
+  if (d.memoizer_active()) {
+    memoizer.enable_memoizer();
+    memoizer.memoize_field(coordVec);
+  }
 }
 
 // **********************************************************************
@@ -70,7 +70,10 @@ postRegistrationSetup(typename Traits::SetupData d,
     this->utils.setFieldData(sphere_coord,fm); 
 
   d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields());
-  if (d.memoizer_active()) memoizer.enable_memoizer();
+  if (d.memoizer_active()) {
+    memoizer.enable_memoizer();
+    memoizer.memoize_field(hs);
+  }
 }
 
 //**********************************************************************
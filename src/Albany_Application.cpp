@@ -24,7 +24,14 @@
 #endif
 
 #include "Albany_DataTypes.hpp"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 
 #include "Albany_DummyParameterAccessor.hpp"
 
@@ -58,6 +65,11 @@
 #endif // ALBANY_LCM
 
 #include "Albany_ThyraUtils.hpp"
+
+#if defined(ALBANY_STK)
+#include "Albany_STKDiscretization.hpp"
+#endif
+
 // TODO: remove this if/when the thyra refactor is 100% complete,
 //       and there is no more any Tpetra stuff in this class
 #include "Albany_TpetraThyraUtils.hpp"
@@ -645,6 +657,39 @@ void Albany::Application::buildProblem() {
   }
   if (Teuchos::nonnull(rc_mgr))
     rc_mgr->endBuildingSfm();
+
+  // Build one copy of the volumetric field managers per extra fill thread.
+  // Each copy owns its own field data, so worksets can be evaluated
+  // concurrently. State registration is idempotent, so re-running
+  // buildEvaluators here is safe.
+  num_fill_threads = problemParams->get<int>("Workset Fill Threads", 1);
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      num_fill_threads < 1, std::logic_error,
+      "Error in Albany::Application: 'Workset Fill Threads' must be >= 1.\n");
+#if !defined(ALBANY_THREADED_FILL)
+  // The evaluators would launch Kokkos kernels and start Teuchos timers from
+  // several host threads, which the other configurations do not support
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      num_fill_threads > 1, std::logic_error,
+      "Error in Albany::Application: 'Workset Fill Threads' > 1 requires a "
+      "thread-safe Teuchos, a host-serial Kokkos, no Phalanx evaluator "
+      "timers and ENABLE_KOKKOS_UNDER_DEVELOPMENT=OFF.\n");
+#endif
+  evaluator_profile_file =
+      problemParams->get<std::string>("Evaluator Profile File", "");
+
+  stateMgr.setSwapOldStates(problemParams->get<bool>("Swap Old States", false));
+
+  thread_fm.resize(num_fill_threads - 1);
+  for (int t = 0; t < thread_fm.size(); ++t) {
+    thread_fm[t].resize(meshSpecs.size());
+    for (int ps = 0; ps < meshSpecs.size(); ps++) {
+      thread_fm[t][ps] =
+          Teuchos::rcp(new PHX::FieldManager<PHAL::AlbanyTraits>);
+      problem->buildEvaluators(*thread_fm[t][ps], *meshSpecs[ps], stateMgr,
+                               BUILD_RESID_FM, Teuchos::null);
+    }
+  }
 }
 
 void Albany::Application::createDiscretization() {
@@ -655,6 +700,20 @@ void Albany::Application::createDiscretization() {
       problem->getSideSetFieldRequirements(), problem->getNullSpace());
   // The following is for Aeras problems.
   explicit_scheme = disc->isExplicitScheme();
+
+  // Only the STK discretization synchronizes the swapped state arrays with
+  // its mesh fields before writing or remapping them
+#if defined(ALBANY_STK)
+  const bool stk_disc =
+      Teuchos::nonnull(Teuchos::rcp_dynamic_cast<STKDiscretization>(disc));
+#else
+  const bool stk_disc = false;
+#endif
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      problemParams->get<bool>("Swap Old States", false) && !stk_disc,
+      std::logic_error,
+      "Error in Albany::Application: 'Swap Old States' requires an STK "
+      "discretization.\n");
 }
 
 void Albany::Application::setScaling(
@@ -877,6 +936,15 @@ void Albany::Application::finalSetUp(
 
   perturbBetaForDirichlets = problemParams->get("Perturb Dirichlet", 0.0);
 
+  constant_jacobian = problemParams->get("Constant Jacobian", false);
+  // The cached parts are recombined with linearCombination, which only
+  // supports Tpetra matrices
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      constant_jacobian && Albany::build_type() == Albany::BuildType::Epetra,
+      std::logic_error,
+      "Error in Albany::Application: 'Constant Jacobian' requires a Tpetra "
+      "build (AlbanyT).\n");
+
   is_adjoint = problemParams->get("Solve Adjoint", false);
 
   // For backward compatibility, use any value at the old location of the
@@ -968,6 +1036,68 @@ RCP<const Tpetra_CrsGraph> Albany::Application::getJacobianGraphT() const {
   return disc->getJacobianGraphT();
 }
 
+Teuchos::RCP<Thyra_LinearOp>
+Albany::Application::createBlockDiagonalJacobianOp() {
+  buildBlockDiagonalGraphs();
+  return createThyraLinearOp(Teuchos::rcp(new Tpetra_CrsMatrix(block_diag_graphT)));
+}
+
+void Albany::Application::buildBlockDiagonalGraphs() {
+  const Teuchos::RCP<const Tpetra_Map> overlap_mapT = disc->getOverlapMapT();
+  if (Teuchos::nonnull(block_diag_overlap_graphT) &&
+      block_diag_overlap_graphT->getRowMap() == overlap_mapT) {
+    return;
+  }
+
+  // Couple all the equations at each node of each element. Every row gets
+  // its diagonal, so that dofs that are not in any element are covered too.
+  const auto& wsElNodeEqID = disc->getWsElNodeEqID();
+  Teuchos::RCP<Tpetra_CrsGraph> overlap_graphT =
+      Teuchos::rcp(new Tpetra_CrsGraph(overlap_mapT, neq));
+  Teuchos::Array<Tpetra_GO> cols(neq);
+  for (int ws = 0; ws < wsElNodeEqID.size(); ++ws) {
+    const auto& elNodeEqID = wsElNodeEqID[ws];
+    for (size_t cell = 0; cell < elNodeEqID.extent(0); ++cell) {
+      for (size_t node = 0; node < elNodeEqID.extent(1); ++node) {
+        for (unsigned int eq = 0; eq < neq; ++eq) {
+          cols[eq] = overlap_mapT->getGlobalElement(elNodeEqID(cell, node, eq));
+        }
+        for (unsigned int eq = 0; eq < neq; ++eq) {
+          overlap_graphT->insertGlobalIndices(cols[eq], cols());
+        }
+      }
+    }
+  }
+  const LO num_overlap_rows = overlap_mapT->getNodeNumElements();
+  for (LO row = 0; row < num_overlap_rows; ++row) {
+    const Tpetra_GO gid = overlap_mapT->getGlobalElement(row);
+    overlap_graphT->insertGlobalIndices(gid, Teuchos::arrayView(&gid, 1));
+  }
+  overlap_graphT->fillComplete();
+
+  // Owned graph, exported from the overlapped one as the discretization does
+  const Teuchos::RCP<const Tpetra_Map> mapT = disc->getMapT();
+  Teuchos::RCP<Tpetra_CrsGraph> graphT =
+      Teuchos::rcp(new Tpetra_CrsGraph(mapT, neq));
+  Tpetra_Export exporterT(overlap_mapT, mapT);
+  graphT->doExport(*overlap_graphT, exporterT, Tpetra::INSERT);
+  graphT->fillComplete();
+
+  block_diag_overlap_graphT = overlap_graphT;
+  block_diag_graphT = graphT;
+  block_diag_overlapped_jac =
+      createThyraLinearOp(Teuchos::rcp(new Tpetra_CrsMatrix(overlap_graphT)));
+}
+
+bool Albany::Application::isBlockDiagonalJacobian(
+    const Teuchos::RCP<const Thyra_LinearOp>& jac) const {
+  if (block_diag_graphT.is_null()) {
+    return false;
+  }
+  const auto jacT = getConstTpetraMatrix(jac, false);
+  return Teuchos::nonnull(jacT) && jacT->getCrsGraph() == block_diag_graphT;
+}
+
 RCP<Tpetra_Operator> Albany::Application::getPreconditionerT() {
 //#if defined(ATO_USES_COGENT)
 #ifdef ALBANY_ATO
@@ -1321,6 +1451,250 @@ PHAL::Workset Albany::Application::set_dfm_workset(double const current_time,
   return workset; 
 }
 
+void Albany::Application::computeWorksetColors()
+{
+  const auto &wsElNodeEqID = disc->getWsElNodeEqID();
+  int const numWorksets = wsElNodeEqID.size();
+
+  // The connectivity is rebuilt whenever the mesh changes, so it doubles as
+  // the key of the cached coloring.
+  if (ws_colors_conn.getRawPtr() == wsElNodeEqID.getRawPtr() &&
+      ws_colors_conn.size() == numWorksets) return;
+
+  TEUCHOS_FUNC_TIME_MONITOR("> Albany Fill: Workset Coloring");
+
+  // Worksets touching each overlapped dof
+  LO num_dofs = 0;
+  for (int ws = 0; ws < numWorksets; ws++) {
+    const auto &conn = wsElNodeEqID[ws];
+    for (size_t i = 0; i < conn.size(); ++i) {
+      num_dofs = std::max(num_dofs, conn.data()[i] + 1);
+    }
+  }
+  std::vector<std::vector<int>> dof_worksets(num_dofs);
+  for (int ws = 0; ws < numWorksets; ws++) {
+    const auto &conn = wsElNodeEqID[ws];
+    for (size_t i = 0; i < conn.size(); ++i) {
+      auto &wss = dof_worksets[conn.data()[i]];
+      if (wss.empty() || wss.back() != ws) wss.push_back(ws);
+    }
+  }
+
+  // Greedy coloring of the workset adjacency graph
+  std::vector<int> color(numWorksets, -1);
+  int num_colors = 0;
+  for (int ws = 0; ws < numWorksets; ws++) {
+    std::set<int> taken;
+    const auto &conn = wsElNodeEqID[ws];
+    for (size_t i = 0; i < conn.size(); ++i) {
+      for (int nbr : dof_worksets[conn.data()[i]]) {
+        if (color[nbr] >= 0) taken.insert(color[nbr]);
+      }
+    }
+    int c = 0;
+    while (taken.count(c) > 0) ++c;
+    color[ws] = c;
+    num_colors = std::max(num_colors, c + 1);
+  }
+
+  ws_colors.assign(num_colors, std::vector<int>());
+  for (int ws = 0; ws < numWorksets; ws++) {
+    ws_colors[color[ws]].push_back(ws);
+  }
+  ws_colors_conn = wsElNodeEqID;
+
+  // A color never runs on more threads than it has worksets
+  std::size_t max_color_size = 0;
+  for (const auto &ws_list : ws_colors) {
+    max_color_size = std::max(max_color_size, ws_list.size());
+  }
+  int const max_threads =
+      std::min(num_fill_threads, static_cast<int>(max_color_size));
+
+  *out << "Threaded workset fill: " << numWorksets << " worksets in "
+       << num_colors << " colors, " << max_threads << " threads\n";
+}
+
+namespace {
+
+// Number of values (value and derivatives) carried by a ScalarT, used to
+// estimate the bytes moved by an evaluation
+template <typename EvalT>
+int profileScalarSize(Albany::Application const *app, int const ps)
+{
+  return 1 + PHAL::getDerivativeDimensions<EvalT>(app, ps);
+}
+
+template <>
+int profileScalarSize<PHAL::AlbanyTraits::Residual>(
+    Albany::Application const *app, int const ps)
+{
+  return 1;
+}
+
+std::string const field_manager_item = "(field manager)";
+
+} // namespace
+
+template <typename EvalT>
+void Albany::Application::evaluateWorkset(
+    PHX::FieldManager<PHAL::AlbanyTraits> &fm_ws, int const ps,
+    PHAL::Workset &workset)
+{
+  if (evaluator_profile_file.empty()) {
+    fm_ws.template evaluateFields<EvalT>(workset);
+    return;
+  }
+
+  auto const start = std::chrono::steady_clock::now();
+  fm_ws.template evaluateFields<EvalT>(workset);
+  std::chrono::duration<double> const elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  // Gather of the solution and scatter of the residual/Jacobian entries
+  double const bytes = 2.0 * workset.wsElNodeEqID.size() *
+                       profileScalarSize<EvalT>(this, ps) * sizeof(RealType);
+
+  std::lock_guard<std::mutex> lock(evaluator_monitor_mutex);
+  evaluator_monitor.add(PHX::typeAsString<EvalT>(), meshSpecs[ps]->ebName,
+                        field_manager_item, 1, workset.numCells, bytes,
+                        elapsed.count());
+}
+
+template <typename EvalT>
+void Albany::Application::addEvaluatorTimes()
+{
+  std::string const eval_type = PHX::typeAsString<EvalT>();
+
+  for (int ps = 0; ps < fm.size(); ++ps) {
+    std::string const &block = meshSpecs[ps]->ebName;
+    auto const fm_entry = evaluator_monitor.entries().find(
+        std::make_tuple(eval_type, block, field_manager_item));
+    if (fm_entry == evaluator_monitor.entries().end()) continue;
+    long long const calls = fm_entry->second.calls;
+    long long const cells = fm_entry->second.cells;
+
+    // The copies of the field manager used by the fill threads have the
+    // same evaluators, in the same order
+    std::vector<Teuchos::RCP<PHX::FieldManager<PHAL::AlbanyTraits>>> fms(
+        1, fm[ps]);
+    for (int t = 0; t < thread_fm.size(); ++t) fms.push_back(thread_fm[t][ps]);
+
+    auto const &nodes = fm[ps]->getDagManager<EvalT>().getDagNodes();
+    double const scalar_bytes =
+        profileScalarSize<EvalT>(this, ps) * sizeof(RealType);
+
+    for (std::size_t n = 0; n < nodes.size(); ++n) {
+      double time = 0.0;
+      for (auto const &fm_t : fms) {
+        time += fm_t->getDagManager<EvalT>()
+                    .getDagNodes()[n]
+                    .executionTime()
+                    .count();
+      }
+
+      // Every evaluated and dependent field is read or written once per call
+      auto const evaluator = nodes[n].get();
+      double field_entries = 0.0;
+      for (auto const &tag : evaluator->evaluatedFields()) {
+        field_entries += tag->dataLayout().size();
+      }
+      for (auto const &tag : evaluator->dependentFields()) {
+        field_entries += tag->dataLayout().size();
+      }
+
+      evaluator_monitor.add(eval_type, block, evaluator->getName(), calls,
+                            cells, calls * field_entries * scalar_bytes, time);
+    }
+  }
+}
+
+void Albany::Application::writeEvaluatorProfile()
+{
+  if (evaluator_profile_file.empty()) return;
+
+  addEvaluatorTimes<PHAL::AlbanyTraits::Residual>();
+  addEvaluatorTimes<PHAL::AlbanyTraits::Jacobian>();
+  addEvaluatorTimes<PHAL::AlbanyTraits::Tangent>();
+  addEvaluatorTimes<PHAL::AlbanyTraits::DistParamDeriv>();
+
+  std::string const &name = evaluator_profile_file;
+  bool const json =
+      name.size() >= 5 && name.compare(name.size() - 5, 5, ".json") == 0;
+
+  if (commT->getRank() == 0) {
+    std::ofstream file(name.c_str());
+    evaluator_monitor.summarize(commT.ptr(), file, json);
+    *out << "Evaluator profile written to " << name << std::endl;
+  } else {
+    std::ostringstream unused;
+    evaluator_monitor.summarize(commT.ptr(), unused, json);
+  }
+  evaluator_monitor.clear();
+}
+
+template <typename EvalT>
+void Albany::Application::evaluateFieldsThreaded(PHAL::Workset &workset)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("> Albany Fill: Threaded Workset Loop");
+
+  computeWorksetColors();
+
+  const auto &wsPhysIndex = disc->getWsPhysIndex();
+
+  // Each thread works on its own copy of the workset. The copies share the
+  // overlapped residual and Jacobian: this is safe because worksets of the
+  // same color do not touch any common overlapped row.
+  std::vector<PHAL::Workset> thread_worksets(num_fill_threads, workset);
+
+  for (const auto &ws_list : ws_colors) {
+    int const num_ws = ws_list.size();
+    std::atomic<int> next_ws(0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto fill = [&](int const t) {
+      auto &fm_t = (t == 0) ? fm : thread_fm[t - 1];
+      PHAL::Workset &ws_t = thread_worksets[t];
+      try {
+        for (int i = next_ws++; i < num_ws; i = next_ws++) {
+          int const ws = ws_list[i];
+          loadWorksetBucketInfo<EvalT>(ws_t, ws);
+          evaluateWorkset<EvalT>(*fm_t[wsPhysIndex[ws]], wsPhysIndex[ws], ws_t);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    int const num_threads = std::min(num_fill_threads, num_ws);
+    for (int t = 1; t < num_threads; ++t) {
+      threads.emplace_back(fill, t);
+    }
+    fill(0);
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+  // The Neumann field managers are not copied per thread
+  if (nfm == Teuchos::null) return;
+
+  int const numWorksets = wsPhysIndex.size();
+  for (int ws = 0; ws < numWorksets; ws++) {
+    loadWorksetBucketInfo<EvalT>(workset, ws);
+#ifdef ALBANY_PERIDIGM
+    // DJL avoid passing a sphere mesh through a nfm that was
+    // created for non-sphere topology.
+    if (workset.sideSets->size() == 0) continue;
+#endif
+    deref_nfm(nfm, wsPhysIndex, ws)->template evaluateFields<EvalT>(workset);
+  }
+}
+
 void Albany::Application::computeGlobalResidualImpl(
     double const current_time,
     const Teuchos::RCP<const Thyra_Vector> x,
@@ -1360,20 +1734,13 @@ void Albany::Application::computeGlobalResidualImpl(
   }
 
 #if defined(ALBANY_LCM)
-  // Store pointers to solution and time derivatives.
-  // Needed for Schwarz coupling.
-  if (x != Teuchos::null)
-    x_ = Teuchos::rcp(new Tpetra_Vector(*Albany::getConstTpetraVector(x)));
-  else
-    x_ = Teuchos::null;
-  if (x_dot != Teuchos::null)
-    xdot_ = Teuchos::rcp(new Tpetra_Vector(*Albany::getConstTpetraVector(x_dot)));
-  else
-    xdot_ = Teuchos::null;
-  if (x_dotdot != Teuchos::null)
-    xdotdot_ = Teuchos::rcp(new Tpetra_Vector(*Albany::getConstTpetraVector(x_dotdot)));
-  else
-    xdotdot_ = Teuchos::null;
+  // Store the solution and time derivatives for Schwarz coupling. Only
+  // needed if another application reads them.
+  if (isCoupledToOtherApps() == true) {
+    x_.copy(x);
+    xdot_.copy(x_dot);
+    xdotdot_.copy(x_dotdot);
+  }
 #endif // ALBANY_LCM
 
   // Zero out overlapped residual - Tpetra
@@ -1429,37 +1796,41 @@ void Albany::Application::computeGlobalResidualImpl(
 
     workset.f = overlapped_f;
 
-    for (int ws = 0; ws < numWorksets; ws++) {
-      loadWorksetBucketInfo<PHAL::AlbanyTraits::Residual>(workset, ws);
-      // FillType template argument used to specialize Sacado
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(
-          workset);
+    if (num_fill_threads > 1) {
+      evaluateFieldsThreaded<PHAL::AlbanyTraits::Residual>(workset);
+    } else {
+      for (int ws = 0; ws < numWorksets; ws++) {
+        loadWorksetBucketInfo<PHAL::AlbanyTraits::Residual>(workset, ws);
+        // FillType template argument used to specialize Sacado
+        evaluateWorkset<PHAL::AlbanyTraits::Residual>(
+            *fm[wsPhysIndex[ws]], wsPhysIndex[ws], workset);
 #ifdef DEBUG_OUTPUT
-      *out << "IKT after fm evaluateFields countRes = " << countRes
-           << ", computeGlobalResid workset.x = \n ";
-      describe(workset.x.getConst(),*out, Teuchos::VERB_EXTREME);
+        *out << "IKT after fm evaluateFields countRes = " << countRes
+             << ", computeGlobalResid workset.x = \n ";
+        describe(workset.x.getConst(),*out, Teuchos::VERB_EXTREME);
 #endif
 
-      if (nfm != Teuchos::null) {
+        if (nfm != Teuchos::null) {
 #ifdef ALBANY_PERIDIGM
-        // DJL this is a hack to avoid running a block with sphere elements
-        // through a Neumann field manager that was constructed for a non-sphere
-        // element topology.  The root cause is that Albany currently supports
-        // only a single Neumann field manager.  The history on that is murky.
-        // The single field manager is created for a specific element topology,
-        // and it fails if applied to worksets with a different element
-        // topology. The Peridigm use case is a discretization that contains
-        // blocks with sphere elements and blocks with standard FEM solid
-        // elements, and we want to apply Neumann BC to the standard solid
-        // elements.
-        if (workset.sideSets->size() != 0) {
+          // DJL this is a hack to avoid running a block with sphere elements
+          // through a Neumann field manager that was constructed for a non-sphere
+          // element topology.  The root cause is that Albany currently supports
+          // only a single Neumann field manager.  The history on that is murky.
+          // The single field manager is created for a specific element topology,
+          // and it fails if applied to worksets with a different element
+          // topology. The Peridigm use case is a discretization that contains
+          // blocks with sphere elements and blocks with standard FEM solid
+          // elements, and we want to apply Neumann BC to the standard solid
+          // elements.
+          if (workset.sideSets->size() != 0) {
+            deref_nfm(nfm, wsPhysIndex, ws)
+                ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+          }
+#else
           deref_nfm(nfm, wsPhysIndex, ws)
               ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
-        }
-#else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
 #endif
+        }
       }
     }
   }
@@ -1587,6 +1958,12 @@ void Albany::Application::computeGlobalJacobianImpl(
 
   postRegSetup("Jacobian");
 
+  const bool block_diagonal = isBlockDiagonalJacobian(jac);
+  if (constant_jacobian && !block_diagonal) {
+    computeConstantJacobian(alpha, beta, omega, current_time, x, xdot, xdotdot, p, f, jac, dt);
+    return;
+  }
+
   // Load connectivity map and coordinates
   const auto &wsElNodeEqID = disc->getWsElNodeEqID();
   const auto &wsPhysIndex = disc->getWsPhysIndex();
@@ -1598,7 +1975,10 @@ void Albany::Application::computeGlobalJacobianImpl(
     overlapped_f = solMgrT->get_overlapped_f();
   }
 
-  Teuchos::RCP<Thyra_LinearOp> overlapped_jac =solMgrT->get_overlapped_jac();
+  // The block diagonal Jacobian is assembled into its own overlapped matrix.
+  // The scatter drops the entries outside of the node blocks.
+  Teuchos::RCP<Thyra_LinearOp> overlapped_jac =
+      block_diagonal ? block_diag_overlapped_jac : solMgrT->get_overlapped_jac();
   auto cas_manager = solMgrT->get_cas_manager();
 
   // Scatter x and xdot to the overlapped distribution
@@ -1666,23 +2046,27 @@ void Albany::Application::computeGlobalJacobianImpl(
                   this, ps, explicit_scheme));
     }
 
-    for (int ws = 0; ws < numWorksets; ws++) {
-      loadWorksetBucketInfo<PHAL::AlbanyTraits::Jacobian>(workset, ws);
-      // FillType template argument used to specialize Sacado
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Jacobian>(
-          workset);
-      if (Teuchos::nonnull(nfm))
+    if (num_fill_threads > 1) {
+      evaluateFieldsThreaded<PHAL::AlbanyTraits::Jacobian>(workset);
+    } else {
+      for (int ws = 0; ws < numWorksets; ws++) {
+        loadWorksetBucketInfo<PHAL::AlbanyTraits::Jacobian>(workset, ws);
+        // FillType template argument used to specialize Sacado
+        evaluateWorkset<PHAL::AlbanyTraits::Jacobian>(
+            *fm[wsPhysIndex[ws]], wsPhysIndex[ws], workset);
+        if (Teuchos::nonnull(nfm))
 #ifdef ALBANY_PERIDIGM
-        // DJL avoid passing a sphere mesh through a nfm that was
-        // created for non-sphere topology.
-        if (workset.sideSets->size() != 0) {
+          // DJL avoid passing a sphere mesh through a nfm that was
+          // created for non-sphere topology.
+          if (workset.sideSets->size() != 0) {
+            deref_nfm(nfm, wsPhysIndex, ws)
+                ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+          }
+#else
           deref_nfm(nfm, wsPhysIndex, ws)
               ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
-        }
-#else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
 #endif
+      }
     }
   }
 
@@ -1849,6 +2233,77 @@ void Albany::Application::computeGlobalJacobianImpl(
   }
 }
 
+void Albany::Application::computeConstantJacobian(
+    const double alpha, const double beta, const double omega,
+    const double current_time,
+    const Teuchos::RCP<const Thyra_Vector>& x,
+    const Teuchos::RCP<const Thyra_Vector>& xdot,
+    const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+    const Teuchos::Array<ParamVec> &p,
+    const Teuchos::RCP<Thyra_Vector>& f,
+    const Teuchos::RCP<Thyra_LinearOp>& jac,
+    const double dt)
+{
+  // Scalings are computed from the assembled Jacobian, the Dirichlet
+  // perturbation only applies when beta is zero, and distributed parameters
+  // can change without notice: none of these is a linear combination of
+  // cached parts.
+  if (scale != 1.0 || perturbBetaForDirichlets != 0.0 || distParamLib->size() > 0) {
+    *out << "Warning: 'Constant Jacobian' cannot be used with Jacobian scaling, "
+            "'Perturb Dirichlet' or distributed parameters. The Jacobian will "
+            "be assembled at every fill.\n";
+    constant_jacobian = false;
+    computeGlobalJacobianImpl(alpha, beta, omega, current_time, x, xdot, xdotdot, p, f, jac, dt);
+    return;
+  }
+
+  Teuchos::Array<RealType> params;
+  for (int i = 0; i < p.size(); i++)
+    for (unsigned int j = 0; j < p[i].size(); j++)
+      params.push_back(p[i][j].baseValue);
+
+  // J = beta*dF/dx + alpha*dF/dxdot + omega*dF/dxdotdot
+  const int num_parts = std::min(num_time_deriv, 2) + 1;
+  const double part_coeffs[3][3] = {{0.0, 1.0, 0.0},
+                                    {1.0, 0.0, 0.0},
+                                    {0.0, 0.0, 1.0}};
+
+  bool rebuild = jac_parts.size() != num_parts || params != jac_parts_params || dt != jac_parts_dt;
+  if (!rebuild) {
+    rebuild = getConstTpetraMatrix(jac_parts[0].getConst())->getCrsGraph() != disc->getJacobianGraphT();
+  }
+
+  if (rebuild) {
+    TEUCHOS_FUNC_TIME_MONITOR("> Albany Fill: Constant Jacobian Parts");
+    jac_parts.resize(num_parts);
+    constant_jacobian = false;
+    for (int k = 0; k < num_parts; ++k) {
+      jac_parts[k] = createThyraLinearOp(
+          Teuchos::rcp(new Tpetra_CrsMatrix(disc->getJacobianGraphT())));
+      computeGlobalJacobianImpl(part_coeffs[k][0], part_coeffs[k][1], part_coeffs[k][2],
+                                current_time, x, xdot, xdotdot, p, Teuchos::null,
+                                jac_parts[k], dt);
+    }
+    constant_jacobian = true;
+    jac_parts_params = params;
+    jac_parts_dt = dt;
+  }
+
+  // The residual still depends on the solution
+  if (Teuchos::nonnull(f)) {
+    computeGlobalResidualImpl(current_time, x, xdot, xdotdot, p, f, dt);
+  }
+
+  const ST coeffs[3] = {beta, alpha, omega};
+  Teuchos::Array<Teuchos::RCP<const Thyra_LinearOp>> parts(num_parts);
+  for (int k = 0; k < num_parts; ++k) {
+    parts[k] = jac_parts[k];
+  }
+  resumeFill(jac);
+  linearCombination(jac, Teuchos::arrayView(coeffs, num_parts), parts());
+  fillComplete(jac);
+}
+
 void Albany::Application::computeGlobalJacobian(
     const double alpha, const double beta, const double omega,
     const double current_time,
@@ -2135,7 +2590,8 @@ void Albany::Application::computeGlobalTangent(
       loadWorksetBucketInfo<PHAL::AlbanyTraits::Tangent>(workset, ws);
 
       // FillType template argument used to specialize Sacado
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Tangent>(workset);
+      evaluateWorkset<PHAL::AlbanyTraits::Tangent>(
+          *fm[wsPhysIndex[ws]], wsPhysIndex[ws], workset);
       if (nfm != Teuchos::null)
         deref_nfm(nfm, wsPhysIndex, ws)
             ->evaluateFields<PHAL::AlbanyTraits::Tangent>(workset);
@@ -2306,8 +2762,8 @@ void Albany::Application::applyGlobalDistParamDerivImpl(
       loadWorksetBucketInfo<PHAL::AlbanyTraits::DistParamDeriv>(workset, ws);
 
       // FillType template argument used to specialize Sacado
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(
-          workset);
+      evaluateWorkset<PHAL::AlbanyTraits::DistParamDeriv>(
+          *fm[wsPhysIndex[ws]], wsPhysIndex[ws], workset);
       if (nfm != Teuchos::null)
 #ifdef ALBANY_PERIDIGM
         // DJL avoid passing a sphere mesh through a nfm that was
@@ -2614,6 +3070,42 @@ Albany::Application::getValue(const std::string &name) {
   return shapeParams[index];
 }
 
+namespace {
+
+// The AD types are chosen at configure time for the whole executable, and
+// every element block runs with the same size. Check that the derivative
+// array of the AD type of an evaluation can hold the derivatives of the given
+// element block.
+void checkFadCapacity(std::string const &eval, std::string const &fad_type,
+                      int const capacity, std::string const &block,
+                      int const num_derivs)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      num_derivs > capacity, std::logic_error,
+      "Error in Albany::Application: element block '"
+          << block << "' needs " << num_derivs << " " << eval
+          << " derivative components, but Albany was built with " << fad_type
+          << " of size " << capacity << ".\n"
+          << "Reconfigure with a larger size (or DFad).\n");
+}
+
+// Report, once, when a smaller static size would fit all element blocks
+void noteFadCapacity(std::string const &eval, std::string const &fad_type,
+                     int const capacity, int const max_derivs,
+                     Teuchos_Comm const &comm,
+                     Teuchos::FancyOStream &out)
+{
+  if (comm.getRank() != 0) return;
+  if (max_derivs > 0 && max_derivs < capacity) {
+    out << "Note: the element blocks use at most " << max_derivs << " of the "
+        << capacity << " " << eval << " derivative components of " << fad_type
+        << ". Configuring with size " << max_derivs
+        << " would reduce the AD storage.\n";
+  }
+}
+
+} // namespace
+
 void Albany::Application::postRegSetup(std::string eval) {
   if (phxSetup->contain_eval(eval)) return;
   phxSetup->insert_eval(eval);
@@ -2622,6 +3114,9 @@ void Albany::Application::postRegSetup(std::string eval) {
     for (int ps = 0; ps < fm.size(); ps++) {
       fm[ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Residual>(*phxSetup);
       phxSetup->check_fields(fm[ps]->getFieldTagsForSizing<PHAL::AlbanyTraits::Residual>());
+      for (int t = 0; t < thread_fm.size(); ++t) {
+        thread_fm[t][ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Residual>(*phxSetup);
+      }
     }
     if (dfm != Teuchos::null) {
       dfm->postRegistrationSetupForType<PHAL::AlbanyTraits::Residual>(*phxSetup);
@@ -2633,15 +3128,30 @@ void Albany::Application::postRegSetup(std::string eval) {
         phxSetup->check_fields(nfm[ps]->getFieldTagsForSizing<PHAL::AlbanyTraits::Residual>());
       }
   } else if (eval == "Jacobian") {
+    int max_derivs = 0;
     for (int ps = 0; ps < fm.size(); ps++) {
       std::vector<PHX::index_size_type> derivative_dimensions;
       derivative_dimensions.push_back(
           PHAL::getDerivativeDimensions<PHAL::AlbanyTraits::Jacobian>(
               this, ps, explicit_scheme));
+      max_derivs = std::max<int>(max_derivs, derivative_dimensions[0]);
+#if defined(ALBANY_FAD_TYPE_SFAD)
+      checkFadCapacity(eval, "SFad", ALBANY_SFAD_SIZE, meshSpecs[ps]->ebName,
+                       derivative_dimensions[0]);
+#elif defined(ALBANY_FAD_TYPE_SLFAD)
+      checkFadCapacity(eval, "SLFad", ALBANY_SLFAD_SIZE, meshSpecs[ps]->ebName,
+                       derivative_dimensions[0]);
+#endif
       fm[ps]->setKokkosExtendedDataTypeDimensions<PHAL::AlbanyTraits::Jacobian>(
           derivative_dimensions);
       fm[ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Jacobian>(*phxSetup);
       phxSetup->check_fields(fm[ps]->getFieldTagsForSizing<PHAL::AlbanyTraits::Jacobian>());
+      for (int t = 0; t < thread_fm.size(); ++t) {
+        thread_fm[t][ps]
+            ->setKokkosExtendedDataTypeDimensions<PHAL::AlbanyTraits::Jacobian>(
+                derivative_dimensions);
+        thread_fm[t][ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Jacobian>(*phxSetup);
+      }
       if (nfm != Teuchos::null && ps < nfm.size()) {
         nfm[ps]
             ->setKokkosExtendedDataTypeDimensions<PHAL::AlbanyTraits::Jacobian>(
@@ -2650,6 +3160,11 @@ void Albany::Application::postRegSetup(std::string eval) {
         phxSetup->check_fields(nfm[ps]->getFieldTagsForSizing<PHAL::AlbanyTraits::Jacobian>());
       }
     }
+#if defined(ALBANY_FAD_TYPE_SFAD)
+    noteFadCapacity(eval, "SFad", ALBANY_SFAD_SIZE, max_derivs, *commT, *out);
+#elif defined(ALBANY_FAD_TYPE_SLFAD)
+    noteFadCapacity(eval, "SLFad", ALBANY_SLFAD_SIZE, max_derivs, *commT, *out);
+#endif
     if (dfm != Teuchos::null) {
       // amb Need to look into this. What happens with DBCs in meshes having
       // different element types?
@@ -2663,10 +3178,19 @@ void Albany::Application::postRegSetup(std::string eval) {
       phxSetup->check_fields(dfm->getFieldTagsForSizing<PHAL::AlbanyTraits::Jacobian>());
     }
   } else if (eval == "Tangent") {
+    int max_derivs = 0;
     for (int ps = 0; ps < fm.size(); ps++) {
       std::vector<PHX::index_size_type> derivative_dimensions;
       derivative_dimensions.push_back(
           PHAL::getDerivativeDimensions<PHAL::AlbanyTraits::Tangent>(this, ps));
+      max_derivs = std::max<int>(max_derivs, derivative_dimensions[0]);
+#if defined(ALBANY_TAN_FAD_TYPE_SFAD)
+      checkFadCapacity(eval, "SFad", ALBANY_TAN_SFAD_SIZE, meshSpecs[ps]->ebName,
+                       derivative_dimensions[0]);
+#elif defined(ALBANY_TAN_FAD_TYPE_SLFAD)
+      checkFadCapacity(eval, "SLFad", ALBANY_TAN_SLFAD_SIZE, meshSpecs[ps]->ebName,
+                       derivative_dimensions[0]);
+#endif
       fm[ps]->setKokkosExtendedDataTypeDimensions<PHAL::AlbanyTraits::Tangent>(
           derivative_dimensions);
       fm[ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Tangent>(*phxSetup);
@@ -2679,6 +3203,11 @@ void Albany::Application::postRegSetup(std::string eval) {
         phxSetup->check_fields(nfm[ps]->getFieldTagsForSizing<PHAL::AlbanyTraits::Tangent>());
       }
     }
+#if defined(ALBANY_TAN_FAD_TYPE_SFAD)
+    noteFadCapacity(eval, "SFad", ALBANY_TAN_SFAD_SIZE, max_derivs, *commT, *out);
+#elif defined(ALBANY_TAN_FAD_TYPE_SLFAD)
+    noteFadCapacity(eval, "SLFad", ALBANY_TAN_SLFAD_SIZE, max_derivs, *commT, *out);
+#endif
     if (dfm != Teuchos::null) {
       // amb Need to look into this. What happens with DBCs in meshes having
       // different element types?
@@ -2855,9 +3384,32 @@ void Albany::Application::determinePiroSolver(
   }
 }
 
+void Albany::Application::updateMemoizerGeneration()
+{
+  if (!phxSetup->memoizer_active()) return;
+
+  std::vector<double> param_values;
+  for (auto it = paramLib->begin(); it != paramLib->end(); ++it) {
+    if (paramLib->isParameterForType<PHAL::AlbanyTraits::Residual>(it->first)) {
+      param_values.push_back(
+          paramLib->getRealValue<PHAL::AlbanyTraits::Residual>(it->first));
+    }
+  }
+
+  const unsigned int coords_generation = disc->getCoordinatesGeneration();
+  if (coords_generation != memoizer_coords_generation ||
+      param_values != memoizer_param_values) {
+    memoizer_coords_generation = coords_generation;
+    memoizer_param_values = param_values;
+    ++memoizer_generation;
+  }
+}
+
 void Albany::Application::loadBasicWorksetInfo(PHAL::Workset &workset,
                                                 double current_time)
 {
+  updateMemoizerGeneration();
+
   auto overlapped_MV = solMgrT->getOverlappedSolution_Thyra();
   auto numVectors = overlapped_MV->domain()->dim();
 
@@ -2879,6 +3431,8 @@ void Albany::Application::loadBasicWorksetInfoSDBCs(
     const Teuchos::RCP<const Thyra_Vector>& owned_sol,
     const double current_time)
 {
+  updateMemoizerGeneration();
+
   // Scatter owned solution into the overlapped one
   auto overlapped_MV = solMgrT->getOverlappedSolution_Thyra();
   auto overlapped_sol = Thyra::createMember(overlapped_MV->range());
@@ -3077,6 +3631,8 @@ void Albany::Application::setupBasicWorksetInfo(
       p[i][j].family->setRealValueForAllTypes(p[i][j].baseValue);
   }}
 
+  updateMemoizerGeneration();
+
   workset.x = overlapped_x;
   workset.xdot = overlapped_xdot;
   workset.xdotdot = overlapped_xdotdot;
@@ -3270,4 +3826,35 @@ void Albany::Application::setCoupledAppBlockNodeset(
 
   coupled_app_index_block_nodeset_names_map_.insert(app_index_block_names);
 }
+
+bool Albany::Application::isCoupledToOtherApps() const {
+  for (auto i = 0; i < apps_.size(); ++i) {
+    auto const &app = apps_[i];
+    if (app.is_null() == true || app.get() == this) continue;
+    if (app->isCoupled(app_index_) == true) return true;
+  }
+  return false;
+}
+
+void Albany::Application::SolutionView::copy(
+    Teuchos::RCP<Thyra_Vector const> const &v) {
+  if (v == Teuchos::null) {
+    set(Teuchos::null);
+    return;
+  }
+
+  Teuchos::RCP<Tpetra_Vector const> const v_tpetra =
+      Albany::getConstTpetraVector(v);
+
+  bool const same_map = buffer != Teuchos::null &&
+                        (buffer->getMap() == v_tpetra->getMap() ||
+                         buffer->getMap()->isSameAs(*v_tpetra->getMap()));
+
+  if (same_map == false) {
+    buffer = Teuchos::rcp(new Tpetra_Vector(v_tpetra->getMap()));
+  }
+
+  buffer->assign(*v_tpetra);
+  set(buffer);
+}
 #endif
@@ -44,7 +44,10 @@
 #include "PHAL_AlbanyTraits.hpp"
 #include "PHAL_Setup.hpp"
 #include "PHAL_Workset.hpp"
+#include "EvaluatorMonitor.hpp"
+#include <mutex>
 #include <set>
+#include <vector>
 
 #if defined(ALBANY_EPETRA)
 
@@ -130,6 +133,11 @@ public:
   //! Get Tpetra Jacobian graph
   Teuchos::RCP<const Tpetra_CrsGraph> getJacobianGraphT() const;
 
+  //! Create a matrix holding only the node blocks of the Jacobian (the
+  //! coupling between the equations at each node). computeGlobalJacobian
+  //! fills it without assembling the full Jacobian.
+  Teuchos::RCP<Thyra_LinearOp> createBlockDiagonalJacobianOp();
+
 #if defined(ALBANY_EPETRA)
   //! Get Preconditioner Operator
   Teuchos::RCP<Epetra_Operator> getPreconditioner();
@@ -241,6 +249,25 @@ private:
       const Teuchos::RCP<Thyra_LinearOp>& jac,
       const double dt = 0.0);
 
+  //! Jacobian fill for problems with a constant Jacobian: recombine the
+  //! cached dF/dx, dF/dxdot and dF/dxdotdot, assembling them if needed
+  void computeConstantJacobian(
+      const double alpha, const double beta, const double omega,
+      const double current_time,
+      const Teuchos::RCP<const Thyra_Vector>& x,
+      const Teuchos::RCP<const Thyra_Vector>& xdot,
+      const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+      const Teuchos::Array<ParamVec> &p,
+      const Teuchos::RCP<Thyra_Vector>& f,
+      const Teuchos::RCP<Thyra_LinearOp>& jac,
+      const double dt);
+
+  //! Build the node block diagonal graphs, if missing or out of date
+  void buildBlockDiagonalGraphs();
+
+  //! Whether jac was created by createBlockDiagonalJacobianOp
+  bool isBlockDiagonalJacobian(const Teuchos::RCP<const Thyra_LinearOp>& jac) const;
+
 public:
   //! Compute global Preconditioner
   /*!
@@ -414,6 +441,10 @@ private:
 
   void defineTimers();
 
+  //! Bump the memoizer generation if the coordinates or the parameter
+  //! values changed since the last fill
+  void updateMemoizerGeneration();
+
   void
   removeEpetraRelatedPLs(const Teuchos::RCP<Teuchos::ParameterList> &params);
 
@@ -422,6 +453,10 @@ public:
   template <typename EvalT>
   void loadWorksetBucketInfo(PHAL::Workset &workset, const int &ws);
 
+  //! Make the memoized MDFields be recomputed on the next evaluation, e.g.
+  //! after input fields have been set in the discretization
+  void invalidateMemoizedFields() { ++memoizer_generation; }
+
   void loadBasicWorksetInfo(PHAL::Workset &workset, double current_time);
 
   void loadBasicWorksetInfoSDBCs(PHAL::Workset &workset,
@@ -466,6 +501,33 @@ public:
 
   void postRegSetup(std::string eval);
 
+private:
+  //! Group worksets into colors that share no overlapped dof
+  void computeWorksetColors();
+
+  //! Evaluate the volumetric field managers over all worksets, dispatching
+  //! the worksets of each color to the fill threads, then the Neumann field
+  //! managers serially
+  template <typename EvalT>
+  void evaluateFieldsThreaded(PHAL::Workset &workset);
+
+  //! Evaluate a volumetric field manager of physics set ps on a workset,
+  //! recording its cost when an evaluator profile is requested
+  template <typename EvalT>
+  void evaluateWorkset(PHX::FieldManager<PHAL::AlbanyTraits> &fm_ws,
+                       int const ps, PHAL::Workset &workset);
+
+  //! Add the accumulated time of each evaluator to the profile
+  template <typename EvalT>
+  void addEvaluatorTimes();
+
+public:
+
+  //! Reduce the evaluator profile across ranks and write it. This is
+  //! collective: every rank must call it, after the last fill. Does nothing
+  //! when no "Evaluator Profile File" was given.
+  void writeEvaluatorProfile();
+
 #if defined(ALBANY_LCM)
   double
   fixTime(double const current_time) const
@@ -568,23 +630,54 @@ public:
     return name;
   }
 
+  // Solution and time derivatives seen by the last residual evaluation
+  // (or set by the Schwarz solver), read by the coupled applications.
+  // The version counters change whenever the data may have changed.
   Teuchos::RCP<Tpetra_Vector const> const &
-  getX() const { return x_; }
+  getX() const { return x_.view; }
 
   Teuchos::RCP<Tpetra_Vector const> const &
-  getXdot() const { return xdot_; }
+  getXdot() const { return xdot_.view; }
 
   Teuchos::RCP<Tpetra_Vector const> const &
-  getXdotdot() const { return xdotdot_; }
+  getXdotdot() const { return xdotdot_.view; }
+
+  unsigned long
+  getXVersion() const { return x_.version; }
+
+  unsigned long
+  getXdotVersion() const { return xdot_.version; }
+
+  unsigned long
+  getXdotdotVersion() const { return xdotdot_.version; }
 
   void
-  setX(Teuchos::RCP<Tpetra_Vector const> const & x) { x_ = x; }
+  setX(Teuchos::RCP<Tpetra_Vector const> const & x) { x_.set(x); }
 
   void
-  setXdot(Teuchos::RCP<Tpetra_Vector const> const & xdot) { xdot_ = xdot; }
+  setXdot(Teuchos::RCP<Tpetra_Vector const> const & xdot) { xdot_.set(xdot); }
 
   void
-  setXdotdot(Teuchos::RCP<Tpetra_Vector const> const & xdotdot) { xdotdot_ = xdotdot; }
+  setXdotdot(Teuchos::RCP<Tpetra_Vector const> const & xdotdot) { xdotdot_.set(xdotdot); }
+
+  //! True if the solution of this application is read by another one
+  bool
+  isCoupledToOtherApps() const;
+
+  // Values of the coupled application at the nodes of the Schwarz node set,
+  // three per node in node set order. Set by the Schwarz solver when the
+  // coupled application lives on other ranks; they then take precedence
+  // over getX() of the coupled application.
+  std::vector<ST> &
+  getSchwarzBoundaryValues(int const app_index) {
+    return schwarz_boundary_values_[app_index];
+  }
+
+  std::vector<ST> const *
+  findSchwarzBoundaryValues(int const app_index) const {
+    auto it = schwarz_boundary_values_.find(app_index);
+    return it == schwarz_boundary_values_.end() ? nullptr : &(it->second);
+  }
 
   void
   setSchwarzAlternating(bool const isa) {is_schwarz_alternating_ = isa;}
@@ -602,11 +695,30 @@ private:
   std::map<int, std::pair<std::string, std::string>>
       coupled_app_index_block_nodeset_names_map_;
 
-  Teuchos::RCP<Tpetra_Vector const> x_{Teuchos::null};
+  // A vector published to the coupled applications. Copies made by the
+  // residual go into a persistent buffer, so they do not allocate.
+  struct SolutionView {
+    Teuchos::RCP<Tpetra_Vector const> view{Teuchos::null};
+
+    Teuchos::RCP<Tpetra_Vector> buffer{Teuchos::null};
+
+    unsigned long version{0};
+
+    void set(Teuchos::RCP<Tpetra_Vector const> const & v) {
+      view = v;
+      ++version;
+    }
+
+    void copy(Teuchos::RCP<Thyra_Vector const> const & v);
+  };
+
+  SolutionView x_;
 
-  Teuchos::RCP<Tpetra_Vector const> xdot_{Teuchos::null};
+  SolutionView xdot_;
 
-  Teuchos::RCP<Tpetra_Vector const> xdotdot_{Teuchos::null};
+  SolutionView xdotdot_;
+
+  std::map<int, std::vector<ST>> schwarz_boundary_values_;
 
   bool is_schwarz_alternating_{false};
 
@@ -687,6 +799,31 @@ protected:
   //! Phalanx Field Manager for states
   Teuchos::Array<Teuchos::RCP<PHX::FieldManager<PHAL::AlbanyTraits>>> sfm;
 
+  //! Number of threads filling worksets concurrently (1 = serial fill)
+  int num_fill_threads{1};
+
+  //! Volumetric field managers for fill threads 1..num_fill_threads-1
+  //! (thread 0 uses fm)
+  Teuchos::Array<
+      Teuchos::ArrayRCP<Teuchos::RCP<PHX::FieldManager<PHAL::AlbanyTraits>>>>
+      thread_fm;
+
+  //! File (.csv or .json) the evaluator profile is written to by
+  //! writeEvaluatorProfile(). Empty if profiling is off.
+  std::string evaluator_profile_file;
+  util::EvaluatorMonitor evaluator_monitor;
+  std::mutex evaluator_monitor_mutex;
+
+  //! Workset colors, and the connectivity they were computed from
+  std::vector<std::vector<int>> ws_colors;
+  Albany::Conn ws_colors_conn;
+
+  //! Generation of the memoized MDFields, and the coordinates generation
+  //! and parameter values it was last checked against
+  unsigned int memoizer_generation{0};
+  unsigned int memoizer_coords_generation{0};
+  std::vector<double> memoizer_param_values;
+
 #if defined(ALBANY_EPETRA)
   //! Product multi-comm
   Teuchos::RCP<const EpetraExt::MultiComm> product_comm;
@@ -754,6 +891,23 @@ protected:
   //  conditions, optionally add a small perturbation to the diag
   double perturbBetaForDirichlets;
 
+  //! The Jacobian only depends on the mesh, the parameters and the
+  //! time derivative coefficients (e.g., linear heat or elasticity)
+  bool constant_jacobian{false};
+
+  //! Cached dF/dx, dF/dxdot and dF/dxdotdot, and the parameter values and
+  //! time step they were assembled with. Rebuilt when any of these, or the
+  //! Jacobian graph (remeshing), changes.
+  Teuchos::Array<Teuchos::RCP<Thyra_LinearOp>> jac_parts;
+  Teuchos::Array<RealType> jac_parts_params;
+  double jac_parts_dt{0.0};
+
+  //! Owned and overlapped node block diagonal graphs, and the overlapped
+  //! matrix the block diagonal Jacobian is assembled into
+  Teuchos::RCP<const Tpetra_CrsGraph> block_diag_graphT;
+  Teuchos::RCP<const Tpetra_CrsGraph> block_diag_overlap_graphT;
+  Teuchos::RCP<Thyra_LinearOp> block_diag_overlapped_jac;
+
   void determinePiroSolver(
       const Teuchos::RCP<Teuchos::ParameterList> &topLevelParams);
 
@@ -800,6 +954,7 @@ void Albany::Application::loadWorksetBucketInfo(PHAL::Workset &workset,
   workset.local_Vp.resize(workset.numCells);
 
   workset.savedMDFields = phxSetup->get_saved_fields();
+  workset.memoizerGeneration = memoizer_generation;
 
   //  workset.print(*out);
 
@@ -808,6 +963,8 @@ void Albany::Application::loadWorksetBucketInfo(PHAL::Workset &workset,
 
   workset.stateArrayPtr =
       &stateMgr.getStateArray(Albany::StateManager::ELEM, ws);
+  workset.stateTablePtr =
+      &stateMgr.getStateTable(Albany::StateManager::ELEM, ws);
 #if defined(ALBANY_EPETRA)
   workset.disc = disc; // Needed by LandIce for sideset DOF save
   workset.eigenDataPtr = stateMgr.getEigenData();
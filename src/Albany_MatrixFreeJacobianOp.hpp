@@ -0,0 +1,144 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_MATRIX_FREE_JACOBIAN_OP_HPP
+#define ALBANY_MATRIX_FREE_JACOBIAN_OP_HPP
+
+#include "Albany_Application.hpp"
+#include "Albany_ThyraTypes.hpp"
+
+#include "Thyra_MultiVectorStdOps.hpp"
+#include "Teuchos_RCP.hpp"
+
+namespace Albany {
+
+  //! Thyra_LinearOp implementing the action of W = alpha*df/dxdot + beta*df/dx + omega*df/dxdotdot
+  /*!
+   * This class implements the Thyra::LinearOpBase interface for W*v, without
+   * storing W. Each apply() runs a Tangent fill of the residual, seeded with
+   * v in x, xdot and xdotdot. The Tangent seeds are scaled by beta, alpha
+   * and omega respectively, so the tangent of the residual is exactly W*v.
+   *
+   * The point where W is evaluated is set with set(), which copies the
+   * solution vectors, so the operator stays valid when the solver updates
+   * them in place.
+   */
+  class MatrixFreeJacobianOp : public Thyra_LinearOp {
+  public:
+
+    // Constructor
+    MatrixFreeJacobianOp(const Teuchos::RCP<Application>& app_) :
+      app(app_),
+      alpha(0.0),
+      beta(1.0),
+      omega(0.0),
+      time(0.0) {}
+
+    //! Destructor
+    virtual ~MatrixFreeJacobianOp() {}
+
+    //! Set values needed for apply()
+    void set(const double alpha_,
+             const double beta_,
+             const double omega_,
+             const double time_,
+             const Teuchos::RCP<const Thyra_Vector>& x_,
+             const Teuchos::RCP<const Thyra_Vector>& xdot_,
+             const Teuchos::RCP<const Thyra_Vector>& xdotdot_,
+             const Teuchos::Array<ParamVec>& scalar_params_) {
+      alpha = alpha_;
+      beta = beta_;
+      omega = omega_;
+      time = time_;
+      x = x_->clone_v();
+      xdot = Teuchos::nonnull(xdot_) ? xdot_->clone_v() : Teuchos::null;
+      xdotdot = Teuchos::nonnull(xdotdot_) ? xdotdot_->clone_v() : Teuchos::null;
+      scalar_params = scalar_params_;
+    }
+
+    //! Overrides Thyra::LinearOpBase purely virtual method
+    Teuchos::RCP<const Thyra_VectorSpace> domain() const {
+      return app->getVectorSpace();
+    }
+
+    //! Overrides Thyra::LinearOpBase purely virtual method
+    Teuchos::RCP<const Thyra_VectorSpace> range() const {
+      return app->getVectorSpace();
+    }
+
+    //@}
+
+  protected:
+    //! Overrides Thyra::LinearOpBase purely virtual method
+    bool opSupportedImpl(Thyra::EOpTransp M_trans) const {
+      // The Tangent fill only gives the forward action
+      return Thyra::real_trans(M_trans) == Thyra::NOTRANS;
+    }
+
+    //! Overrides Thyra::LinearOpBase purely virtual method
+    void applyImpl (const Thyra::EOpTransp /* M_trans */,
+                    const Thyra_MultiVector& X,
+                    const Teuchos::Ptr<Thyra_MultiVector>& Y,
+                    const ST a,
+                    const ST b) const {
+      TEUCHOS_TEST_FOR_EXCEPTION (x.is_null(), std::logic_error,
+                                  "Error! MatrixFreeJacobianOp::set must be called before apply.\n");
+
+      const Teuchos::RCP<const Thyra_MultiVector> V = Teuchos::rcpFromRef(X);
+      const Teuchos::RCP<Thyra_MultiVector> WV =
+          (a==1.0 && b==0.0) ? Teuchos::rcpFromPtr(Y) : Thyra::createMembers(range(),X.domain()->dim());
+
+      app->computeGlobalTangent(alpha, beta, omega, time, false,
+                                x, xdot, xdotdot,
+                                scalar_params, NULL,
+                                V,
+                                Teuchos::nonnull(xdot) ? V : Teuchos::null,
+                                Teuchos::nonnull(xdotdot) ? V : Teuchos::null,
+                                Teuchos::null,
+                                Teuchos::null, WV, Teuchos::null);
+
+      // Y = a*W*X + b*Y
+      if (WV.get()!=Y.get()) {
+        if (b==0.0) {
+          Thyra::assign(Y,0.0);
+        } else {
+          Thyra::scale(b,Y);
+        }
+        Thyra::update(a,*WV,Y);
+      }
+    }
+
+    //! Albany applications
+    Teuchos::RCP<Application> app;
+
+    //! @name Data needed for apply()
+    //@{
+
+    //! Coefficients of df/dxdot, df/dx and df/dxdotdot
+    double alpha, beta, omega;
+
+    //! Current time
+    double time;
+
+    //! Solution vector
+    Teuchos::RCP<const Thyra_Vector> x;
+
+    //! Velocity vector
+    Teuchos::RCP<const Thyra_Vector> xdot;
+
+    //! Acceleration vector
+    Teuchos::RCP<const Thyra_Vector> xdotdot;
+
+    //! Scalar parameters
+    Teuchos::Array<ParamVec> scalar_params;
+
+    //@}
+
+  }; // class MatrixFreeJacobianOp
+
+} // namespace Albany
+
+#endif // ALBANY_MATRIX_FREE_JACOBIAN_OP_HPP
@@ -10,6 +10,7 @@
 
 #include "Albany_DistributedParameterLibrary.hpp"
 #include "Albany_DistributedParameterDerivativeOp.hpp"
+#include "Albany_MatrixFreeJacobianOp.hpp"
 #include "Teuchos_ScalarTraits.hpp"
 #include "Teuchos_TestForException.hpp"
 #include "Tpetra_ConfigDefs.hpp"
@@ -58,6 +59,22 @@ ModelEvaluatorT::ModelEvaluatorT(
   const std::string soln_method = problemParams.get("Solution Method", "Steady"); 
   if (soln_method == "Transient Tempus") use_tempus = true; 
 
+  matrix_free = problemParams.get("Matrix-Free Jacobian", false);
+  const std::string mf_prec = problemParams.get<std::string>("Matrix-Free Preconditioner", "None");
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      mf_prec != "None" && mf_prec != "Block Jacobi", std::logic_error,
+      "Error! Unknown Matrix-Free Preconditioner '" << mf_prec << "'. Valid choices are None and Block Jacobi.\n");
+  if (matrix_free) {
+    // The SDBC Tangent fill reads the diagonal of the assembled Jacobian
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        app->getProblem()->useSDBCs(), std::logic_error,
+        "Error! The matrix-free Jacobian does not support strong Dirichlet BCs (SDBCs).\n");
+    block_jacobi_prec = (mf_prec == "Block Jacobi");
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        block_jacobi_prec && supplies_prec, std::logic_error,
+        "Error! The problem supplies its own preconditioner, which cannot be combined with a Matrix-Free Preconditioner.\n");
+  }
+
   num_param_vecs = parameterParams.get("Number of Parameter Vectors", 0);
   bool using_old_parameter_list = false;
   if (parameterParams.isType<int>("Number")) {
@@ -483,6 +500,10 @@ ModelEvaluatorT::getUpperBounds() const
 Teuchos::RCP<Thyra::LinearOpBase<ST>>
 ModelEvaluatorT::create_W_op() const
 {
+  if (matrix_free) {
+    return Teuchos::rcp(new MatrixFreeJacobianOp(app));
+  }
+
   const Teuchos::RCP<Tpetra_Operator> W =
       Teuchos::rcp(new Tpetra_CrsMatrix(app->getJacobianGraphT()));
   return Thyra::createLinearOp(W);
@@ -492,6 +513,13 @@ Teuchos::RCP<Thyra::PreconditionerBase<ST>>
 ModelEvaluatorT::create_W_prec() const
 {
   Teuchos::RCP<Thyra::DefaultPreconditioner<ST>> W_prec  = Teuchos::rcp(new Thyra::DefaultPreconditioner<ST>);
+
+  if (block_jacobi_prec) {
+    // Filled in evalModelImpl with the inverse of the node blocks of W
+    W_prec->initializeRight(app->createBlockDiagonalJacobianOp());
+    return W_prec;
+  }
+
   Teuchos::RCP<Tpetra_Operator>                  precOpT = app->getPreconditionerT();
   Teuchos::RCP<Thyra::LinearOpBase<ST>>          precOp  = Thyra::createLinearOp(precOpT);
 
@@ -608,7 +636,7 @@ ModelEvaluatorT::createOutArgsImpl() const
 
   result.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_f, true);
 
-  if (supplies_prec)
+  if (supplies_prec || block_jacobi_prec)
     result.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_W_prec, true);
 
   result.setSupports(Thyra::ModelEvaluatorBase::OUT_ARG_W_op, true);
@@ -863,12 +891,38 @@ ModelEvaluatorT::evalModelImpl(
 
   // W matrix
   if (Teuchos::nonnull(W_op_out)) {
-    app->computeGlobalJacobian(
-        alpha, beta, omega, curr_time,
-        x, x_dot, x_dotdot,
-        sacado_param_vec,
-        f_out, W_op_out, dt);
-    f_already_computed = true;
+    if (matrix_free) {
+      // Only record the point of evaluation: each apply() is a Tangent fill
+      Teuchos::rcp_dynamic_cast<MatrixFreeJacobianOp>(W_op_out,true)->set(
+          alpha, beta, omega, curr_time,
+          x, x_dot, x_dotdot,
+          sacado_param_vec);
+    } else {
+      app->computeGlobalJacobian(
+          alpha, beta, omega, curr_time,
+          x, x_dot, x_dotdot,
+          sacado_param_vec,
+          f_out, W_op_out, dt);
+      f_already_computed = true;
+    }
+  }
+
+  // Block Jacobi preconditioner for the matrix-free W
+  if (block_jacobi_prec) {
+    const auto W_prec_out = outArgsT.get_W_prec();
+    if (Teuchos::nonnull(W_prec_out)) {
+      const auto W_blocks = W_prec_out->getNonconstRightPrecOp();
+      app->computeGlobalJacobian(
+          alpha, beta, omega, curr_time,
+          x, x_dot, x_dotdot,
+          sacado_param_vec,
+          f_out, W_blocks, dt);
+      f_already_computed = true;
+
+      resumeFill(W_blocks);
+      invertDiagonalBlocks(W_blocks);
+      fillComplete(W_blocks);
+    }
   }
   /*
    *  Commenting this out for now, cause it seems it is never used. If that turns out to
@@ -55,6 +55,13 @@ class ModelEvaluatorT : public Piro::TransientDecorator<ST, LO, Tpetra_GO, Kokko
   Thyra::ModelEvaluatorBase::InArgs<ST>
   getNominalValues() const;
 
+  //! Replace the nominal values (e.g., the initial guess of a later solve)
+  void
+  setNominalValues(Thyra::ModelEvaluatorBase::InArgs<ST> nv)
+  {
+    nominalValues = nv;
+  }
+
   Thyra::ModelEvaluatorBase::InArgs<ST>
   getLowerBounds() const;
 
@@ -99,12 +106,6 @@ class ModelEvaluatorT : public Piro::TransientDecorator<ST, LO, Tpetra_GO, Kokko
     current_time_ = t;
     return;
   }
-
-  void
-  setNominalValues(Thyra::ModelEvaluatorBase::InArgs<ST> nv)
-  {
-    nominalValues = nv;
-  }
 #endif // ALBANY_LCM
 
  protected:
@@ -154,6 +155,12 @@ class ModelEvaluatorT : public Piro::TransientDecorator<ST, LO, Tpetra_GO, Kokko
   //! Boolean marking whether Tempus is used 
   bool use_tempus{false}; 
 
+  //! W is applied with a Tangent fill instead of being assembled
+  bool matrix_free{false};
+
+  //! Precondition the matrix-free W with the inverse of its node blocks
+  bool block_jacobi_prec{false};
+
   //@}
 
  protected:
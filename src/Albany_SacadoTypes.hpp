@@ -34,6 +34,9 @@
 // ******************************************************************
 
 // Switch between dynamic and static FAD types
+// Note: one size for all element blocks. There is no runtime choice of a
+// static size per block; Application::postRegSetup only checks that each
+// block fits and reports the smallest size that would.
 #if defined(ALBANY_FAD_TYPE_SFAD)
 typedef Sacado::Fad::SFad<RealType, ALBANY_SFAD_SIZE> FadType;
 #elif defined(ALBANY_FAD_TYPE_SLFAD)
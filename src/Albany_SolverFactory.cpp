@@ -55,6 +55,7 @@
 
 #ifdef ALBANY_AERAS
 #include "Aeras/Aeras_HVDecorator.hpp"
+#include "Aeras/Aeras_LumpedMassDecorator.hpp"
 #endif
 
 #include "Thyra_DefaultModelEvaluatorWithSolveFactory.hpp"
@@ -509,6 +510,43 @@ enableMueLu(
   Stratimikos::enableMueLu<LO, Tpetra_GO, KokkosNode>(linearSolverBuilder);
 #endif
 }
+
+#ifdef ALBANY_AERAS
+bool
+useLumpedMassExplicitStepping(const RCP<ParameterList>& problemParams)
+{
+  for (const std::string name : {"Shallow Water Problem", "Hydrostatic Problem",
+                                 "XZHydrostatic Problem"}) {
+    if (problemParams->isSublist(name) &&
+        problemParams->sublist(name).get<bool>(
+            "Lumped Mass Explicit Stepping", false))
+      return true;
+  }
+  return false;
+}
+
+// Wrap the model so that explicit steppers apply the inverse lumped mass
+// instead of assembling and solving with the mass matrix.
+RCP<Thyra::ModelEvaluator<ST>>
+decorateLumpedMass(
+    const RCP<Thyra::ModelEvaluator<ST>>& model,
+    const RCP<Albany::Application>&       app,
+    const RCP<ParameterList>&             piroParams)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      !app->getDiscretization()->isExplicitScheme(),
+      std::logic_error,
+      "Error: Lumped Mass Explicit Stepping requires an explicit scheme."
+          << "\n");
+
+  // The decorated model is already in explicit form
+  for (const std::string name : {"Rythmos Solver", "Tempus"}) {
+    if (piroParams->isSublist(name))
+      piroParams->sublist(name).set("Invert Mass Matrix", false);
+  }
+  return rcp(new Aeras::LumpedMassDecorator(model));
+}
+#endif
 }  // namespace
 
 Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST>>
@@ -613,11 +651,16 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
 
       albanyApp = app;
 
+      RCP<Thyra::ModelEvaluator<ST>> modelExplicit = modelHV;
+      if (useLumpedMassExplicitStepping(problemParams)) {
+        modelExplicit = decorateLumpedMass(modelHV, app, piroParams);
+      }
+
       RCP<Thyra::ModelEvaluator<ST>> modelWithSolveT;
 
       modelWithSolveT =
           rcp(new Thyra::DefaultModelEvaluatorWithSolveFactory<ST>(
-              modelHV, lowsFactory));
+              modelExplicit, lowsFactory));
 
       observerT_ = rcp(new PiroObserverT(albanyApp, modelWithSolveT));
 
@@ -693,6 +736,12 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
   const Teuchos::RCP<Teuchos::ParameterList> stratList =
       Piro::extractStratimikosParams(piroParams);
 
+#ifdef ALBANY_AERAS
+  if (useLumpedMassExplicitStepping(problemParams)) {
+    modelT_ = decorateLumpedMass(modelT_, app, piroParams);
+  }
+#endif
+
   if (Teuchos::is_null(stratList)) {
     *out << "Error: cannot locate Stratimikos solver parameters in the input "
             "file."
@@ -17,6 +17,8 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <utility>
 
 #include "Phalanx_DataLayout.hpp"
 #include "Shards_Array.hpp"
@@ -46,12 +48,120 @@ using IDArray = shards::Array<LO, shards::NaturalOrder>;
 using StateArray = std::map<std::string, MDArray>;
 using StateArrayVec = std::vector<StateArray>;
 
+//! Integer handle of a state name. Handles are the same for every workset and
+//  application, so evaluators can resolve them once (e.g., in the constructor)
+//  instead of looking the name up in the StateArray at every evaluation.
+using StateHandle = int;
+
+inline StateHandle
+getStateHandle(const std::string& name)
+{
+  static std::map<std::string, StateHandle> handles;
+  static std::mutex                         handles_mutex;
+
+  std::lock_guard<std::mutex> lock(handles_mutex);
+  auto it = handles.find(name);
+  if (it == handles.end()) {
+    const StateHandle h = handles.size();
+    it = handles.emplace(name, h).first;
+  }
+  return it->second;
+}
+
+//! The arrays of one workset, indexed by StateHandle. The pointers refer to
+//  the entries of the StateArray the table was built from (see
+//  indexStateArrays), so they follow the swaps done by updateStates.
+struct StateTable
+{
+  const StateArray*     owner = nullptr;
+  std::vector<MDArray*> arrays;
+
+  //! Null if the workset does not have this state
+  MDArray*
+  get(const StateHandle h) const
+  {
+    return h < static_cast<StateHandle>(arrays.size()) ? arrays[h] : nullptr;
+  }
+};
+
+using StateTableVec = std::vector<StateTable>;
+
 struct StateArrays
 {
   StateArrayVec elemStateArrays;
   StateArrayVec nodeStateArrays;
+
+  // Handle tables of the arrays above, rebuilt by indexStateArrays whenever
+  // the discretization (re)builds or copies the StateArrays
+  StateTableVec elemStateTables;
+  StateTableVec nodeStateTables;
+
+  // States whose old values were last updated by swapping the "name" and
+  // "name_old" arrays (see StateManager::updateStates) and whose mesh fields
+  // have not been synchronized since. The flag is true when the two arrays
+  // currently view each other's mesh field.
+  std::map<std::string, bool> swappedElemStates;
+  std::map<std::string, bool> swappedNodeStates;
 };
 
+inline void
+indexStateArrays(StateArrayVec& sav, StateTableVec& tables)
+{
+  tables.resize(sav.size());
+  for (std::size_t ws = 0; ws < sav.size(); ++ws) {
+    StateTable& table = tables[ws];
+    table.owner       = &sav[ws];
+    table.arrays.clear();
+    for (auto& it : sav[ws]) {
+      const StateHandle h = getStateHandle(it.first);
+      if (h >= static_cast<StateHandle>(table.arrays.size()))
+        table.arrays.resize(h + 1, nullptr);
+      table.arrays[h] = &it.second;
+    }
+  }
+}
+
+//! Build the handle tables of all worksets. Must be called after the maps are
+//  filled, and again after the StateArrays are copied.
+inline void
+indexStateArrays(StateArrays& sa)
+{
+  indexStateArrays(sa.elemStateArrays, sa.elemStateTables);
+  indexStateArrays(sa.nodeStateArrays, sa.nodeStateTables);
+}
+
+//! Make the "name" and "name_old" arrays of every swapped state view their own
+//  mesh field again, and give both fields the latest (old) values. Needed
+//  before anything reads the state fields by name, e.g. the output.
+inline void
+syncSwappedStates(
+    StateArrayVec&               sav,
+    std::map<std::string, bool>& swapped)
+{
+  for (auto& it : swapped) {
+    const std::string stateName     = it.first;
+    const std::string stateName_old = stateName + "_old";
+    for (auto& sa : sav) {
+      MDArray& state     = sa[stateName];
+      MDArray& state_old = sa[stateName_old];
+      if (it.second) {
+        std::swap(state, state_old);
+        for (int j = 0; j < state.size(); j++) state_old[j] = state[j];
+      } else {
+        for (int j = 0; j < state.size(); j++) state[j] = state_old[j];
+      }
+    }
+  }
+  swapped.clear();
+}
+
+inline void
+syncSwappedStates(StateArrays& sa)
+{
+  syncSwappedStates(sa.elemStateArrays, sa.swappedElemStates);
+  syncSwappedStates(sa.nodeStateArrays, sa.swappedNodeStates);
+}
+
 //! Container to get state info from StateManager to STK. Made into a struct so
 //  the information can continue to evolve without changing the interfaces.
 
@@ -14,7 +14,9 @@
 //#define DEBUG_INTERNAL_STATES
 
 Albany::StateManager::StateManager()
-    : stateVarsAreAllocated(false), stateInfo(Teuchos::rcp(new StateInfoStruct))
+    : stateVarsAreAllocated(false),
+      swapOldStates(false),
+      stateInfo(Teuchos::rcp(new StateInfoStruct))
 {
   // Nothing to be done here
 }
@@ -849,6 +851,28 @@ Albany::StateManager::getStateArray(SAType type, const int ws) const
   }
 }
 
+const Albany::StateTable&
+Albany::StateManager::getStateTable(SAType type, const int ws) const
+{
+  ALBANY_ASSERT(stateVarsAreAllocated == true);
+
+  const Albany::StateArrays& sa = getStateArrays();
+  switch (type) {
+    case ELEM:
+      ALBANY_EXPECT(sa.elemStateTables[ws].owner == &sa.elemStateArrays[ws]);
+      return sa.elemStateTables[ws];
+    case NODE:
+      ALBANY_EXPECT(sa.nodeStateTables[ws].owner == &sa.nodeStateArrays[ws]);
+      return sa.nodeStateTables[ws];
+    default:
+      TEUCHOS_TEST_FOR_EXCEPTION(
+          true,
+          std::logic_error,
+          "Error: Cannot match state array type in getStateTable()"
+              << std::endl);
+  }
+}
+
 Albany::StateArrays&
 Albany::StateManager::getStateArrays() const
 {
@@ -897,35 +921,51 @@ Albany::StateManager::updateStates()
   int                    numElemWorksets = esa.size();
   int                    numNodeWorksets = nsa.size();
 
+  // When swapping, the new arrays are left with stale values. This is fine
+  // for the evaluators, which overwrite the new states, while whoever reads
+  // the fields by name must call syncSwappedStates first.
+  auto update = [&](Albany::StateArrayVec&       arrays,
+                    const int                    numWorksets,
+                    std::map<std::string, bool>& swapped,
+                    const std::string&           stateName) {
+    const std::string stateName_old = stateName + "_old";
+    if (swapOldStates) {
+      for (int ws = 0; ws < numWorksets; ws++)
+        std::swap(arrays[ws][stateName], arrays[ws][stateName_old]);
+      auto it = swapped.find(stateName);
+      if (it == swapped.end())
+        swapped[stateName] = true;
+      else
+        it->second = !it->second;
+    } else {
+      for (int ws = 0; ws < numWorksets; ws++)
+        for (int j = 0; j < arrays[ws][stateName].size(); j++)
+          arrays[ws][stateName_old][j] = arrays[ws][stateName][j];
+    }
+  };
+
   // For each workset, loop over registered states
 
   for (unsigned int i = 0; i < stateInfo->size(); i++) {
     if ((*stateInfo)[i]->saveOldState) {
-      const std::string stateName     = (*stateInfo)[i]->name;
-      const std::string stateName_old = stateName + "_old";
+      const std::string stateName = (*stateInfo)[i]->name;
 
       switch ((*stateInfo)[i]->entity) {
         case Albany::StateStruct::NodalDataToElemNode:
-          for (int ws = 0; ws < numNodeWorksets; ws++)
-            for (int j = 0; j < nsa[ws][stateName].size(); j++)
-              nsa[ws][stateName_old][j] = nsa[ws][stateName][j];
+          update(nsa, numNodeWorksets, sa.swappedNodeStates, stateName);
 
         case Albany::StateStruct::WorksetValue:
         case Albany::StateStruct::ElemData:
         case Albany::StateStruct::QuadPoint:
         case Albany::StateStruct::ElemNode:
 
-          for (int ws = 0; ws < numElemWorksets; ws++)
-            for (int j = 0; j < esa[ws][stateName].size(); j++)
-              esa[ws][stateName_old][j] = esa[ws][stateName][j];
+          update(esa, numElemWorksets, sa.swappedElemStates, stateName);
 
           break;
 
         case Albany::StateStruct::NodalData:
 
-          for (int ws = 0; ws < numNodeWorksets; ws++)
-            for (int j = 0; j < nsa[ws][stateName].size(); j++)
-              nsa[ws][stateName_old][j] = nsa[ws][stateName][j];
+          update(nsa, numNodeWorksets, sa.swappedNodeStates, stateName);
 
           break;
 
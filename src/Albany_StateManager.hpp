@@ -195,6 +195,15 @@ class StateManager {
   void
   updateStates();
 
+  /// Update old states by swapping the new and old arrays rather than copying
+  /// them. The mesh fields are only synchronized when the discretization
+  /// writes them (see syncSwappedStates).
+  void
+  setSwapOldStates(const bool swap)
+  {
+    swapOldStates = swap;
+  }
+
   /// Method to get a StateInfoStruct of info needed by STK to output States as
   /// Fields
   Teuchos::RCP<Albany::StateInfoStruct>
@@ -216,6 +225,10 @@ class StateManager {
   Albany::StateArray&
   getStateArray(SAType type, int ws) const;
 
+  /// Method to get the handle table of the states of a specific workset
+  const Albany::StateTable&
+  getStateTable(SAType type, int ws) const;
+
   /// Method to get state information for all worksets
   Albany::StateArrays&
   getStateArrays() const;
@@ -284,6 +297,9 @@ class StateManager {
   /// and befor gets
   bool stateVarsAreAllocated;
 
+  /// Whether updateStates swaps the new and old arrays instead of copying
+  bool swapOldStates;
+
   /// Container to hold the states that have been registered, by element block,
   /// to be allocated later
   std::map<std::string, RegisteredStates> statesToStore;
@@ -17,6 +17,7 @@
 #include "PHAL_AlbanyTraits.hpp"
 #include "PHAL_Dirichlet.hpp"
 #include "Sacado_ParameterAccessor.hpp"
+#include "SchwarzPointLocator.hpp"
 
 #if defined(ALBANY_DTK)
 #include "DTK_MapOperatorFactory.hpp"
@@ -129,6 +130,8 @@ class SchwarzBC_Base : public PHAL::DirichletBase<EvalT, Traits>
   int this_app_index_{-1};
 
   int coupled_app_index_{-1};
+
+  SchwarzPointLocator point_locator_;
 };
 
 //
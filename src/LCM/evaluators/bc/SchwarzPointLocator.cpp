@@ -0,0 +1,388 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "SchwarzPointLocator.hpp"
+
+#include <algorithm>
+
+#include "Albany_STKDiscretization.hpp"
+#include "Intrepid2_CellTools.hpp"
+#include "Intrepid2_HGRAD_HEX_C1_FEM.hpp"
+#include "Intrepid2_HGRAD_TET_C1_FEM.hpp"
+#include "MiniTensor.h"
+#include "Teuchos_TimeMonitor.hpp"
+
+namespace LCM {
+
+namespace {
+
+// This tolerance is used for geometric approximations. It will be used
+// to determine whether a node of this_app is inside an element of
+// coupled_app within that tolerance.
+double const tolerance = 5.0e-2;
+
+}  // anonymous namespace
+
+//
+//
+//
+bool
+SchwarzPointLocator::isCurrent(
+    Albany::STKDiscretization const& this_disc,
+    Albany::STKDiscretization const& coupled_disc,
+    std::string const&               nodeset_name,
+    std::string const&               coupled_block_name) const
+{
+  auto const& ns_coord = this_disc.getNodeSetCoords().find(nodeset_name)->second;
+
+  return coupled_connectivity_ == coupled_disc.getWsElNodeID().getRawPtr() &&
+         nodeset_coordinates_ == ns_coord.data() &&
+         nodeset_size_ == ns_coord.size() && nodeset_name_ == nodeset_name &&
+         coupled_block_name_ == coupled_block_name;
+}
+
+//
+//
+//
+void
+SchwarzPointLocator::build(
+    Albany::STKDiscretization const& this_disc,
+    Albany::STKDiscretization const& coupled_disc,
+    std::string const&               nodeset_name,
+    std::string const&               coupled_block_name,
+    CellTopologyData const&          coupled_cell_topology_data)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("> Albany Schwarz: Build Point Locator");
+
+  auto const& ns_coord = this_disc.getNodeSetCoords().find(nodeset_name)->second;
+
+  buildGrid(coupled_disc, coupled_block_name, coupled_cell_topology_data);
+
+  locations_.assign(ns_coord.size(), Location());
+
+  coupled_connectivity_ = coupled_disc.getWsElNodeID().getRawPtr();
+  nodeset_coordinates_  = ns_coord.data();
+  nodeset_size_         = ns_coord.size();
+  nodeset_name_         = nodeset_name;
+  coupled_block_name_   = coupled_block_name;
+}
+
+//
+// Copy the coupled coordinates the grid is built from. True if they
+// changed since the last copy.
+//
+bool
+SchwarzPointLocator::updateReferenceCoordinates(
+    Albany::STKDiscretization const& coupled_disc)
+{
+  Teuchos::ArrayRCP<double> const& coupled_coordinates =
+      coupled_disc.getCoordinates();
+
+  bool const moved =
+      static_cast<size_t>(coupled_coordinates.size()) !=
+          reference_coordinates_.size() ||
+      std::equal(
+          coupled_coordinates.begin(),
+          coupled_coordinates.end(),
+          reference_coordinates_.begin()) == false;
+
+  if (moved == true) {
+    reference_coordinates_.assign(
+        coupled_coordinates.begin(), coupled_coordinates.end());
+  }
+
+  return moved;
+}
+
+//
+//
+//
+void
+SchwarzPointLocator::buildGrid(
+    Albany::STKDiscretization const& coupled_disc,
+    std::string const&               coupled_block_name,
+    CellTopologyData const&          coupled_cell_topology_data)
+{
+  auto const& ws_elem_to_node_id = coupled_disc.getWsElNodeID();
+
+  auto const& coupled_ws_eb_names = coupled_disc.getWsEBNames();
+
+  std::vector<double> const& coupled_coordinates = reference_coordinates_;
+
+  Teuchos::RCP<Tpetra_Map const> coupled_overlap_node_map =
+      coupled_disc.getOverlapNodeMapT();
+
+  auto const coupled_dimension = coupled_cell_topology_data.dimension;
+
+  auto const coupled_node_count = coupled_cell_topology_data.node_count;
+
+  bool const use_block = coupled_block_name != "NONE";
+
+  std::vector<BoundingBoxGrid::Box> boxes;
+
+  box_elements_.clear();
+
+  for (auto workset = 0; workset < ws_elem_to_node_id.size(); ++workset) {
+    std::string const& coupled_element_block = coupled_ws_eb_names[workset];
+
+    bool const block_names_differ = coupled_element_block != coupled_block_name;
+
+    if (use_block == true && block_names_differ == true) continue;
+
+    auto const elements_per_workset = ws_elem_to_node_id[workset].size();
+
+    for (auto element = 0; element < elements_per_workset; ++element) {
+      BoundingBoxGrid::Box box;
+
+      for (auto node = 0; node < coupled_node_count; ++node) {
+        auto const global_node_id = ws_elem_to_node_id[workset][element][node];
+
+        auto const local_node_id =
+            coupled_overlap_node_map->getLocalElement(global_node_id);
+
+        double const* const pcoord = &(coupled_coordinates[3 * local_node_id]);
+
+        for (auto i = 0; i < coupled_dimension; ++i) {
+          box.lo[i] = node == 0 ? pcoord[i] : std::min(box.lo[i], pcoord[i]);
+          box.hi[i] = node == 0 ? pcoord[i] : std::max(box.hi[i], pcoord[i]);
+        }
+      }
+
+      // Make the boxes as forgiving as the parametric test below.
+      BoundingBoxGrid::inflate(box, coupled_dimension, 2.0 * tolerance);
+
+      boxes.push_back(box);
+      box_elements_.push_back(std::make_pair(workset, element));
+    }
+  }
+
+  grid_.build(coupled_dimension, boxes);
+}
+
+//
+//
+//
+SchwarzPointLocator::Location const&
+SchwarzPointLocator::locate(
+    Albany::STKDiscretization const& this_disc,
+    Albany::STKDiscretization const& coupled_disc,
+    std::string const&               nodeset_name,
+    std::string const&               coupled_block_name,
+    CellTopologyData const&          coupled_cell_topology_data,
+    size_t const                     ns_node)
+{
+  bool rebuild =
+      isCurrent(this_disc, coupled_disc, nodeset_name, coupled_block_name) ==
+      false;
+
+  // Every sweep over the node set starts at its first node. Check there
+  // whether the coupled mesh has moved since the search was built.
+  // Gathering the coordinates is linear in the number of coupled nodes,
+  // so it is not done for every node.
+  if (rebuild == true || ns_node == 0) {
+    bool const moved = updateReferenceCoordinates(coupled_disc);
+
+    rebuild = rebuild || moved;
+  }
+
+  if (rebuild == true) {
+    build(
+        this_disc,
+        coupled_disc,
+        nodeset_name,
+        coupled_block_name,
+        coupled_cell_topology_data);
+  }
+
+  Location& location = locations_[ns_node];
+
+  if (location.workset >= 0) return location;
+
+  auto const& ns_coord = this_disc.getNodeSetCoords().find(nodeset_name)->second;
+
+  search(coupled_disc, coupled_cell_topology_data, ns_coord[ns_node], location);
+
+  return location;
+}
+
+//
+//
+//
+std::vector<SchwarzPointLocator::Location>
+SchwarzPointLocator::locatePoints(
+    Albany::STKDiscretization const& coupled_disc,
+    std::string const&               coupled_block_name,
+    CellTopologyData const&          coupled_cell_topology_data,
+    std::vector<double> const&       points)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("> Albany Schwarz: Locate Points");
+
+  updateReferenceCoordinates(coupled_disc);
+
+  buildGrid(coupled_disc, coupled_block_name, coupled_cell_topology_data);
+
+  // The grid no longer matches the node set cache.
+  coupled_connectivity_ = nullptr;
+
+  auto const number_points = points.size() / 3;
+
+  std::vector<Location> locations(number_points);
+
+  for (auto point = 0; point < number_points; ++point) {
+    search(
+        coupled_disc,
+        coupled_cell_topology_data,
+        &(points[3 * point]),
+        locations[point]);
+  }
+
+  return locations;
+}
+
+//
+// Find the first candidate element that contains the point, and the
+// values of its shape functions there.
+//
+void
+SchwarzPointLocator::search(
+    Albany::STKDiscretization const& coupled_disc,
+    CellTopologyData const&          coupled_cell_topology_data,
+    double const* const              coord,
+    Location&                        location) const
+{
+  auto const& ws_elem_to_node_id = coupled_disc.getWsElNodeID();
+
+  Teuchos::RCP<Tpetra_Map const> coupled_overlap_node_map =
+      coupled_disc.getOverlapNodeMapT();
+
+  shards::CellTopology coupled_cell_topology(&coupled_cell_topology_data);
+
+  auto const coupled_dimension = coupled_cell_topology_data.dimension;
+
+  auto const coupled_node_count = coupled_cell_topology_data.node_count;
+
+  auto const parametric_dimension = coupled_dimension;
+
+  auto const coupled_vertex_count = coupled_cell_topology_data.vertex_count;
+
+  auto const coupled_element_type =
+      minitensor::find_type(coupled_dimension, coupled_vertex_count);
+
+  minitensor::Vector<double> lo(parametric_dimension, minitensor::Filler::ONES);
+
+  minitensor::Vector<double> hi(parametric_dimension, minitensor::Filler::ONES);
+
+  hi = hi * (1.0 + tolerance);
+
+  Teuchos::RCP<Intrepid2::Basis<PHX::Device, RealType, RealType>> basis;
+
+  switch (coupled_element_type) {
+    default: MT_ERROR_EXIT("Unknown element type"); break;
+
+    case minitensor::ELEMENT::TETRAHEDRAL:
+      basis =
+          Teuchos::rcp(new Intrepid2::Basis_HGRAD_TET_C1_FEM<PHX::Device>());
+      lo = -tolerance * lo;
+      break;
+
+    case minitensor::ELEMENT::HEXAHEDRAL:
+      basis =
+          Teuchos::rcp(new Intrepid2::Basis_HGRAD_HEX_C1_FEM<PHX::Device>());
+      lo = -lo * (1.0 + tolerance);
+      break;
+  }
+
+  std::vector<double> const& coupled_coordinates = reference_coordinates_;
+
+  // We do this element by element
+  auto const number_cells = 1;
+
+  // We do this point by point
+  auto const number_points = 1;
+
+  // Container for the parametric coordinates
+  Kokkos::DynRankView<RealType, PHX::Device> parametric_point(
+      "par_point", number_cells, number_points, parametric_dimension);
+
+  // Container for the physical point
+  Kokkos::DynRankView<RealType, PHX::Device> physical_coordinates(
+      "phys_point", number_cells, number_points, coupled_dimension);
+
+  for (auto i = 0; i < coupled_dimension; ++i) {
+    physical_coordinates(0, 0, i) = coord[i];
+  }
+
+  // Container for the physical nodal coordinates
+  Kokkos::DynRankView<RealType, PHX::Device> nodal_coordinates(
+      "coords", number_cells, coupled_node_count, coupled_dimension);
+
+  std::vector<int> candidates;
+
+  grid_.query(coord, candidates);
+
+  // Candidates come in workset and element order, so the element found is
+  // the same one an exhaustive search would find first.
+  for (auto const candidate : candidates) {
+    auto const workset = box_elements_[candidate].first;
+
+    auto const element = box_elements_[candidate].second;
+
+    for (auto node = 0; node < coupled_node_count; ++node) {
+      auto const global_node_id = ws_elem_to_node_id[workset][element][node];
+
+      auto const local_node_id =
+          coupled_overlap_node_map->getLocalElement(global_node_id);
+
+      for (auto j = 0; j < coupled_dimension; ++j) {
+        nodal_coordinates(0, node, j) =
+            coupled_coordinates[3 * local_node_id + j];
+      }
+    }
+
+    // Get parametric coordinates
+    Intrepid2::CellTools<PHX::Device>::mapToReferenceFrame(
+        parametric_point,
+        physical_coordinates,
+        nodal_coordinates,
+        coupled_cell_topology);
+
+    bool in_element = true;
+
+    for (auto i = 0; i < parametric_dimension; ++i) {
+      auto const xi = parametric_point(0, 0, i);
+      in_element    = in_element && lo(i) <= xi && xi <= hi(i);
+    }
+
+    if (in_element == false) continue;
+
+    // Evaluate shape functions at parametric point.
+    Kokkos::DynRankView<RealType, PHX::Device> basis_values(
+        "basis", coupled_node_count, number_points);
+
+    // Another container for the parametric coordinates. Needed because above
+    // it is required that parametric_points has rank 3 for mapToReferenceFrame
+    // but here basis->getValues requires a rank 2 view :(
+    Kokkos::DynRankView<RealType, PHX::Device> pp_reduced(
+        "par_point", number_points, parametric_dimension);
+
+    for (auto j = 0; j < parametric_dimension; ++j) {
+      pp_reduced(0, j) = parametric_point(0, 0, j);
+    }
+
+    basis->getValues(basis_values, pp_reduced, Intrepid2::OPERATOR_VALUE);
+
+    location.workset = workset;
+    location.element = element;
+    location.basis_values.resize(coupled_node_count);
+
+    for (auto i = 0; i < coupled_node_count; ++i) {
+      location.basis_values[i] = basis_values(i, 0);
+    }
+    break;
+  }
+}
+
+}  // namespace LCM
@@ -0,0 +1,120 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#if !defined(LCM_SchwarzPointLocator_hpp)
+#define LCM_SchwarzPointLocator_hpp
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Albany_DataTypes.hpp"
+#include "BoundingBoxGrid.h"
+#include "Shards_CellTopologyData.h"
+
+namespace Albany {
+class STKDiscretization;
+}
+
+namespace LCM {
+
+///
+/// Locates the nodes of a node set of one application inside the elements
+/// of a coupled application for Schwarz boundary conditions.
+/// Candidate elements come from a bucket grid over the bounding boxes of the
+/// coupled elements. The element and shape function values found for each
+/// node only depend on the reference coordinates, so they are cached and
+/// reused across Schwarz iterations until either discretization changes.
+///
+class SchwarzPointLocator
+{
+ public:
+  struct Location
+  {
+    int workset{-1};
+
+    int element{-1};
+
+    // Coupled element shape functions evaluated at the node
+    std::vector<RealType> basis_values;
+  };
+
+  Location const&
+  locate(
+      Albany::STKDiscretization const& this_disc,
+      Albany::STKDiscretization const& coupled_disc,
+      std::string const&               nodeset_name,
+      std::string const&               coupled_block_name,
+      CellTopologyData const&          coupled_cell_topology_data,
+      size_t const                     ns_node);
+
+  /// Locate points given by their coordinates, three per point, in the
+  /// elements of the coupled discretization owned by this rank. Points
+  /// that are not found have a negative workset. Used when the node set
+  /// lives on other ranks, so it does not use or keep the node set cache.
+  std::vector<Location>
+  locatePoints(
+      Albany::STKDiscretization const& coupled_disc,
+      std::string const&               coupled_block_name,
+      CellTopologyData const&          coupled_cell_topology_data,
+      std::vector<double> const&       points);
+
+ private:
+  bool
+  isCurrent(
+      Albany::STKDiscretization const& this_disc,
+      Albany::STKDiscretization const& coupled_disc,
+      std::string const&               nodeset_name,
+      std::string const&               coupled_block_name) const;
+
+  void
+  build(
+      Albany::STKDiscretization const& this_disc,
+      Albany::STKDiscretization const& coupled_disc,
+      std::string const&               nodeset_name,
+      std::string const&               coupled_block_name,
+      CellTopologyData const&          coupled_cell_topology_data);
+
+  bool
+  updateReferenceCoordinates(Albany::STKDiscretization const& coupled_disc);
+
+  void
+  buildGrid(
+      Albany::STKDiscretization const& coupled_disc,
+      std::string const&               coupled_block_name,
+      CellTopologyData const&          coupled_cell_topology_data);
+
+  void
+  search(
+      Albany::STKDiscretization const& coupled_disc,
+      CellTopologyData const&          coupled_cell_topology_data,
+      double const* const              coord,
+      Location&                        location) const;
+
+  BoundingBoxGrid grid_;
+
+  // (workset, element) of each box in the grid
+  std::vector<std::pair<int, int>> box_elements_;
+
+  std::vector<Location> locations_;
+
+  // Discretization data the cache was built from
+  std::vector<double> reference_coordinates_;
+
+  void const* coupled_connectivity_{nullptr};
+
+  void const* nodeset_coordinates_{nullptr};
+
+  size_t nodeset_size_{0};
+
+  std::string nodeset_name_;
+
+  std::string coupled_block_name_;
+};
+
+}  // namespace LCM
+
+#endif  // LCM_SchwarzPointLocator_hpp
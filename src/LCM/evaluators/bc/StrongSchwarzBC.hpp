@@ -18,6 +18,7 @@
 
 #include "PHAL_AlbanyTraits.hpp"
 #include "Sacado_ParameterAccessor.hpp"
+#include "SchwarzPointLocator.hpp"
 //#include "PHAL_Dirichlet.hpp"
 #include "PHAL_SDirichlet.hpp"
 
@@ -148,6 +149,8 @@ class StrongSchwarzBC_Base : public PHAL::SDirichlet<EvalT, Traits>
   int this_app_index_{-1};
 
   int coupled_app_index_{-1};
+
+  SchwarzPointLocator point_locator_;
 };
 
 //
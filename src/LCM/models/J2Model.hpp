@@ -76,6 +76,33 @@ class J2Model : public LCM::ConstitutiveModel<EvalT, Traits>
   ///
   RealType sat_mod_, sat_exp_;
 
+  ///
+  /// Handles of the old Fp and eqps states
+  ///
+  Albany::StateHandle Fp_old_handle_, eqps_old_handle_;
+
+  ///
+  /// Number of integration points processed together by the batched kernel
+  ///
+  static constexpr int batch_size_ = 8;
+
+  ///
+  /// Use the batched kernel. computeStateParallel rejects it.
+  ///
+  bool batched_;
+
+  ///
+  /// Same as computeState, with the integration points packed in batches of
+  /// batch_size_ lanes stored as structures of arrays. The elastic predictor,
+  /// yield check and return mapping run over all lanes of a batch, and the
+  /// plastic correction is masked by the yield check.
+  ///
+  void
+  computeStateBatched(
+      typename Traits::EvalData workset,
+      DepFieldMap               dep_fields,
+      FieldMap                  eval_fields);
+
   // Kokkos
   virtual void
   computeStateParallel(
@@ -5,6 +5,7 @@
 //*****************************************************************//
 
 #include <MiniTensor.h>
+#include <array>
 #include "Phalanx_DataLayout.hpp"
 #include "Teuchos_TestForException.hpp"
 
@@ -19,8 +20,14 @@ J2Model<EvalT, Traits>::J2Model(
     const Teuchos::RCP<Albany::Layouts>& dl)
     : LCM::ConstitutiveModel<EvalT, Traits>(p, dl),
       sat_mod_(p->get<RealType>("Saturation Modulus", 0.0)),
-      sat_exp_(p->get<RealType>("Saturation Exponent", 0.0))
+      sat_exp_(p->get<RealType>("Saturation Exponent", 0.0)),
+      batched_(p->get<bool>("Batched Return Mapping", false))
 {
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      batched_ && num_dims_ != 2 && num_dims_ != 3,
+      std::logic_error,
+      "Error! The batched J2 return mapping requires 2 or 3 dimensions.\n");
+
   // retrive appropriate field name strings
   std::string cauchy_string       = (*field_name_map_)["Cauchy_Stress"];
   std::string Fp_string           = (*field_name_map_)["Fp"];
@@ -70,6 +77,7 @@ J2Model<EvalT, Traits>::J2Model(
   this->state_var_init_values_.push_back(0.0);
   this->state_var_old_state_flags_.push_back(true);
   this->state_var_output_flags_.push_back(p->get<bool>("Output Fp", false));
+  Fp_old_handle_ = Albany::getStateHandle(Fp_string + "_old");
   //
   // eqps
   this->num_state_variables_++;
@@ -79,6 +87,7 @@ J2Model<EvalT, Traits>::J2Model(
   this->state_var_init_values_.push_back(0.0);
   this->state_var_old_state_flags_.push_back(true);
   this->state_var_output_flags_.push_back(p->get<bool>("Output eqps", false));
+  eqps_old_handle_ = Albany::getStateHandle(eqps_string + "_old");
   //
   // yield surface
   this->num_state_variables_++;
@@ -110,6 +119,11 @@ J2Model<EvalT, Traits>::computeState(
     DepFieldMap               dep_fields,
     FieldMap                  eval_fields)
 {
+  if (batched_) {
+    computeStateBatched(workset, dep_fields, eval_fields);
+    return;
+  }
+
   std::string cauchy_string       = (*field_name_map_)["Cauchy_Stress"];
   std::string Fp_string           = (*field_name_map_)["Fp"];
   std::string eqps_string         = (*field_name_map_)["eqps"];
@@ -136,8 +150,8 @@ J2Model<EvalT, Traits>::computeState(
   if (have_temperature_) { source = *eval_fields[source_string]; }
 
   // get State Variables
-  Albany::MDArray Fpold   = (*workset.stateArrayPtr)[Fp_string + "_old"];
-  Albany::MDArray eqpsold = (*workset.stateArrayPtr)[eqps_string + "_old"];
+  Albany::MDArray Fpold   = *workset.stateTablePtr->get(Fp_old_handle_);
+  Albany::MDArray eqpsold = *workset.stateTablePtr->get(eqps_old_handle_);
 
   //#if !defined(ALBANY_KOKKOS_UNDER_DEVELOPMENT) ||
   // defined(PHX_KOKKOS_DEVICE_TYPE_CUDA)
@@ -308,6 +322,352 @@ J2Model<EvalT, Traits>::computeState(
   }
 }
 //------------------------------------------------------------------------------
+// Batched version of computeState. The integration points of the workset,
+// numbered q = cell * num_pts_ + pt, are processed batch_size_ at a time.
+// Every tensor component is stored as an array over the lanes of the batch,
+// so the innermost loops run over lanes and can be vectorized for the
+// Residual evaluation type. The return mapping is masked by the yield check,
+// and only the exponential map of plastic lanes is computed one by one.
+template <typename EvalT, typename Traits>
+void
+J2Model<EvalT, Traits>::computeStateBatched(
+    typename Traits::EvalData workset,
+    DepFieldMap               dep_fields,
+    FieldMap                  eval_fields)
+{
+  std::string cauchy_string       = (*field_name_map_)["Cauchy_Stress"];
+  std::string Fp_string           = (*field_name_map_)["Fp"];
+  std::string eqps_string         = (*field_name_map_)["eqps"];
+  std::string yieldSurface_string = (*field_name_map_)["Yield_Surface"];
+  std::string source_string       = (*field_name_map_)["Mechanical_Source"];
+  std::string F_string            = (*field_name_map_)["F"];
+  std::string J_string            = (*field_name_map_)["J"];
+
+  // extract dependent MDFields
+  auto def_grad          = *dep_fields[F_string];
+  auto J                 = *dep_fields[J_string];
+  auto poissons_ratio    = *dep_fields["Poissons Ratio"];
+  auto elastic_modulus   = *dep_fields["Elastic Modulus"];
+  auto yield_strength    = *dep_fields["Yield Strength"];
+  auto hardening_modulus = *dep_fields["Hardening Modulus"];
+  auto delta_time        = *dep_fields["Delta Time"];
+
+  // extract evaluated MDFields
+  auto                  stress    = *eval_fields[cauchy_string];
+  auto                  Fp        = *eval_fields[Fp_string];
+  auto                  eqps      = *eval_fields[eqps_string];
+  auto                  yieldSurf = *eval_fields[yieldSurface_string];
+  PHX::MDField<ScalarT> source;
+  if (have_temperature_) { source = *eval_fields[source_string]; }
+
+  // get State Variables
+  Albany::MDArray Fpold   = *workset.stateTablePtr->get(Fp_old_handle_);
+  Albany::MDArray eqpsold = *workset.stateTablePtr->get(eqps_old_handle_);
+
+  int const B   = batch_size_;
+  int const dim = num_dims_;
+  int const nc  = dim * dim;
+
+  typedef std::array<ScalarT, batch_size_> Lanes;
+  typedef std::array<Lanes, 9>             TensorLanes;
+
+  ScalarT const sq23(std::sqrt(2. / 3.));
+
+  TensorLanes Fm, Fpn, Fpinv, Cpinv, FmCpinv, be, s;
+  Lanes       kappa, mu, mubar, K, Y, Jq, eqps_n, smag, f, dgam, H, alpha;
+  std::array<int, batch_size_>    cells, pts;
+  std::array<bool, batch_size_>   plastic;
+  std::array<double, batch_size_> x, g, dg, f_val;
+
+  minitensor::Tensor<ScalarT> A(dim), expA(dim), Fpn_l(dim), Fpnew(dim);
+
+  int const num_qps = workset.numCells * num_pts_;
+
+  for (int first(0); first < num_qps; first += B) {
+    int const width = num_qps - first < B ? num_qps - first : B;
+
+    // pack the batch
+    for (int l(0); l < width; ++l) {
+      int const cell = (first + l) / num_pts_;
+      int const pt   = (first + l) % num_pts_;
+      cells[l]       = cell;
+      pts[l]         = pt;
+
+      kappa[l] = elastic_modulus(cell, pt) /
+                 (3. * (1. - 2. * poissons_ratio(cell, pt)));
+      mu[l] = elastic_modulus(cell, pt) / (2. * (1. + poissons_ratio(cell, pt)));
+      K[l]  = hardening_modulus(cell, pt);
+      Y[l]  = yield_strength(cell, pt);
+      Jq[l] = J(cell, pt);
+      eqps_n[l] = eqpsold(cell, pt);
+
+      // mechanical deformation gradient, see computeState
+      ScalarT thermal_stretch(1.0);
+      if (have_temperature_) {
+        ScalarT dtemp   = temperature_(cell, pt) - ref_temperature_;
+        thermal_stretch = std::exp(expansion_coeff_ * dtemp);
+      }
+      for (int i(0); i < dim; ++i) {
+        for (int j(0); j < dim; ++j) {
+          Fm[i * dim + j][l]  = def_grad(cell, pt, i, j) / thermal_stretch;
+          Fpn[i * dim + j][l] = ScalarT(Fpold(cell, pt, i, j));
+        }
+      }
+    }
+    // pad the last batch with copies of its first lane
+    for (int l(width); l < B; ++l) {
+      kappa[l]  = kappa[0];
+      mu[l]     = mu[0];
+      K[l]      = K[0];
+      Y[l]      = Y[0];
+      Jq[l]     = Jq[0];
+      eqps_n[l] = eqps_n[0];
+      for (int c(0); c < nc; ++c) {
+        Fm[c][l]  = Fm[c][0];
+        Fpn[c][l] = Fpn[c][0];
+      }
+    }
+
+    // compute trial state
+    if (dim == 3) {
+      Lanes det;
+      for (int l(0); l < B; ++l) {
+        Fpinv[0][l] = Fpn[4][l] * Fpn[8][l] - Fpn[5][l] * Fpn[7][l];
+        Fpinv[1][l] = Fpn[2][l] * Fpn[7][l] - Fpn[1][l] * Fpn[8][l];
+        Fpinv[2][l] = Fpn[1][l] * Fpn[5][l] - Fpn[2][l] * Fpn[4][l];
+        Fpinv[3][l] = Fpn[5][l] * Fpn[6][l] - Fpn[3][l] * Fpn[8][l];
+        Fpinv[4][l] = Fpn[0][l] * Fpn[8][l] - Fpn[2][l] * Fpn[6][l];
+        Fpinv[5][l] = Fpn[2][l] * Fpn[3][l] - Fpn[0][l] * Fpn[5][l];
+        Fpinv[6][l] = Fpn[3][l] * Fpn[7][l] - Fpn[4][l] * Fpn[6][l];
+        Fpinv[7][l] = Fpn[1][l] * Fpn[6][l] - Fpn[0][l] * Fpn[7][l];
+        Fpinv[8][l] = Fpn[0][l] * Fpn[4][l] - Fpn[1][l] * Fpn[3][l];
+        det[l]      = Fpn[0][l] * Fpinv[0][l] + Fpn[1][l] * Fpinv[3][l] +
+                 Fpn[2][l] * Fpinv[6][l];
+      }
+      for (int c(0); c < nc; ++c) {
+        for (int l(0); l < B; ++l) { Fpinv[c][l] /= det[l]; }
+      }
+    } else {
+      for (int l(0); l < B; ++l) {
+        ScalarT const det = Fpn[0][l] * Fpn[3][l] - Fpn[1][l] * Fpn[2][l];
+        Fpinv[0][l]       = Fpn[3][l] / det;
+        Fpinv[1][l]       = -Fpn[1][l] / det;
+        Fpinv[2][l]       = -Fpn[2][l] / det;
+        Fpinv[3][l]       = Fpn[0][l] / det;
+      }
+    }
+
+    // Cpinv = Fpinv Fpinv^T
+    for (int i(0); i < dim; ++i) {
+      for (int j(0); j < dim; ++j) {
+        Lanes& c = Cpinv[i * dim + j];
+        for (int l(0); l < B; ++l) { c[l] = 0.0; }
+        for (int k(0); k < dim; ++k) {
+          Lanes const& a = Fpinv[i * dim + k];
+          Lanes const& b = Fpinv[j * dim + k];
+          for (int l(0); l < B; ++l) { c[l] += a[l] * b[l]; }
+        }
+      }
+    }
+
+    // be = J^(-2/3) Fm Cpinv Fm^T
+    for (int i(0); i < dim; ++i) {
+      for (int j(0); j < dim; ++j) {
+        Lanes& c = FmCpinv[i * dim + j];
+        for (int l(0); l < B; ++l) { c[l] = 0.0; }
+        for (int k(0); k < dim; ++k) {
+          Lanes const& a = Fm[i * dim + k];
+          Lanes const& b = Cpinv[k * dim + j];
+          for (int l(0); l < B; ++l) { c[l] += a[l] * b[l]; }
+        }
+      }
+    }
+    for (int i(0); i < dim; ++i) {
+      for (int j(0); j < dim; ++j) {
+        Lanes& c = be[i * dim + j];
+        for (int l(0); l < B; ++l) { c[l] = 0.0; }
+        for (int k(0); k < dim; ++k) {
+          Lanes const& a = FmCpinv[i * dim + k];
+          Lanes const& b = Fm[j * dim + k];
+          for (int l(0); l < B; ++l) { c[l] += a[l] * b[l]; }
+        }
+      }
+    }
+    for (int l(0); l < B; ++l) {
+      ScalarT const Jm23 = std::pow(Jq[l], -2. / 3.);
+      for (int c(0); c < nc; ++c) { be[c][l] *= Jm23; }
+    }
+
+    // s = mu dev(be), mubar = tr(be) mu / dim
+    for (int l(0); l < B; ++l) {
+      ScalarT trace(0.0);
+      for (int i(0); i < dim; ++i) { trace += be[i * dim + i][l]; }
+      mubar[l] = trace * mu[l] / dim;
+      for (int c(0); c < nc; ++c) { s[c][l] = mu[l] * be[c][l]; }
+      for (int i(0); i < dim; ++i) { s[i * dim + i][l] -= mubar[l]; }
+    }
+
+    // check yield condition
+    for (int l(0); l < B; ++l) {
+      ScalarT smag2(0.0);
+      for (int c(0); c < nc; ++c) { smag2 += s[c][l] * s[c][l]; }
+      smag[l] = smag2 > 0.0 ? ScalarT(std::sqrt(smag2)) : ScalarT(0.0);
+      f[l]    = smag[l] -
+             sq23 * (Y[l] + K[l] * eqps_n[l] +
+                     sat_mod_ * (1. - std::exp(-sat_exp_ * eqps_n[l])));
+      f_val[l]   = Sacado::ScalarValue<ScalarT>::eval(f[l]);
+      plastic[l] = l < width && f_val[l] > 1E-12;
+    }
+
+    // return mapping algorithm, on the values of all plastic lanes at once
+    bool any_plastic = false;
+    for (int l(0); l < B; ++l) { any_plastic = any_plastic || plastic[l]; }
+
+    if (any_plastic) {
+      int const                     num_max_iter = 30;
+      std::array<bool, batch_size_> converged;
+      for (int l(0); l < B; ++l) {
+        converged[l] = !plastic[l];
+        x[l]         = 0.0;
+        g[l]         = f_val[l];
+        dg[l]        = -2. * Sacado::ScalarValue<ScalarT>::eval(mubar[l]);
+      }
+
+      int count = 0;
+      while (true) {
+        bool done = true;
+        for (int l(0); l < B; ++l) { done = done && converged[l]; }
+        if (done) break;
+
+        count++;
+        // Newton step on every lane, masked so that the converged lanes,
+        // elastic ones included, keep their x, g and dg
+        for (int l(0); l < B; ++l) {
+          double const m       = converged[l] ? 0.0 : 1.0;
+          double const mubar_l = Sacado::ScalarValue<ScalarT>::eval(mubar[l]);
+          double const K_l     = Sacado::ScalarValue<ScalarT>::eval(K[l]);
+          double const Y_l     = Sacado::ScalarValue<ScalarT>::eval(Y[l]);
+          x[l] -= m * g[l] / dg[l];
+          double const a =
+              Sacado::ScalarValue<ScalarT>::eval(eqps_n[l]) +
+              std::sqrt(2. / 3.) * x[l];
+          double const H_l  = K_l * a + sat_mod_ * (1. - std::exp(-sat_exp_ * a));
+          double const dH_l = K_l + sat_exp_ * sat_mod_ * std::exp(-sat_exp_ * a);
+          double const g_l  = Sacado::ScalarValue<ScalarT>::eval(smag[l]) -
+                             (2. * mubar_l * x[l] + std::sqrt(2. / 3.) * (Y_l + H_l));
+          double const dg_l = -2. * mubar_l * (1. + dH_l / (3. * mubar_l));
+          g[l]  = m * g_l + (1. - m) * g[l];
+          dg[l] = m * dg_l + (1. - m) * dg[l];
+
+          double const res = std::abs(g[l]);
+          converged[l] = converged[l] || res < 1.e-11 || res / Y_l < 1.E-11 ||
+                         res / f_val[l] < 1.E-11;
+        }
+
+        if (count < num_max_iter) continue;
+        for (int l(0); l < B; ++l) {
+          double const res = std::abs(g[l]);
+          TEUCHOS_TEST_FOR_EXCEPTION(
+              !converged[l],
+              std::runtime_error,
+              std::endl
+                  << "Error in return mapping, count = " << count
+                  << "\nres = " << res << "\nrelres  = " << res / f_val[l]
+                  << "\nrelres2 = "
+                  << res / Sacado::ScalarValue<ScalarT>::eval(Y[l])
+                  << "\ng = " << g[l] << "\ndg = " << dg[l] << "\nalpha = "
+                  << Sacado::ScalarValue<ScalarT>::eval(eqps_n[l]) +
+                         std::sqrt(2. / 3.) * x[l]
+                  << std::endl);
+        }
+      }
+    }
+
+    // Derivatives of the solution, as LocalNonlinearSolver::computeFadInfo
+    // gives them to the scalar kernel: dgam has the converged value and the
+    // derivatives -dg/dp / (dg/dx). As there, alpha, and so eqps and the
+    // hardening H, are evaluated at the converged value only.
+    for (int l(0); l < B; ++l) {
+      if (!plastic[l]) {
+        dgam[l]  = 0.0;
+        H[l]     = 0.0;
+        alpha[l] = eqps_n[l];
+        continue;
+      }
+      alpha[l] = eqps_n[l] + sq23 * x[l];
+      H[l]     = K[l] * alpha[l] +
+             sat_mod_ * (1. - std::exp(-sat_exp_ * alpha[l]));
+      ScalarT const gx =
+          smag[l] - (2. * mubar[l] * x[l] + sq23 * (Y[l] + H[l]));
+      dgam[l] =
+          x[l] - (gx - Sacado::ScalarValue<ScalarT>::eval(gx)) / dg[l];
+    }
+
+    // unpack the batch
+    for (int l(0); l < width; ++l) {
+      int const cell = cells[l];
+      int const pt   = pts[l];
+
+      // exponential map to get Fpnew, with the trial deviatoric stress.
+      // Masked: the elastic lanes have a zero exponent, so they keep Fpn.
+      ScalarT const factor =
+          plastic[l] ? ScalarT(dgam[l] / smag[l]) : ScalarT(0.0);
+      if (any_plastic) {
+        for (int i(0); i < dim; ++i) {
+          for (int j(0); j < dim; ++j) {
+            A(i, j)     = factor * s[i * dim + j][l];
+            Fpn_l(i, j) = Fpn[i * dim + j][l];
+          }
+        }
+        expA  = minitensor::exp(A);
+        Fpnew = expA * Fpn_l;
+        for (int i(0); i < dim; ++i) {
+          for (int j(0); j < dim; ++j) { Fp(cell, pt, i, j) = Fpnew(i, j); }
+        }
+      } else {
+        for (int i(0); i < dim; ++i) {
+          for (int j(0); j < dim; ++j) {
+            Fp(cell, pt, i, j) = Fpn[i * dim + j][l];
+          }
+        }
+      }
+
+      // update s
+      ScalarT const scale = 1. - 2. * mubar[l] * factor;
+      for (int c(0); c < nc; ++c) { s[c][l] *= scale; }
+
+      // update eqps, which alpha leaves unchanged on the elastic lanes
+      eqps(cell, pt) = alpha[l];
+
+      // mechanical source, zero on the elastic lanes where dgam is
+      if (have_temperature_) {
+        if (delta_time(0) > 0) {
+          source(cell, pt) =
+              (sq23 * dgam[l] / delta_time(0) *
+               (Y[l] + H[l] + temperature_(cell, pt))) /
+              (density_ * heat_capacity_);
+        } else if (!plastic[l]) {
+          source(cell, pt) = 0.0;
+        }
+      }
+
+      // update yield surface
+      yieldSurf(cell, pt) =
+          Y[l] + K[l] * eqps(cell, pt) +
+          sat_mod_ * (1. - std::exp(-sat_exp_ * eqps(cell, pt)));
+
+      // compute pressure and stress
+      ScalarT const p = 0.5 * kappa[l] * (Jq[l] - 1. / Jq[l]);
+      for (int i(0); i < dim; ++i) {
+        for (int j(0); j < dim; ++j) {
+          stress(cell, pt, i, j) = s[i * dim + j][l] / Jq[l];
+        }
+        stress(cell, pt, i, i) += p;
+      }
+    }
+  }
+}
+//------------------------------------------------------------------------------
 // computeState parallel function, which calls Kokkos::parallel_for
 template <typename EvalT, typename Traits>
 void
@@ -316,6 +676,11 @@ J2Model<EvalT, Traits>::computeStateParallel(
     DepFieldMap               dep_fields,
     FieldMap                  eval_fields)
 {
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      batched_,
+      std::logic_error,
+      "Error! Batched Return Mapping is not available in "
+      "J2Model::computeStateParallel.\n");
   return;
 }
 //-------------------------------------------------------------------------------
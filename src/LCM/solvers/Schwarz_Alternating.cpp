@@ -10,11 +10,76 @@
 #include "MiniTensor.h"
 #include "Piro_LOCASolver.hpp"
 #include "Piro_TempusSolver.hpp"
+#include "Teuchos_CommHelpers.hpp"
 
 //#define DEBUG
 
 namespace LCM {
 
+namespace {
+
+//
+// Split the ranks into contiguous groups, one per subdomain, with sizes
+// proportional to the weights of the subdomains and at least one rank
+// each.
+//
+std::vector<int>
+subdomainRankCounts(int const number_ranks, Teuchos::Array<ST> const& weights)
+{
+  auto const number_subdomains = static_cast<int>(weights.size());
+
+  ALBANY_ASSERT(number_ranks >= number_subdomains);
+
+  ST total_weight{0.0};
+
+  for (auto const weight : weights) {
+    ALBANY_ASSERT(weight > 0.0, "Subdomain Weights must be positive");
+    total_weight += weight;
+  }
+
+  std::vector<ST> shares(number_subdomains, 0.0);
+
+  std::vector<int> counts(number_subdomains, 0);
+
+  int assigned{0};
+
+  for (auto subdomain = 0; subdomain < number_subdomains; ++subdomain) {
+    shares[subdomain] = number_ranks * weights[subdomain] / total_weight;
+    counts[subdomain] = std::max(1, static_cast<int>(shares[subdomain]));
+    assigned += counts[subdomain];
+  }
+
+  // Give the ranks left over to the subdomains furthest below their share,
+  // and take the ranks in excess from those furthest above it.
+  while (assigned < number_ranks) {
+    int best{0};
+    for (auto subdomain = 1; subdomain < number_subdomains; ++subdomain) {
+      if (shares[subdomain] - counts[subdomain] > shares[best] - counts[best]) {
+        best = subdomain;
+      }
+    }
+    ++counts[best];
+    ++assigned;
+  }
+
+  while (assigned > number_ranks) {
+    int best{-1};
+    for (auto subdomain = 0; subdomain < number_subdomains; ++subdomain) {
+      if (counts[subdomain] == 1) continue;
+      if (best == -1 ||
+          counts[subdomain] - shares[subdomain] > counts[best] - shares[best]) {
+        best = subdomain;
+      }
+    }
+    --counts[best];
+    --assigned;
+  }
+
+  return counts;
+}
+
+}  // anonymous namespace
+
 //
 //
 //
@@ -90,6 +155,20 @@ SchwarzAlternating::SchwarzAlternating(
     ALBANY_ASSERT(false, "Unknown Convergence Logical Operator");
   }
 
+  std::string variant_str =
+      alt_system_params.get<std::string>("Schwarz Variant", "MULTIPLICATIVE");
+
+  std::transform(
+      variant_str.begin(), variant_str.end(), variant_str.begin(), ::toupper);
+
+  if (variant_str == "MULTIPLICATIVE") {
+    variant_ = SchwarzVariant::MULTIPLICATIVE;
+  } else if (variant_str == "ADDITIVE") {
+    variant_ = SchwarzVariant::ADDITIVE;
+  } else {
+    ALBANY_ASSERT(false, "Unknown Schwarz Variant");
+  }
+
   // Firewalls
   ALBANY_ASSERT(min_iters_ >= 1);
   ALBANY_ASSERT(max_iters_ >= 1);
@@ -110,6 +189,43 @@ SchwarzAlternating::SchwarzAlternating(
   // number of models
   num_subdomains_ = model_filenames.size();
 
+  comm_ = comm;
+
+  // Additive Schwarz with enough ranks: split them among the subdomains.
+  // Each rank creates and solves only the subdomain of its group.
+  bool const concurrent = variant_ == SchwarzVariant::ADDITIVE &&
+                          comm->getSize() >= num_subdomains_;
+
+  Teuchos::RCP<Teuchos::Comm<int> const> subdomain_comm = comm;
+
+  int local_subdomain{-1};
+
+  if (concurrent == true) {
+    Teuchos::Array<ST> const weights =
+        alt_system_params.get<Teuchos::Array<ST>>(
+            "Subdomain Weights", Teuchos::Array<ST>(num_subdomains_, 1.0));
+
+    ALBANY_ASSERT(
+        weights.size() == num_subdomains_,
+        "Subdomain Weights must have one entry per subdomain");
+
+    subdomain_ranks_ = subdomainRankCounts(comm->getSize(), weights);
+
+    int const rank = comm->getRank();
+
+    int first_rank{0};
+
+    for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+      int const last_rank = first_rank + subdomain_ranks_[subdomain];
+
+      if (first_rank <= rank && rank < last_rank) local_subdomain = subdomain;
+
+      first_rank = last_rank;
+    }
+
+    subdomain_comm = comm->split(local_subdomain, comm->getRank());
+  }
+
   // Create application name-index map used for Schwarz BC.
   Teuchos::RCP<std::map<std::string, int>> app_name_index_map =
       Teuchos::rcp(new std::map<std::string, int>);
@@ -153,8 +269,11 @@ SchwarzAlternating::SchwarzAlternating(
 
   // Initialization
   for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    if (concurrent == true && subdomain != local_subdomain) continue;
+
     // Get parameters for each subdomain
-    Albany::SolverFactory solver_factory(model_filenames[subdomain], comm);
+    Albany::SolverFactory solver_factory(
+        model_filenames[subdomain], subdomain_comm);
 
     solver_factory.setSchwarz(true);
 
@@ -179,7 +298,8 @@ SchwarzAlternating::SchwarzAlternating(
     std::string const msg{
         "All subdomains must have the same solution method (NOX or Tempus)"};
 
-    if (subdomain == 0) {
+    // First subdomain on this rank
+    if (is_static == false && is_dynamic == false) {
       is_dynamic  = piro_params.isSublist("Tempus");
       is_static   = !is_dynamic;
       is_static_  = is_static;
@@ -216,7 +336,8 @@ SchwarzAlternating::SchwarzAlternating(
     Teuchos::RCP<Albany::Application> app{Teuchos::null};
 
     Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST>> solver =
-        solver_factory.createAndGetAlbanyAppT(app, comm, comm);
+        solver_factory.createAndGetAlbanyAppT(
+            app, subdomain_comm, subdomain_comm);
 
     solvers_[subdomain] = solver;
 
@@ -246,6 +367,23 @@ SchwarzAlternating::SchwarzAlternating(
     curr_disp_[subdomain] = Teuchos::null;
   }
 
+  // The subdomains on other ranks must use the same solution method.
+  int const local_dynamic = is_dynamic_ == true ? 1 : 0;
+
+  int min_dynamic{0};
+
+  int max_dynamic{0};
+
+  Teuchos::reduceAll<int, int>(
+      *comm, Teuchos::REDUCE_MIN, local_dynamic, Teuchos::ptr(&min_dynamic));
+
+  Teuchos::reduceAll<int, int>(
+      *comm, Teuchos::REDUCE_MAX, local_dynamic, Teuchos::ptr(&max_dynamic));
+
+  ALBANY_ASSERT(
+      min_dynamic == max_dynamic,
+      "All subdomains must have the same solution method (NOX or Tempus)");
+
   //
   // Parameters
   //
@@ -427,6 +565,63 @@ SchwarzAlternating::get_failed() const
   return failed_;
 }
 
+//
+//
+//
+bool
+SchwarzAlternating::isLocal(int const subdomain) const
+{
+  return apps_[subdomain] != Teuchos::null;
+}
+
+//
+//
+//
+void
+SchwarzAlternating::reduceSubdomainResults(
+    minitensor::Vector<ST>& norms_init,
+    minitensor::Vector<ST>& norms_final,
+    minitensor::Vector<ST>& norms_diff) const
+{
+  if (subdomain_ranks_.empty() == true) return;
+
+  int const local_failed = failed_ == true ? 1 : 0;
+
+  int global_failed{0};
+
+  Teuchos::reduceAll<int, int>(
+      *comm_, Teuchos::REDUCE_MAX, local_failed, Teuchos::ptr(&global_failed));
+
+  failed_ = global_failed == 1;
+
+  // Norms are nonnegative. Those of the subdomains on other ranks are
+  // zeroed, as they still hold the values of the previous iteration.
+  std::vector<ST> local_norms(3 * num_subdomains_, 0.0);
+
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    if (isLocal(subdomain) == false) continue;
+
+    local_norms[3 * subdomain + 0] = norms_init(subdomain);
+    local_norms[3 * subdomain + 1] = norms_final(subdomain);
+    local_norms[3 * subdomain + 2] = norms_diff(subdomain);
+  }
+
+  std::vector<ST> global_norms(3 * num_subdomains_, 0.0);
+
+  Teuchos::reduceAll<int, ST>(
+      *comm_,
+      Teuchos::REDUCE_MAX,
+      3 * num_subdomains_,
+      local_norms.data(),
+      global_norms.data());
+
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    norms_init(subdomain)  = global_norms[3 * subdomain + 0];
+    norms_final(subdomain) = global_norms[3 * subdomain + 1];
+    norms_diff(subdomain)  = global_norms[3 * subdomain + 2];
+  }
+}
+
 //
 // Create operator form of dg/dx for distributed responses
 //
@@ -781,6 +976,10 @@ SchwarzAlternating::SchwarzLoopDynamics() const
   fos << delim << std::endl;
   fos << "Schwarz Alternating Method with " << num_subdomains_;
   fos << " subdomains\n";
+  for (auto subdomain = 0; subdomain < subdomain_ranks_.size(); ++subdomain) {
+    fos << "Subdomain " << subdomain << " solved concurrently on ";
+    fos << subdomain_ranks_[subdomain] << " rank(s)\n";
+  }
   fos << std::scientific << std::setprecision(17);
 
   ST time_step{initial_time_step_};
@@ -802,6 +1001,8 @@ SchwarzAlternating::SchwarzLoopDynamics() const
 
     // Before the Schwarz loop, get internal states
     for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+      if (isLocal(subdomain) == false) continue;
+
       auto& app = *apps_[subdomain];
 
       auto& state_mgr = app.getStateMgr();
@@ -819,6 +1020,10 @@ SchwarzAlternating::SchwarzLoopDynamics() const
 #endif
     }
 
+    if (variant_ == SchwarzVariant::ADDITIVE) {
+      transfer_.setup(*comm_, apps_);
+    }
+
     ST const next_time{current_time + time_step};
 
     num_iter_ = 0;
@@ -827,13 +1032,10 @@ SchwarzAlternating::SchwarzLoopDynamics() const
     do {
       bool const is_initial_state = stop == 0 && num_iter_ == 0;
 
+      // Restore solution from previous Schwarz iteration before solve
       for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
-        fos << delim << std::endl;
-        fos << "Schwarz iteration  :" << num_iter_ << '\n';
-        fos << "Subdomain          :" << subdomain << '\n';
-        fos << delim << std::endl;
+        if (isLocal(subdomain) == false) continue;
 
-        // Restore solution from previous Schwarz iteration before solve
         if (is_initial_state == true) {
           auto& me = dynamic_cast<Albany::ModelEvaluatorT&>(
               *model_evaluators_[subdomain]);
@@ -852,6 +1054,24 @@ SchwarzAlternating::SchwarzLoopDynamics() const
           Thyra::put_scalar(0.0, prev_acce_[subdomain].ptr());
           Thyra::copy(*this_acce_[subdomain], prev_acce_[subdomain].ptr());
         }
+      }
+
+      // Additive Schwarz: all subdomains solve with the boundary values
+      // of the previous Schwarz iteration.
+      if (variant_ == SchwarzVariant::ADDITIVE) {
+        transfer_.exchange(
+            *comm_,
+            apps_,
+            SchwarzTransfer::Solutions(prev_disp_.begin(), prev_disp_.end()));
+      }
+
+      for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+        if (isLocal(subdomain) == false) continue;
+
+        fos << delim << std::endl;
+        fos << "Schwarz iteration  :" << num_iter_ << '\n';
+        fos << "Subdomain          :" << subdomain << '\n';
+        fos << delim << std::endl;
 
         // Solve for each subdomain
         Thyra::ResponseOnlyModelEvaluatorBase<ST>& solver =
@@ -1057,6 +1277,8 @@ SchwarzAlternating::SchwarzLoopDynamics() const
 
       }  // Subdomains loop
 
+      reduceSubdomainResults(norms_init, norms_final, norms_diff);
+
       if (failed_ == true) {
         fos << "INFO: Unable to continue Schwarz iteration " << num_iter_;
         fos << "\n";
@@ -1137,6 +1359,8 @@ SchwarzAlternating::SchwarzLoopDynamics() const
 
       // Restore previous solutions
       for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+        if (isLocal(subdomain) == false) continue;
+
         Thyra::put_scalar(0.0, this_disp_[subdomain].ptr());
         Thyra::copy(*ics_disp_[subdomain], this_disp_[subdomain].ptr());
         Thyra::put_scalar(0.0, this_velo_[subdomain].ptr());
@@ -1219,6 +1443,8 @@ SchwarzAlternating::setExplicitUpdateInitialGuessForSchwarz(
   // do an explicit update to form the initial guess for the schwarz
   // iteration
   for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    if (isLocal(subdomain) == false) continue;
+
     auto& app = *apps_[subdomain];
 
     auto&                  state_mgr = app.getStateMgr();
@@ -1281,6 +1507,8 @@ SchwarzAlternating::setDynamicICVecsAndDoOutput(ST const time) const
   if (time == initial_time_) is_initial_time = true;
 
   for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    if (isLocal(subdomain) == false) continue;
+
     Albany::AbstractSTKMeshStruct& stk_mesh_struct =
         *stk_mesh_structs_[subdomain];
 
@@ -1345,6 +1573,8 @@ void
 SchwarzAlternating::doQuasistaticOutput(ST const time) const
 {
   for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    if (isLocal(subdomain) == false) continue;
+
     if (do_outputs_[subdomain] == true) {
       auto& stk_mesh_struct = *stk_mesh_structs_[subdomain];
 
@@ -1387,6 +1617,10 @@ SchwarzAlternating::SchwarzLoopQuasistatics() const
   fos << delim << std::endl;
   fos << "Schwarz Alternating Method with " << num_subdomains_;
   fos << " subdomains\n";
+  for (auto subdomain = 0; subdomain < subdomain_ranks_.size(); ++subdomain) {
+    fos << "Subdomain " << subdomain << " solved concurrently on ";
+    fos << subdomain_ranks_[subdomain] << " rank(s)\n";
+  }
   fos << std::scientific << std::setprecision(17);
 
   ST time_step{initial_time_step_};
@@ -1423,6 +1657,8 @@ SchwarzAlternating::SchwarzLoopQuasistatics() const
     // the solve fails. Then the load step is reduced and the Schwarz
     // loop is restarted from scratch.
     for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+      if (isLocal(subdomain) == false) continue;
+
       // Set these initial values explicitly to zero so that no
       // extra logic is necessary for initial values in the
       // Schwarz and subdomain loops.
@@ -1449,12 +1685,24 @@ SchwarzAlternating::SchwarzLoopQuasistatics() const
       toFrom(internal_states_[subdomain], state_mgr.getStateArrays());
     }
 
+    if (variant_ == SchwarzVariant::ADDITIVE) {
+      transfer_.setup(*comm_, apps_);
+    }
+
     num_iter_ = 0;
 
     // Schwarz loop
     do {
+      // Additive Schwarz: all subdomains solve with the boundary values
+      // of the previous Schwarz iteration.
+      if (variant_ == SchwarzVariant::ADDITIVE) {
+        transfer_.exchange(*comm_, apps_, curr_disp_);
+      }
+
       // Subdomain loop
       for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+        if (isLocal(subdomain) == false) continue;
+
         fos << delim << std::endl;
         fos << "Schwarz iteration  :" << num_iter_ << '\n';
         fos << "Subdomain          :" << subdomain << '\n';
@@ -1538,6 +1786,8 @@ SchwarzAlternating::SchwarzLoopQuasistatics() const
 
       }  // Subdomain loop
 
+      reduceSubdomainResults(norms_init, norms_final, norms_diff);
+
       if (failed_ == true) {
         fos << "INFO: Unable to continue Schwarz iteration " << num_iter_;
         fos << "\n";
@@ -1618,6 +1868,8 @@ SchwarzAlternating::SchwarzLoopQuasistatics() const
 
       // Restore previous solutions
       for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+        if (isLocal(subdomain) == false) continue;
+
         curr_disp_[subdomain] = prev_step_disp_[subdomain];
 
         // restore the state manager with the state variables from the previous
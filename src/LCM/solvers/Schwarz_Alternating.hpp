@@ -14,7 +14,9 @@
 #include "Albany_DataTypes.hpp"
 #include "Albany_MaterialDatabase.hpp"
 #include "Albany_ModelEvaluatorT.hpp"
+#include "MiniTensor.h"
 #include "Piro_NOXSolver.hpp"
+#include "Schwarz_Transfer.hpp"
 #include "Thyra_DefaultProductVector.hpp"
 #include "Thyra_DefaultProductVectorSpace.hpp"
 #include "Thyra_ResponseOnlyModelEvaluatorBase.hpp"
@@ -123,6 +125,11 @@ class SchwarzAlternating : public Thyra::ResponseOnlyModelEvaluatorBase<ST>
     AND,
     OR
   };
+  enum class SchwarzVariant
+  {
+    MULTIPLICATIVE,
+    ADDITIVE
+  };
 
  private:
   /// Create operator form of dg/dx for distributed responses
@@ -173,6 +180,18 @@ class SchwarzAlternating : public Thyra::ResponseOnlyModelEvaluatorBase<ST>
   void
   reportFinals(std::ostream& os) const;
 
+  /// True if the subdomain lives on this rank
+  bool
+  isLocal(int const subdomain) const;
+
+  /// Make the norms and the failure flag of the subdomains solved on other
+  /// ranks available on all ranks
+  void
+  reduceSubdomainResults(
+      minitensor::Vector<ST>& norms_init,
+      minitensor::Vector<ST>& norms_final,
+      minitensor::Vector<ST>& norms_diff) const;
+
   std::vector<Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST>>> solvers_;
   Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>>                 apps_;
   std::vector<Teuchos::RCP<Albany::AbstractSTKMeshStruct>>  stk_mesh_structs_;
@@ -207,6 +226,19 @@ class SchwarzAlternating : public Thyra::ResponseOnlyModelEvaluatorBase<ST>
   mutable ConvergenceCriterion       criterion_{ConvergenceCriterion::BOTH};
   mutable ConvergenceLogicalOperator operator_{ConvergenceLogicalOperator::AND};
 
+  // With the additive variant, all subdomains solve with the boundary
+  // values of the previous Schwarz iteration. Given at least as many
+  // ranks as subdomains, each subdomain lives on its own group of ranks
+  // and all of them are solved concurrently.
+  SchwarzVariant variant_{SchwarzVariant::MULTIPLICATIVE};
+
+  Teuchos::RCP<Teuchos::Comm<int> const> comm_{Teuchos::null};
+
+  // Number of ranks of each subdomain when solving concurrently
+  std::vector<int> subdomain_ranks_;
+
+  mutable SchwarzTransfer transfer_;
+
   mutable std::vector<Teuchos::RCP<Thyra::VectorBase<ST> const>> curr_disp_;
   mutable std::vector<Teuchos::RCP<Thyra::VectorBase<ST> const>>
       prev_step_disp_;
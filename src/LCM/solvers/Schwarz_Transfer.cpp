@@ -0,0 +1,396 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include "Schwarz_Transfer.hpp"
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#include "Albany_GenericSTKMeshStruct.hpp"
+#include "Albany_STKDiscretization.hpp"
+#include "Albany_TpetraThyraTypes.hpp"
+#include "Teuchos_CommHelpers.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+
+namespace LCM {
+
+namespace {
+
+// The Schwarz BCs set the three displacement components.
+int const number_components = 3;
+
+Albany::STKDiscretization&
+getSTKDiscretization(Albany::Application const& app)
+{
+  return *static_cast<Albany::STKDiscretization*>(
+      app.getDiscretization().get());
+}
+
+//
+// Cell topology of the coupled block, or of the first block when the
+// coupling ignores blocks, as in the Schwarz BCs.
+//
+CellTopologyData
+coupledCellTopology(
+    Albany::STKDiscretization& coupled_disc,
+    std::string const&         coupled_block_name)
+{
+  auto& coupled_gms = dynamic_cast<Albany::GenericSTKMeshStruct&>(
+      *(coupled_disc.getSTKMeshStruct()));
+
+  auto const& coupled_mesh_specs = coupled_gms.getMeshSpecs();
+
+  bool const use_block = coupled_block_name != "NONE";
+
+  std::map<std::string, int> const& coupled_block_name_to_index =
+      coupled_mesh_specs[0]->ebNameToIndex;
+
+  auto it = coupled_block_name_to_index.find(coupled_block_name);
+
+  bool const missing_block = it == coupled_block_name_to_index.end();
+
+  ALBANY_ASSERT(
+      use_block == false || missing_block == false,
+      "Unknown coupled block: " + coupled_block_name);
+
+  auto const coupled_block_index = use_block == true ? it->second : 0;
+
+  return coupled_mesh_specs[coupled_block_index]->ctd;
+}
+
+}  // anonymous namespace
+
+//
+//
+//
+void
+SchwarzTransfer::setup(Teuchos::Comm<int> const& comm, Apps const& apps)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("> Albany Schwarz: Transfer Setup");
+
+  auto const number_apps = static_cast<int>(apps.size());
+
+  auto const number_ranks = comm.getSize();
+
+  auto const rank = comm.getRank();
+
+  interfaces_.clear();
+  sources_.clear();
+  importers_.clear();
+  number_points_ = 0;
+
+  // Only the ranks of a subdomain know its coupled node sets. Gather them
+  // from all ranks, one per line.
+  std::ostringstream local_interfaces;
+
+  for (auto i = 0; i < number_apps; ++i) {
+    if (apps[i] == Teuchos::null) continue;
+
+    for (auto j = 0; j < number_apps; ++j) {
+      if (apps[i]->isCoupled(j) == false) continue;
+
+      local_interfaces << i << ' ' << j << ' ';
+      local_interfaces << apps[i]->getCoupledBlockName(j) << '\n';
+    }
+  }
+
+  std::string const local_str = local_interfaces.str();
+
+  int const local_length = static_cast<int>(local_str.size());
+
+  int max_length{0};
+
+  Teuchos::reduceAll<int, int>(
+      comm, Teuchos::REDUCE_MAX, local_length, Teuchos::ptr(&max_length));
+
+  // Leave room for the terminating null character.
+  int const stride = max_length + 1;
+
+  std::vector<char> local_chars(stride, '\0');
+
+  std::copy(local_str.begin(), local_str.end(), local_chars.begin());
+
+  std::vector<char> all_chars(stride * number_ranks, '\0');
+
+  Teuchos::gatherAll<int, char>(
+      comm, stride, local_chars.data(), stride * number_ranks, all_chars.data());
+
+  // Sorted, so that all ranks number the interfaces alike.
+  std::set<std::tuple<int, int, std::string>> all_interfaces;
+
+  for (auto r = 0; r < number_ranks; ++r) {
+    std::istringstream iss(std::string(&all_chars[stride * r]));
+
+    int         i{-1};
+    int         j{-1};
+    std::string block_name;
+
+    while (iss >> i >> j >> block_name) {
+      all_interfaces.insert(std::make_tuple(i, j, block_name));
+    }
+  }
+
+  auto const number_interfaces = static_cast<int>(all_interfaces.size());
+
+  if (number_interfaces == 0) return;
+
+  for (auto const& t : all_interfaces) {
+    Interface coupling;
+    coupling.this_app           = std::get<0>(t);
+    coupling.coupled_app        = std::get<1>(t);
+    coupling.coupled_block_name = std::get<2>(t);
+    interfaces_.push_back(coupling);
+  }
+
+  // Number of node set nodes of each interface on each rank, and the
+  // global point list: interface by interface, rank by rank.
+  std::vector<int> local_sizes(number_interfaces, 0);
+
+  for (auto k = 0; k < number_interfaces; ++k) {
+    auto const i = interfaces_[k].this_app;
+
+    auto const j = interfaces_[k].coupled_app;
+
+    if (apps[i] == Teuchos::null) continue;
+
+    auto const& ns_coord = getSTKDiscretization(*apps[i])
+                               .getNodeSetCoords()
+                               .find(apps[i]->getNodesetName(j))
+                               ->second;
+
+    local_sizes[k] = static_cast<int>(ns_coord.size());
+
+    // The Schwarz BCs of this application read the transferred values
+    // from now on.
+    apps[i]->getSchwarzBoundaryValues(j);
+  }
+
+  std::vector<int> all_sizes(number_interfaces * number_ranks, 0);
+
+  Teuchos::gatherAll<int, int>(
+      comm,
+      number_interfaces,
+      local_sizes.data(),
+      number_interfaces * number_ranks,
+      all_sizes.data());
+
+  std::vector<int> interface_starts(number_interfaces + 1, 0);
+
+  for (auto k = 0; k < number_interfaces; ++k) {
+    int start = interface_starts[k];
+
+    for (auto r = 0; r < number_ranks; ++r) {
+      if (r == rank) { interfaces_[k].offset = start; }
+      start += all_sizes[r * number_interfaces + k];
+    }
+
+    interfaces_[k].size = local_sizes[k];
+
+    interface_starts[k + 1] = start;
+  }
+
+  number_points_ = interface_starts[number_interfaces];
+
+  if (number_points_ == 0) return;
+
+  std::vector<double> local_points(number_components * number_points_, 0.0);
+
+  for (auto k = 0; k < number_interfaces; ++k) {
+    auto const i = interfaces_[k].this_app;
+
+    auto const j = interfaces_[k].coupled_app;
+
+    if (apps[i] == Teuchos::null) continue;
+
+    auto const& ns_coord = getSTKDiscretization(*apps[i])
+                               .getNodeSetCoords()
+                               .find(apps[i]->getNodesetName(j))
+                               ->second;
+
+    auto const dimension = getSTKDiscretization(*apps[i]).getNumDim();
+
+    for (auto node = 0; node < interfaces_[k].size; ++node) {
+      auto const point = interfaces_[k].offset + node;
+
+      for (auto c = 0; c < dimension; ++c) {
+        local_points[number_components * point + c] = ns_coord[node][c];
+      }
+    }
+  }
+
+  std::vector<double> points(number_components * number_points_, 0.0);
+
+  Teuchos::reduceAll<int, double>(
+      comm,
+      Teuchos::REDUCE_SUM,
+      number_components * number_points_,
+      local_points.data(),
+      points.data());
+
+  // Locate the points in the coupled elements owned by this rank. Points
+  // on element boundaries go to the lowest rank that finds them.
+  std::vector<int> local_owners(number_points_, number_ranks);
+
+  std::vector<SchwarzPointLocator::Location> locations(number_points_);
+
+  for (auto k = 0; k < number_interfaces; ++k) {
+    auto const j = interfaces_[k].coupled_app;
+
+    if (apps[j] == Teuchos::null) continue;
+
+    auto& coupled_disc = getSTKDiscretization(*apps[j]);
+
+    auto const start = interface_starts[k];
+
+    auto const finish = interface_starts[k + 1];
+
+    std::vector<double> const interface_points(
+        points.begin() + number_components * start,
+        points.begin() + number_components * finish);
+
+    std::vector<SchwarzPointLocator::Location> const interface_locations =
+        point_locator_.locatePoints(
+            coupled_disc,
+            interfaces_[k].coupled_block_name,
+            coupledCellTopology(
+                coupled_disc, interfaces_[k].coupled_block_name),
+            interface_points);
+
+    for (auto p = start; p < finish; ++p) {
+      auto const& location = interface_locations[p - start];
+
+      if (location.workset < 0) continue;
+
+      local_owners[p] = rank;
+      locations[p]    = location;
+    }
+
+    if (importers_.find(j) == importers_.end()) {
+      importers_[j] = Teuchos::rcp(new Tpetra_Import(
+          coupled_disc.getMapT(), coupled_disc.getOverlapMapT()));
+    }
+  }
+
+  std::vector<int> owners(number_points_, number_ranks);
+
+  Teuchos::reduceAll<int, int>(
+      comm,
+      Teuchos::REDUCE_MIN,
+      number_points_,
+      local_owners.data(),
+      owners.data());
+
+  for (auto k = 0; k < number_interfaces; ++k) {
+    for (auto p = interface_starts[k]; p < interface_starts[k + 1]; ++p) {
+      ALBANY_ASSERT(
+          owners[p] < number_ranks,
+          "Schwarz transfer: node of application " +
+              std::to_string(interfaces_[k].this_app) +
+              " not found in application " +
+              std::to_string(interfaces_[k].coupled_app));
+
+      if (owners[p] != rank) continue;
+
+      Source source;
+      source.coupled_app = interfaces_[k].coupled_app;
+      source.point       = p;
+      source.location    = locations[p];
+      sources_.push_back(source);
+    }
+  }
+}
+
+//
+//
+//
+void
+SchwarzTransfer::exchange(
+    Teuchos::Comm<int> const& comm,
+    Apps const&               apps,
+    Solutions const&          solutions)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("> Albany Schwarz: Transfer Exchange");
+
+  if (number_points_ == 0) return;
+
+  // Overlapped solutions of the coupled subdomains on this rank. The
+  // imports are collective over the ranks of each subdomain, so they are
+  // done whether or not this rank interpolates any points.
+  std::map<int, Teuchos::RCP<Tpetra_Vector>> overlap_solutions;
+
+  for (auto const& kv : importers_) {
+    auto const j = kv.first;
+
+    Teuchos::RCP<Tpetra_Vector const> solution =
+        ConverterT::getConstTpetraVector(solutions[j]);
+
+    Teuchos::RCP<Tpetra_Vector> overlap_solution =
+        Teuchos::rcp(new Tpetra_Vector(kv.second->getTargetMap()));
+
+    overlap_solution->doImport(*solution, *kv.second, Tpetra::INSERT);
+
+    overlap_solutions[j] = overlap_solution;
+  }
+
+  std::vector<ST> local_values(number_components * number_points_, 0.0);
+
+  for (auto const& source : sources_) {
+    auto const j = source.coupled_app;
+
+    auto& coupled_disc = getSTKDiscretization(*apps[j]);
+
+    auto const& ws_elem_to_node_id = coupled_disc.getWsElNodeID();
+
+    Teuchos::RCP<Tpetra_Map const> coupled_overlap_node_map =
+        coupled_disc.getOverlapNodeMapT();
+
+    Teuchos::ArrayRCP<ST const> coupled_solution_view =
+        overlap_solutions[j]->get1dView();
+
+    auto const& location = source.location;
+
+    auto const coupled_node_count = location.basis_values.size();
+
+    for (auto node = 0; node < coupled_node_count; ++node) {
+      auto const global_node_id =
+          ws_elem_to_node_id[location.workset][location.element][node];
+
+      auto const local_node_id =
+          coupled_overlap_node_map->getLocalElement(global_node_id);
+
+      for (auto c = 0; c < number_components; ++c) {
+        auto const dof = coupled_disc.getOverlapDOF(local_node_id, c);
+
+        local_values[number_components * source.point + c] +=
+            location.basis_values[node] * coupled_solution_view[dof];
+      }
+    }
+  }
+
+  std::vector<ST> values(number_components * number_points_, 0.0);
+
+  Teuchos::reduceAll<int, ST>(
+      comm,
+      Teuchos::REDUCE_SUM,
+      number_components * number_points_,
+      local_values.data(),
+      values.data());
+
+  for (auto const& coupling : interfaces_) {
+    auto const i = coupling.this_app;
+
+    if (apps[i] == Teuchos::null) continue;
+
+    auto const begin = values.begin() + number_components * coupling.offset;
+
+    auto const end = begin + number_components * coupling.size;
+
+    apps[i]->getSchwarzBoundaryValues(coupling.coupled_app).assign(begin, end);
+  }
+}
+
+}  // namespace LCM
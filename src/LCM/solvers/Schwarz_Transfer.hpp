@@ -0,0 +1,91 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#if !defined(LCM_Schwarz_Transfer_hpp)
+#define LCM_Schwarz_Transfer_hpp
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Albany_Application.hpp"
+#include "Albany_DataTypes.hpp"
+#include "SchwarzPointLocator.hpp"
+#include "Thyra_VectorBase.hpp"
+
+namespace LCM {
+
+///
+/// Transfers the solutions of the Schwarz subdomains to the Schwarz
+/// boundary conditions of the subdomains coupled to them, which may live
+/// on other ranks. The values at the boundary nodes are interpolated on
+/// the ranks that own the coupled elements and reduced over the full
+/// communicator. Only the boundary nodes are exchanged.
+///
+/// Both setup and exchange are collective over the full communicator.
+/// Applications that do not live on this rank are null.
+///
+class SchwarzTransfer
+{
+ public:
+  using Apps = Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>>;
+
+  using Solutions = std::vector<Teuchos::RCP<Thyra::VectorBase<ST> const>>;
+
+  /// Find the coupled node sets of all subdomains and locate their nodes
+  /// in the elements of the coupled subdomains.
+  void
+  setup(Teuchos::Comm<int> const& comm, Apps const& apps);
+
+  /// Interpolate the solutions of the subdomains that live on this rank,
+  /// and set the boundary values of the applications that live on this
+  /// rank.
+  void
+  exchange(
+      Teuchos::Comm<int> const& comm,
+      Apps const&               apps,
+      Solutions const&          solutions);
+
+ private:
+  // A node set of one subdomain coupled to another one
+  struct Interface
+  {
+    int this_app{-1};
+
+    int coupled_app{-1};
+
+    std::string coupled_block_name;
+
+    // Position of the points of this rank in the global point list
+    int offset{0};
+
+    int size{0};
+  };
+
+  // A point interpolated by this rank
+  struct Source
+  {
+    int coupled_app{-1};
+
+    int point{-1};
+
+    SchwarzPointLocator::Location location;
+  };
+
+  std::vector<Interface> interfaces_;
+
+  std::vector<Source> sources_;
+
+  int number_points_{0};
+
+  // Owned to overlapped solution of the coupled subdomains on this rank
+  std::map<int, Teuchos::RCP<Tpetra_Import>> importers_;
+
+  SchwarzPointLocator point_locator_;
+};
+
+}  // namespace LCM
+
+#endif  // LCM_Schwarz_Transfer_hpp
@@ -0,0 +1,141 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "BoundingBoxGrid.h"
+
+namespace {
+
+using Box = LCM::BoundingBoxGrid::Box;
+
+//
+// Unit cubes of a structured n x n x n grid, optionally inflated.
+//
+std::vector<Box>
+structuredBoxes(int const n, double const inflation)
+{
+  std::vector<Box> boxes;
+
+  for (auto k = 0; k < n; ++k) {
+    for (auto j = 0; j < n; ++j) {
+      for (auto i = 0; i < n; ++i) {
+        Box box;
+        box.lo = {{1.0 * i, 1.0 * j, 1.0 * k}};
+        box.hi = {{i + 1.0, j + 1.0, k + 1.0}};
+        LCM::BoundingBoxGrid::inflate(box, 3, inflation);
+        boxes.push_back(box);
+      }
+    }
+  }
+  return boxes;
+}
+
+//
+// Reference all-against-all search.
+//
+std::vector<int>
+bruteForce(
+    std::vector<Box> const& boxes,
+    double const*           point,
+    double const            radius)
+{
+  std::vector<int> hits;
+
+  for (auto b = 0; b < static_cast<int>(boxes.size()); ++b) {
+    double distance2 = 0.0;
+    for (auto i = 0; i < 3; ++i) {
+      double const d = std::max(
+          std::max(boxes[b].lo[i] - point[i], 0.0),
+          point[i] - boxes[b].hi[i]);
+      distance2 += d * d;
+    }
+    if (distance2 <= radius * radius) hits.push_back(b);
+  }
+  return hits;
+}
+
+TEUCHOS_UNIT_TEST(BoundingBoxGrid, PointInStructuredGrid)
+{
+  int const n = 10;
+
+  std::vector<Box> const boxes = structuredBoxes(n, 0.0);
+
+  LCM::BoundingBoxGrid grid;
+
+  grid.build(3, boxes);
+
+  TEST_EQUALITY(grid.size(), n * n * n);
+
+  // Interior point of cell (3, 4, 5) is in exactly one box.
+  double const point[3] = {3.5, 4.5, 5.5};
+
+  std::vector<int> hits;
+
+  grid.query(point, hits);
+
+  TEST_EQUALITY(hits.size(), 1);
+  TEST_EQUALITY(hits[0], (5 * n + 4) * n + 3);
+
+  // Points outside the grid hit nothing.
+  double const outside[3] = {-1.0, 4.5, 5.5};
+
+  grid.query(outside, hits);
+
+  TEST_EQUALITY(hits.size(), 0);
+}
+
+TEUCHOS_UNIT_TEST(BoundingBoxGrid, SharedCornerSorted)
+{
+  int const n = 4;
+
+  std::vector<Box> const boxes = structuredBoxes(n, 0.0);
+
+  LCM::BoundingBoxGrid grid;
+
+  grid.build(3, boxes, 1.0);
+
+  // A shared corner belongs to the 8 surrounding boxes, in order.
+  double const corner[3] = {2.0, 2.0, 2.0};
+
+  std::vector<int> hits;
+
+  grid.query(corner, hits);
+
+  TEST_EQUALITY(hits.size(), 8);
+  TEST_ASSERT(std::is_sorted(hits.begin(), hits.end()));
+  TEST_COMPARE_ARRAYS(hits, bruteForce(boxes, corner, 0.0));
+}
+
+TEUCHOS_UNIT_TEST(BoundingBoxGrid, RadiusMatchesBruteForce)
+{
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> uniform(-1.0, 9.0);
+
+  std::vector<Box> const boxes = structuredBoxes(8, 0.05);
+
+  LCM::BoundingBoxGrid grid;
+
+  grid.build(3, boxes);
+
+  std::vector<int> hits;
+
+  for (auto trial = 0; trial < 200; ++trial) {
+    double const point[3] = {
+        uniform(generator), uniform(generator), uniform(generator)};
+
+    double const radius = 0.25 * (trial % 5);
+
+    grid.query(point, radius, hits);
+
+    TEST_COMPARE_ARRAYS(hits, bruteForce(boxes, point, radius));
+  }
+}
+
+}  // namespace
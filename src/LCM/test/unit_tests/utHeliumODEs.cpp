@@ -297,6 +297,8 @@ TEUCHOS_UNIT_TEST(HeliumODEs, test1)
   workset.numCells = workset_size;
   workset.stateArrayPtr =
       &stateMgr.getStateArray(Albany::StateManager::ELEM, 0);
+  workset.stateTablePtr =
+      &stateMgr.getStateTable(Albany::StateManager::ELEM, 0);
 
   //--------------------------------------------------------------------------
   // loop over time and call evaluators
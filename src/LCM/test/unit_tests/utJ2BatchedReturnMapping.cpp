@@ -0,0 +1,263 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_config.h"
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Albany_Layouts.hpp"
+#include "Albany_StateInfoStruct.hpp"
+#include "FieldNameMap.hpp"
+#include "J2Model.hpp"
+#include "PHAL_AlbanyTraits.hpp"
+
+namespace {
+
+typedef PHAL::AlbanyTraits Traits;
+using Teuchos::RCP;
+using Teuchos::rcp;
+
+// 3 cells of 5 points: 15 points, so the last batch is partial
+int const num_cells  = 3;
+int const num_pts    = 5;
+int const num_dims   = 3;
+// Number of derivatives, which must be the size of a static FAD type
+int const num_derivs = Sacado::StaticSize<FadType>::value > 0 ?
+                           int(Sacado::StaticSize<FadType>::value) :
+                           4;
+
+//
+// Value of x with the seeds of point q: derivatives with respect to the
+// deformation gradient, the hardening modulus and the yield strength
+//
+template <typename ScalarT>
+ScalarT
+seed(RealType const x, int const, int const)
+{
+  return x;
+}
+
+template <>
+FadType
+seed<FadType>(RealType const x, int const q, int const k)
+{
+  FadType y(num_derivs, x);
+  for (int d(0); d < num_derivs; ++d) {
+    y.fastAccessDx(d) = d == k ? 1.0 : 0.01 * (q + d + 1);
+  }
+  return y;
+}
+
+//
+// Compare values, and derivatives when there are
+//
+void
+checkSame(
+    RealType const         a,
+    RealType const         b,
+    Teuchos::FancyOStream& out,
+    bool&                  success)
+{
+  double const tol = 1.0e-10;
+  TEST_COMPARE(std::abs(a - b), <=, tol * (1.0 + std::abs(b)));
+}
+
+void
+checkSame(
+    FadType const&         a,
+    FadType const&         b,
+    Teuchos::FancyOStream& out,
+    bool&                  success)
+{
+  // A missing derivative array counts as zeros
+  checkSame(a.val(), b.val(), out, success);
+  for (int d(0); d < std::max(a.size(), b.size()); ++d) {
+    checkSame(a.dx(d), b.dx(d), out, success);
+  }
+}
+
+//
+// Run the J2 model on a workset with elastic and plastic points, with the
+// scalar or the batched kernel, and return the evaluated fields in the
+// order stress, Fp, eqps, yield surface
+//
+template <typename EvalT>
+std::vector<std::vector<typename EvalT::ScalarT>>
+runJ2(bool const batched)
+{
+  typedef typename EvalT::ScalarT ScalarT;
+
+  RCP<Albany::Layouts> const dl =
+      rcp(new Albany::Layouts(num_cells, 8, 8, num_pts, num_dims));
+
+  LCM::FieldNameMap                                field_name_map(false);
+  Teuchos::RCP<std::map<std::string, std::string>> fnm =
+      field_name_map.getMap();
+
+  Teuchos::ParameterList p;
+  p.set<Teuchos::RCP<std::map<std::string, std::string>>>("Name Map", fnm);
+  p.set<RealType>("Saturation Modulus", 0.5);
+  p.set<RealType>("Saturation Exponent", 20.0);
+  p.set<bool>("Batched Return Mapping", batched);
+  LCM::J2Model<EvalT, Traits> model(&p, dl);
+
+  std::vector<PHX::index_size_type> ddims;
+#ifdef ALBANY_FAD_TYPE_SLFAD
+  ddims.push_back(ALBANY_SLFAD_SIZE);
+#else
+  ddims.push_back(num_derivs);
+#endif
+
+  auto makeField = [&ddims](
+                       std::string const&                   name,
+                       Teuchos::RCP<PHX::DataLayout> const& layout) {
+    PHX::MDField<ScalarT> f(name, layout);
+    f.setFieldData(PHX::KokkosViewFactory<ScalarT, PHX::Device>::buildView(
+        f.fieldTag(), ddims));
+    return f;
+  };
+
+  // dependent fields
+  PHX::MDField<ScalarT> def_grad = makeField((*fnm)["F"], dl->qp_tensor);
+  PHX::MDField<ScalarT> J        = makeField((*fnm)["J"], dl->qp_scalar);
+  PHX::MDField<ScalarT> nu       = makeField("Poissons Ratio", dl->qp_scalar);
+  PHX::MDField<ScalarT> E        = makeField("Elastic Modulus", dl->qp_scalar);
+  PHX::MDField<ScalarT> Y        = makeField("Yield Strength", dl->qp_scalar);
+  PHX::MDField<ScalarT> K = makeField("Hardening Modulus", dl->qp_scalar);
+  PHX::MDField<ScalarT> dt = makeField("Delta Time", dl->workset_scalar);
+
+  // old states
+  std::vector<double> Fp_old_data(num_cells * num_pts * num_dims * num_dims);
+  std::vector<double> eqps_old_data(num_cells * num_pts);
+  Albany::MDArray     Fp_old, eqps_old;
+  Fp_old.assign<Cell, QuadPoint, Dim, Dim>(
+      &Fp_old_data[0], num_cells, num_pts, num_dims, num_dims);
+  eqps_old.assign<Cell, QuadPoint>(&eqps_old_data[0], num_cells, num_pts);
+
+  dt(0) = 1.0;
+  for (int cell(0); cell < num_cells; ++cell) {
+    for (int pt(0); pt < num_pts; ++pt) {
+      int const q = cell * num_pts + pt;
+
+      // every third point stays elastic
+      RealType const gamma = q % 3 == 0 ? 0.001 : 0.01 + 0.005 * q;
+      RealType const stretch = 1.0 + 0.002 * q;
+      for (int i(0); i < num_dims; ++i) {
+        for (int j(0); j < num_dims; ++j) {
+          RealType F_ij = i == j ? 1.0 : 0.0;
+          if (i == 0 && j == 1) F_ij += gamma;
+          if (i == 2 && j == 2) F_ij = stretch;
+          def_grad(cell, pt, i, j) = seed<ScalarT>(F_ij, q, i == j ? 0 : 1);
+          Fp_old(cell, pt, i, j)   = i == j ? 1.0 : 0.0;
+        }
+      }
+      Fp_old(cell, pt, 1, 0) = 0.001 * q;
+      eqps_old(cell, pt)     = 0.002 * q;
+
+      J(cell, pt)  = seed<ScalarT>(stretch, q, 0);
+      nu(cell, pt) = 0.3;
+      E(cell, pt)  = 200.0;
+      K(cell, pt)  = seed<ScalarT>(5.0, q, 2);
+      Y(cell, pt)  = seed<ScalarT>(1.0, q, 3);
+    }
+  }
+
+  Albany::StateArrayVec sav(1);
+  sav[0][(*fnm)["Fp"] + "_old"]   = Fp_old;
+  sav[0][(*fnm)["eqps"] + "_old"] = eqps_old;
+  Albany::StateTableVec tables;
+  Albany::indexStateArrays(sav, tables);
+
+  PHAL::Workset workset;
+  workset.numCells      = num_cells;
+  workset.stateTablePtr = &tables[0];
+
+  typename LCM::J2Model<EvalT, Traits>::DepFieldMap dep_fields;
+  typename LCM::J2Model<EvalT, Traits>::FieldMap    eval_fields;
+  for (auto f : {def_grad, J, nu, E, Y, K, dt}) {
+    dep_fields[f.fieldTag().name()] =
+        rcp(new PHX::MDField<ScalarT const>(f));
+  }
+
+  std::vector<std::string> const eval_names = {(*fnm)["Cauchy_Stress"],
+                                               (*fnm)["Fp"],
+                                               (*fnm)["eqps"],
+                                               (*fnm)["Yield_Surface"]};
+  std::vector<Teuchos::RCP<PHX::DataLayout>> const eval_layouts = {
+      dl->qp_tensor, dl->qp_tensor, dl->qp_scalar, dl->qp_scalar};
+  for (std::size_t n(0); n < eval_names.size(); ++n) {
+    eval_fields[eval_names[n]] = rcp(new PHX::MDField<ScalarT>(
+        makeField(eval_names[n], eval_layouts[n])));
+  }
+
+  model.computeState(workset, dep_fields, eval_fields);
+
+  std::vector<std::vector<ScalarT>> result(eval_names.size());
+  for (std::size_t n(0); n < eval_names.size(); ++n) {
+    PHX::MDField<ScalarT> const& f = *eval_fields[eval_names[n]];
+    for (int cell(0); cell < num_cells; ++cell) {
+      for (int pt(0); pt < num_pts; ++pt) {
+        if (f.rank() == 2) {
+          result[n].push_back(f(cell, pt));
+          continue;
+        }
+        for (int i(0); i < num_dims; ++i) {
+          for (int j(0); j < num_dims; ++j) {
+            result[n].push_back(f(cell, pt, i, j));
+          }
+        }
+      }
+    }
+  }
+
+  // Make sure the test is not vacuous: some points are plastic, some not
+  int num_plastic = 0;
+  for (int q(0); q < num_cells * num_pts; ++q) {
+    RealType const eqps = Sacado::ScalarValue<ScalarT>::eval(result[2][q]);
+    if (eqps > 0.002 * q) ++num_plastic;
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      num_plastic == 0 || num_plastic == num_cells * num_pts,
+      std::logic_error,
+      "Error! The J2 test workset must have elastic and plastic points.\n");
+
+  return result;
+}
+
+//
+// The batched kernel gives the values, and for the Jacobian the
+// derivatives, of the scalar kernel
+//
+template <typename EvalT>
+void
+checkBatched(Teuchos::FancyOStream& out, bool& success)
+{
+  auto const scalar  = runJ2<EvalT>(false);
+  auto const batched = runJ2<EvalT>(true);
+  for (std::size_t n(0); n < scalar.size(); ++n) {
+    TEST_EQUALITY(scalar[n].size(), batched[n].size());
+    for (std::size_t k(0); k < scalar[n].size(); ++k) {
+      checkSame(batched[n][k], scalar[n][k], out, success);
+    }
+  }
+}
+
+TEUCHOS_UNIT_TEST(J2BatchedReturnMapping, Residual)
+{
+  checkBatched<PHAL::AlbanyTraits::Residual>(out, success);
+}
+
+TEUCHOS_UNIT_TEST(J2BatchedReturnMapping, Jacobian)
+{
+  checkBatched<PHAL::AlbanyTraits::Jacobian>(out, success);
+}
+
+}  // anonymous namespace
@@ -165,6 +165,8 @@ TEUCHOS_UNIT_TEST(LameStress_elastic, Instantiation)
   workset.numCells = worksetSize;
   workset.stateArrayPtr =
       &stateMgr.getStateArray(Albany::StateManager::ELEM, 0);
+  workset.stateTablePtr =
+      &stateMgr.getStateTable(Albany::StateManager::ELEM, 0);
 
   // Call the evaluators, evaluateFields() is the function that computes stress
   // based on deformation gradient
@@ -0,0 +1,174 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "mortar/Moertel_BoundingBoxTree.hpp"
+
+namespace {
+
+using Tree = MoertelT::BoundingBoxTree;
+
+// Same value as MoertelT::Rough_Search_Radius
+double const radius = 2.5;
+
+//
+// Random segments with nnode nodes, stored with stride 3, in dim dimensions.
+// Sizes vary over two orders of magnitude.
+//
+std::vector<std::vector<double>>
+randomSegments(
+    int const         num_segments,
+    int const         nnode,
+    std::size_t const dim,
+    unsigned const    seed)
+{
+  std::mt19937                           gen(seed);
+  std::uniform_real_distribution<double> center(0.0, 20.0);
+  std::uniform_real_distribution<double> offset(-1.0, 1.0);
+  std::uniform_real_distribution<double> log_size(-1.0, 0.0);
+
+  std::vector<std::vector<double>> segments(num_segments);
+  for (auto& x : segments) {
+    x.assign(3 * nnode, 0.0);
+    double const size = std::pow(10.0, log_size(gen));
+    double       c[3];
+    for (std::size_t j = 0; j < dim; ++j) c[j] = center(gen);
+    for (int i = 0; i < nnode; ++i) {
+      for (std::size_t j = 0; j < dim; ++j) {
+        x[3 * i + j] = c[j] + size * offset(gen);
+      }
+    }
+  }
+  return segments;
+}
+
+//
+// The quick overlap test of the mortar integration: the distance of the
+// centroids is at most radius times the sum of the diameters.
+//
+bool
+quickOverlap(
+    std::vector<double> const& a,
+    std::vector<double> const& b,
+    int const                  nnode)
+{
+  auto centroid = [nnode](std::vector<double> const& x, double* c) {
+    for (int j = 0; j < 3; ++j) {
+      c[j] = 0.0;
+      for (int i = 0; i < nnode; ++i) c[j] += x[3 * i + j];
+      c[j] /= nnode;
+    }
+  };
+  auto diameter = [nnode](std::vector<double> const& x, double const* c) {
+    double diam = 0.0;
+    for (int i = 0; i < nnode; ++i) {
+      double d2 = 0.0;
+      for (int j = 0; j < 3; ++j) d2 += (x[3 * i + j] - c[j]) * (x[3 * i + j] - c[j]);
+      diam = std::max(diam, std::sqrt(d2));
+    }
+    return diam;
+  };
+
+  double ca[3], cb[3];
+  centroid(a, ca);
+  centroid(b, cb);
+  double d2 = 0.0;
+  for (int j = 0; j < 3; ++j) d2 += (ca[j] - cb[j]) * (ca[j] - cb[j]);
+  return std::sqrt(d2) <= radius * (diameter(a, ca) + diameter(b, cb));
+}
+
+//
+// Reference all-against-all box search, in ascending order.
+//
+std::vector<int>
+bruteForce(std::vector<Tree::Box> const& boxes, Tree::Box const& box)
+{
+  std::vector<int> hits;
+  for (int b = 0; b < static_cast<int>(boxes.size()); ++b) {
+    bool overlap = true;
+    for (int j = 0; j < 3; ++j) {
+      if (boxes[b].hi[j] < box.lo[j] || box.hi[j] < boxes[b].lo[j]) overlap = false;
+    }
+    if (overlap) hits.push_back(b);
+  }
+  return hits;
+}
+
+//
+// Build the tree over the master segments, as InterfaceT::BuildMasterTree
+// does, and check that the tree query returns the overlapping search boxes
+// in ascending order, and that every pair passing the quick overlap test is
+// among them.
+//
+void
+checkSearch(
+    int const         nnode,
+    std::size_t const dim,
+    Teuchos::FancyOStream& out,
+    bool&             success)
+{
+  auto const masters = randomSegments(400, nnode, dim, 7);
+  auto const slaves  = randomSegments(100, nnode, dim, 11);
+
+  std::vector<Tree::Box> boxes;
+  for (auto const& x : masters) {
+    boxes.push_back(Tree::SegmentSearchBox(x.data(), nnode, dim, radius));
+  }
+  Tree tree;
+  tree.Build(boxes);
+
+  std::vector<int> candidates;
+  int              num_pairs = 0;
+  for (auto const& s : slaves) {
+    Tree::Box const box = Tree::SegmentSearchBox(s.data(), nnode, dim, radius);
+    tree.Query(box, candidates);
+    TEST_ASSERT(candidates == bruteForce(boxes, box));
+    for (int m = 0; m < static_cast<int>(masters.size()); ++m) {
+      if (!quickOverlap(s, masters[m], nnode)) continue;
+      ++num_pairs;
+      TEST_ASSERT(std::binary_search(candidates.begin(), candidates.end(), m));
+    }
+  }
+  // Make sure the test is not vacuous
+  TEST_ASSERT(num_pairs > 0);
+}
+
+TEUCHOS_UNIT_TEST(MortarBoundingBoxTree, SegmentSearchBox)
+{
+  // A unit segment along x: diagonal 1, so the box grows by radius
+  std::vector<double> const x = {0.0, 0.0, 0.0, 1.0, 0.0, 0.0};
+  Tree::Box const           box = Tree::SegmentSearchBox(x.data(), 2, 2, radius);
+
+  double const tol = 1.0e-8;
+  TEST_FLOATING_EQUALITY(box.lo[0], -radius, tol);
+  TEST_FLOATING_EQUALITY(box.hi[0], 1.0 + radius, tol);
+  TEST_FLOATING_EQUALITY(box.lo[1], -radius, tol);
+  TEST_FLOATING_EQUALITY(box.hi[1], radius, tol);
+}
+
+TEUCHOS_UNIT_TEST(MortarBoundingBoxTree, Edges2D) { checkSearch(2, 2, out, success); }
+
+TEUCHOS_UNIT_TEST(MortarBoundingBoxTree, Triangles3D) { checkSearch(3, 3, out, success); }
+
+TEUCHOS_UNIT_TEST(MortarBoundingBoxTree, Quads3D) { checkSearch(4, 3, out, success); }
+
+TEUCHOS_UNIT_TEST(MortarBoundingBoxTree, Empty)
+{
+  Tree             tree;
+  std::vector<int> hits(1, 0);
+  tree.Build(std::vector<Tree::Box>());
+  Tree::Box box;
+  for (int j = 0; j < 3; ++j) box.lo[j] = box.hi[j] = 0.0;
+  tree.Query(box, hits);
+  TEST_ASSERT(hits.empty());
+}
+
+}  // anonymous namespace
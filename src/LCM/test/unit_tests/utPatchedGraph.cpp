@@ -0,0 +1,117 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <algorithm>
+
+#include "Albany_DiscretizationFactory.hpp"
+#include "Albany_STKDiscretization.hpp"
+#include "Albany_Utils.hpp"
+#include "topology/Topology.h"
+#include "topology/Topology_FractureCriterion.h"
+
+namespace {
+
+//
+// Check that two graphs have the same rows, with the same global columns.
+//
+void
+checkSameGraph(
+    Tpetra_CrsGraph const& a,
+    Tpetra_CrsGraph const& b,
+    Teuchos::FancyOStream& out,
+    bool&                  success)
+{
+  TEST_ASSERT(a.getRowMap()->isSameAs(*b.getRowMap()));
+  TEST_EQUALITY(a.getGlobalNumEntries(), b.getGlobalNumEntries());
+
+  Teuchos::Array<Tpetra_GO> cols_a, cols_b;
+  Tpetra_Map const&         rows = *a.getRowMap();
+  for (Tpetra_LO i = 0; i < rows.getNodeNumElements(); ++i) {
+    Tpetra_GO const row = rows.getGlobalElement(i);
+    size_t          num_a = 0, num_b = 0;
+    cols_a.resize(a.getNumEntriesInGlobalRow(row));
+    cols_b.resize(b.getNumEntriesInGlobalRow(row));
+    a.getGlobalRowCopy(row, cols_a(), num_a);
+    b.getGlobalRowCopy(row, cols_b(), num_b);
+    std::sort(cols_a.begin(), cols_a.end());
+    std::sort(cols_b.begin(), cols_b.end());
+    TEST_COMPARE_ARRAYS(cols_a, cols_b);
+  }
+}
+
+//
+// Split one face of a hexahedral mesh, then compare the graphs patched
+// around the split points with the graphs rebuilt from the whole mesh.
+//
+TEUCHOS_UNIT_TEST(PatchedGraph, SplitOpenFaces)
+{
+  Teuchos::RCP<Teuchos::ParameterList> params =
+      Teuchos::rcp(new Teuchos::ParameterList("params"));
+
+  Teuchos::ParameterList& disc_params = params->sublist("Discretization");
+  disc_params.set<std::string>("Method", "STK3D");
+  disc_params.set<int>("1D Elements", 3);
+  disc_params.set<int>("2D Elements", 3);
+  disc_params.set<int>("3D Elements", 3);
+  disc_params.set<int>("Number Of Time Derivatives", 0);
+
+  std::string const bulk_block_name      = "Block0";
+  std::string const interface_block_name = "Surface Element";
+
+  Teuchos::ParameterList& adapt_params =
+      params->sublist("Problem").sublist("Adaptation");
+  adapt_params.set<std::string>("Method", "Topmod");
+  adapt_params.set<std::string>("Bulk Block Name", bulk_block_name);
+  adapt_params.set<std::string>("Interface Block Name", interface_block_name);
+
+  Teuchos::RCP<Teuchos_Comm> comm =
+      Albany::createTeuchosCommFromMpiComm(Albany_MPI_COMM_WORLD);
+
+  Albany::DiscretizationFactory disc_factory(params, comm);
+  disc_factory.createMeshSpecs();
+
+  Teuchos::RCP<Albany::StateInfoStruct> state_info =
+      Teuchos::rcp(new Albany::StateInfoStruct());
+  Albany::AbstractFieldContainer::FieldContainerRequirements req;
+
+  Teuchos::RCP<Albany::AbstractDiscretization> disc =
+      disc_factory.createDiscretization(3, state_info, req);
+
+  LCM::Topology topology(disc, bulk_block_name, interface_block_name);
+  topology.set_fracture_criterion(
+      Teuchos::rcp(new LCM::FractureCriterionOnce(topology, 1.0)));
+  topology.setEntitiesOpen();
+  topology.splitOpenFaces();
+
+  stk::mesh::EntityVector const& split_points = topology.get_split_points();
+  TEST_ASSERT(split_points.empty() == false);
+
+  Albany::STKDiscretization& stk_disc =
+      static_cast<Albany::STKDiscretization&>(*disc);
+
+  stk_disc.updateMesh(split_points);
+  Teuchos::RCP<const Tpetra_CrsGraph> const patched_overlap =
+      stk_disc.getOverlapJacobianGraphT();
+  Teuchos::RCP<const Tpetra_CrsGraph> const patched =
+      stk_disc.getJacobianGraphT();
+
+  stk_disc.updateMesh();
+  Teuchos::RCP<const Tpetra_CrsGraph> const full_overlap =
+      stk_disc.getOverlapJacobianGraphT();
+  Teuchos::RCP<const Tpetra_CrsGraph> const full =
+      stk_disc.getJacobianGraphT();
+
+  // Make sure the graphs are not shared
+  TEST_ASSERT(patched_overlap.get() != full_overlap.get());
+
+  checkSameGraph(*patched_overlap, *full_overlap, out, success);
+  checkSameGraph(*patched, *full, out, success);
+}
+
+}  // anonymous namespace
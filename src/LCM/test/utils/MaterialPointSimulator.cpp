@@ -538,6 +538,8 @@ main(int ac, char* av[])
   workset.numCells = workset_size;
   workset.stateArrayPtr =
       &stateMgr.getStateArray(Albany::StateManager::ELEM, 0);
+  workset.stateTablePtr =
+      &stateMgr.getStateTable(Albany::StateManager::ELEM, 0);
 
   // create MDFields
   PHX::MDField<ScalarT, Cell, QuadPoint, Dim, Dim> stressField(
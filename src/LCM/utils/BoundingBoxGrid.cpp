@@ -0,0 +1,286 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "BoundingBoxGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Teuchos_TestForException.hpp"
+
+namespace LCM {
+
+//
+//
+//
+void
+BoundingBoxGrid::build(
+    int const              dimension,
+    std::vector<Box> const& boxes,
+    double const           boxes_per_cell)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      dimension < 1 || dimension > MAX_DIMENSION,
+      std::logic_error,
+      "BoundingBoxGrid: invalid dimension " << dimension << '\n');
+
+  clear();
+
+  dimension_ = dimension;
+  boxes_     = boxes;
+
+  auto const number_boxes = boxes_.size();
+
+  if (number_boxes == 0) return;
+
+  // Overall bounds and average box size.
+  double const huge = std::numeric_limits<double>::max();
+
+  for (auto i = 0; i < MAX_DIMENSION; ++i) {
+    bounds_.lo[i] = i < dimension_ ? huge : 0.0;
+    bounds_.hi[i] = i < dimension_ ? -huge : 0.0;
+  }
+
+  Point average_size{{0.0, 0.0, 0.0}};
+
+  for (auto const& box : boxes_) {
+    for (auto i = 0; i < dimension_; ++i) {
+      bounds_.lo[i] = std::min(bounds_.lo[i], box.lo[i]);
+      bounds_.hi[i] = std::max(bounds_.hi[i], box.hi[i]);
+      average_size[i] += (box.hi[i] - box.lo[i]) / number_boxes;
+    }
+  }
+
+  // Cells about the size of an average box hold a handful of boxes.
+  // Scale that by the requested occupancy, and cap the total number of
+  // cells to keep memory proportional to the number of boxes.
+  double const scale = std::pow(
+      std::max(boxes_per_cell, 1.0) / std::pow(2.0, dimension_),
+      1.0 / dimension_);
+
+  double const max_cells = 8.0 * number_boxes + 1.0;
+
+  while (true) {
+    double total_cells = 1.0;
+
+    for (auto i = 0; i < dimension_; ++i) {
+      double const extent = bounds_.hi[i] - bounds_.lo[i];
+
+      double const h = scale * average_size[i];
+
+      int const n = (h > 0.0 && extent > 0.0)
+                        ? static_cast<int>(std::ceil(extent / h))
+                        : 1;
+
+      num_cells_[i] = std::max(1, n);
+      total_cells *= num_cells_[i];
+    }
+
+    if (total_cells <= max_cells) break;
+
+    for (auto i = 0; i < dimension_; ++i) { average_size[i] *= 2.0; }
+  }
+
+  for (auto i = 0; i < MAX_DIMENSION; ++i) {
+    if (i >= dimension_) {
+      num_cells_[i] = 1;
+      spacing_[i]   = 1.0;
+      continue;
+    }
+    double const extent = bounds_.hi[i] - bounds_.lo[i];
+    spacing_[i]         = extent > 0.0 ? extent / num_cells_[i] : 1.0;
+  }
+
+  cells_.resize(num_cells_[0] * num_cells_[1] * num_cells_[2]);
+
+  std::array<int, MAX_DIMENSION> first, last, ijk;
+
+  for (auto b = 0; b < static_cast<int>(number_boxes); ++b) {
+    cellRange(boxes_[b], first, last);
+
+    for (ijk[2] = first[2]; ijk[2] <= last[2]; ++ijk[2]) {
+      for (ijk[1] = first[1]; ijk[1] <= last[1]; ++ijk[1]) {
+        for (ijk[0] = first[0]; ijk[0] <= last[0]; ++ijk[0]) {
+          cells_[cellIndex(ijk)].push_back(b);
+        }
+      }
+    }
+  }
+}
+
+//
+//
+//
+void
+BoundingBoxGrid::clear()
+{
+  dimension_ = 0;
+  boxes_.clear();
+  cells_.clear();
+  num_cells_ = {{1, 1, 1}};
+  spacing_   = {{1.0, 1.0, 1.0}};
+}
+
+//
+//
+//
+void
+BoundingBoxGrid::cellRange(
+    Box const&                      box,
+    std::array<int, MAX_DIMENSION>& first,
+    std::array<int, MAX_DIMENSION>& last) const
+{
+  for (auto i = 0; i < MAX_DIMENSION; ++i) {
+    if (i >= dimension_) {
+      first[i] = 0;
+      last[i]  = 0;
+      continue;
+    }
+    int const n = num_cells_[i];
+
+    double const lo = (box.lo[i] - bounds_.lo[i]) / spacing_[i];
+    double const hi = (box.hi[i] - bounds_.lo[i]) / spacing_[i];
+
+    first[i] = std::min(std::max(static_cast<int>(std::floor(lo)), 0), n - 1);
+    last[i]  = std::min(std::max(static_cast<int>(std::floor(hi)), 0), n - 1);
+  }
+}
+
+//
+//
+//
+void
+BoundingBoxGrid::collect(
+    std::array<int, MAX_DIMENSION> const& first,
+    std::array<int, MAX_DIMENSION> const& last,
+    std::vector<int>&                     candidates) const
+{
+  candidates.clear();
+
+  std::array<int, MAX_DIMENSION> ijk;
+
+  for (ijk[2] = first[2]; ijk[2] <= last[2]; ++ijk[2]) {
+    for (ijk[1] = first[1]; ijk[1] <= last[1]; ++ijk[1]) {
+      for (ijk[0] = first[0]; ijk[0] <= last[0]; ++ijk[0]) {
+        auto const& cell = cells_[cellIndex(ijk)];
+        candidates.insert(candidates.end(), cell.begin(), cell.end());
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(
+      std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+//
+//
+//
+void
+BoundingBoxGrid::query(double const* point, std::vector<int>& hits) const
+{
+  query(point, 0.0, hits);
+}
+
+//
+//
+//
+void
+BoundingBoxGrid::query(Box const& box, std::vector<int>& hits) const
+{
+  hits.clear();
+
+  if (empty() == true) return;
+
+  for (auto i = 0; i < dimension_; ++i) {
+    if (box.hi[i] < bounds_.lo[i] || box.lo[i] > bounds_.hi[i]) return;
+  }
+
+  std::array<int, MAX_DIMENSION> first, last;
+
+  cellRange(box, first, last);
+
+  std::vector<int> candidates;
+
+  collect(first, last, candidates);
+
+  for (auto const b : candidates) {
+    Box const& other = boxes_[b];
+
+    bool overlap = true;
+
+    for (auto i = 0; i < dimension_; ++i) {
+      overlap = overlap && other.lo[i] <= box.hi[i] && box.lo[i] <= other.hi[i];
+    }
+
+    if (overlap == true) hits.push_back(b);
+  }
+}
+
+//
+//
+//
+void
+BoundingBoxGrid::query(
+    double const*     point,
+    double const      radius,
+    std::vector<int>& hits) const
+{
+  Box box;
+
+  for (auto i = 0; i < dimension_; ++i) {
+    box.lo[i] = point[i] - radius;
+    box.hi[i] = point[i] + radius;
+  }
+
+  query(box, hits);
+
+  if (radius <= 0.0) return;
+
+  // Discard boxes that overlap the square around the point but lie
+  // farther than radius from it.
+  double const radius2 = radius * radius;
+
+  auto it = std::remove_if(hits.begin(), hits.end(), [&](int const b) {
+    Box const& other    = boxes_[b];
+    double     distance2 = 0.0;
+    for (auto i = 0; i < dimension_; ++i) {
+      double const d = std::max(
+          std::max(other.lo[i] - point[i], 0.0), point[i] - other.hi[i]);
+      distance2 += d * d;
+    }
+    return distance2 > radius2;
+  });
+
+  hits.erase(it, hits.end());
+}
+
+//
+//
+//
+void
+BoundingBoxGrid::inflate(
+    Box&         box,
+    int const    dimension,
+    double const relative,
+    double const absolute)
+{
+  double size = 0.0;
+
+  for (auto i = 0; i < dimension; ++i) {
+    size = std::max(size, box.hi[i] - box.lo[i]);
+  }
+
+  double const delta = relative * size + absolute;
+
+  for (auto i = 0; i < dimension; ++i) {
+    box.lo[i] -= delta;
+    box.hi[i] += delta;
+  }
+}
+
+}  // namespace LCM
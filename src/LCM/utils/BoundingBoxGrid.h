@@ -0,0 +1,130 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#if !defined(LCM_BoundingBoxGrid_h)
+#define LCM_BoundingBoxGrid_h
+
+#include <array>
+#include <vector>
+
+namespace LCM {
+
+///
+/// Uniform bucket grid over a set of axis-aligned bounding boxes.
+/// Each grid cell stores the indices of the boxes that overlap it, so
+/// point and box queries only test the boxes of the cells they touch
+/// instead of every box. Box indices are returned in ascending order,
+/// which keeps searches that pick the first hit deterministic.
+///
+class BoundingBoxGrid
+{
+ public:
+  static constexpr int MAX_DIMENSION = 3;
+
+  using Point = std::array<double, MAX_DIMENSION>;
+
+  struct Box
+  {
+    Point lo{{0.0, 0.0, 0.0}};
+    Point hi{{0.0, 0.0, 0.0}};
+  };
+
+  BoundingBoxGrid() = default;
+
+  ///
+  /// Build the grid over the given boxes. The grid spacing is chosen
+  /// so that each cell overlaps about boxes_per_cell boxes.
+  ///
+  void
+  build(int const dimension, std::vector<Box> const& boxes,
+      double const boxes_per_cell = 2.0);
+
+  void
+  clear();
+
+  bool
+  empty() const
+  {
+    return boxes_.empty();
+  }
+
+  int
+  size() const
+  {
+    return static_cast<int>(boxes_.size());
+  }
+
+  Box const&
+  box(int const i) const
+  {
+    return boxes_[i];
+  }
+
+  ///
+  /// Indices of the boxes that contain the point.
+  ///
+  void
+  query(double const* point, std::vector<int>& hits) const;
+
+  ///
+  /// Indices of the boxes that overlap the given box.
+  ///
+  void
+  query(Box const& box, std::vector<int>& hits) const;
+
+  ///
+  /// Indices of the boxes within distance radius of the point,
+  /// measured between the point and the closest point of each box.
+  ///
+  void
+  query(double const* point, double const radius, std::vector<int>& hits)
+      const;
+
+  ///
+  /// Expand a box by a relative and an absolute tolerance.
+  ///
+  static void
+  inflate(
+      Box& box,
+      int const dimension,
+      double const relative,
+      double const absolute = 0.0);
+
+ private:
+  void
+  cellRange(
+      Box const& box,
+      std::array<int, MAX_DIMENSION>& first,
+      std::array<int, MAX_DIMENSION>& last) const;
+
+  int
+  cellIndex(std::array<int, MAX_DIMENSION> const& ijk) const
+  {
+    return (ijk[2] * num_cells_[1] + ijk[1]) * num_cells_[0] + ijk[0];
+  }
+
+  void
+  collect(
+      std::array<int, MAX_DIMENSION> const& first,
+      std::array<int, MAX_DIMENSION> const& last,
+      std::vector<int>& candidates) const;
+
+  int dimension_{0};
+
+  std::vector<Box> boxes_;
+
+  Box bounds_;
+
+  Point spacing_{{1.0, 1.0, 1.0}};
+
+  std::array<int, MAX_DIMENSION> num_cells_{{1, 1, 1}};
+
+  std::vector<std::vector<int>> cells_;
+};
+
+}  // namespace LCM
+
+#endif  // LCM_BoundingBoxGrid_h
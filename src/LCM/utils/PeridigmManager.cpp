@@ -7,17 +7,19 @@
 /*! \file PeridigmManager.cpp */
 
 #include "PeridigmManager.hpp"
+#include <Epetra_Distributor.h>
 #include <Epetra_Export.h>
 #include <Teuchos_LAPACK.hpp>
 #include <Teuchos_SerialDenseMatrix.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <cstring>
+#include <limits>
 #include <stk_mesh/base/FieldBase.hpp>
 #include <stk_mesh/base/GetEntities.hpp>
 #include "Albany_MaterialDatabase.hpp"
 #include "Albany_Utils.hpp"
 #include "Albany_ProblemUtils.hpp"
 #include "PHAL_Dimension.hpp"
-#include "Peridigm_ProximitySearch.hpp"
 #include "Phalanx_DataLayout_MDALayout.hpp"
 #include "Phalanx_KokkosViewFactory.hpp"
 #include "Phalanx_MDField.hpp"
@@ -45,9 +47,12 @@ LCM::PeridigmManager::PeridigmManager()
     : hasPeridynamics(false),
       enableOptimizationBasedCoupling(false),
       obcScaleFactor(1.0),
+      obcUpdateOverlapSearch(false),
       previousTime(0.0),
       currentTime(0.0),
       timeStep(0.0),
+      obcSearchHits(0),
+      obcSearchMisses(0),
       cubatureDegree(-1)
 {
 }
@@ -76,6 +81,9 @@ LCM::PeridigmManager::initialize(
     enableOptimizationBasedCoupling = true;
     obcScaleFactor = peridigmParams->sublist("Optimization Based Coupling")
                          .get<double>("Functional Scale Factor", 1.0);
+    obcUpdateOverlapSearch =
+        peridigmParams->sublist("Optimization Based Coupling")
+            .get<bool>("Update Overlap Search", false);
   }
 
   // Read the material data base file, if any
@@ -656,16 +664,8 @@ LCM::PeridigmManager::initialize(
 }
 
 void
-LCM::PeridigmManager::obcOverlappingElementSearch()
+LCM::PeridigmManager::obcOverlappingElementSearch(bool useCurrentConfiguration)
 {
-  static bool searchComplete = false;
-  if (searchComplete) {
-    std::cout << "DJL DEBUGGING PeridigmManager::obcOverlappingElementSearch() "
-                 "is being called more than once!"
-              << std::endl;
-  }
-  searchComplete = true;
-
   obcDataPoints = Teuchos::rcp(new std::vector<OBCDataPoint>());
 
   stk::mesh::Field<double, stk::mesh::Cartesian3d>* coordinatesField =
@@ -698,173 +698,171 @@ LCM::PeridigmManager::obcOverlappingElementSearch()
       bulkData->buckets(stk::topology::ELEMENT_RANK),
       elements);
 
-  // Collect data for the proximity search and for filling OBCDataPoint
-  // structures downstream
-  std::vector<double> proximitySearchCoords(3 * elements.size(), 0.0);
-  std::vector<double> proximitySearchRadii(elements.size(), 0.0);
-  std::vector<int>    proximitySearchGlobalElemIds(elements.size());
-  double              maxProximitySearchRadius(0.0);
+  // Split the elements into solid elements and sphere elements
+  obcSolidElements.clear();
+  std::vector<stk::mesh::Entity> sphereElements;
   for (unsigned int iElem = 0; iElem < elements.size(); ++iElem) {
-    proximitySearchGlobalElemIds[iElem] =
-        bulkData->identifier(elements[iElem]) - 1;
-    int                      numNodes = bulkData->num_nodes(elements[iElem]);
-    const stk::mesh::Entity* nodes    = bulkData->begin_nodes(elements[iElem]);
-    if (numNodes == 1) {
-      // If the element is a sphere element, include its node in the search and
-      // set the search radius to a small number
-      double* coord  = stk::mesh::field_data(*coordinatesField, nodes[0]);
-      double* volume = stk::mesh::field_data(*volumeField, elements[iElem]);
-      for (int dof = 0; dof < 3; ++dof) {
-        proximitySearchCoords[3 * iElem + dof] = coord[dof];
-      }
-      // DJL there is a bug in the proximity search, it doesn't work properly in
-      // parallel if the radius is set to 0.0. So, set it to some small number,
-      // like a 1/1000 times the cube root of the volume.
-      proximitySearchRadii[iElem] = 0.001 * std::cbrt(volume[0]);
-      if (proximitySearchRadii[iElem] > maxProximitySearchRadius) {
-        maxProximitySearchRadius = proximitySearchRadii[iElem];
-      }
+    if (bulkData->num_nodes(elements[iElem]) == 1) {
+      sphereElements.push_back(elements[iElem]);
     } else {
-      // If the element is not a sphere element, use its barycenter in the
-      // proximity search and set the search radius to be slightly larger than
-      // the largest element dimension
-      double radiusMultiplier               = 1.5;
-      double largestElementDimensionSquared = 0.0;
-      for (int i = 0; i < numNodes; ++i) {
-        double* pt1 = stk::mesh::field_data(*coordinatesField, nodes[i]);
-        for (int dof = 0; dof < 3; ++dof) {
-          proximitySearchCoords[3 * iElem + dof] += pt1[dof];
-        }
-        for (int j = i + 1; j < numNodes; ++j) {
-          double* pt2 = stk::mesh::field_data(*coordinatesField, nodes[j]);
-          double  distanceSquared = (pt1[0] - pt2[0]) * (pt1[0] - pt2[0]) +
-                                   (pt1[1] - pt2[1]) * (pt1[1] - pt2[1]) +
-                                   (pt1[2] - pt2[2]) * (pt1[2] - pt2[2]);
-          if (distanceSquared > largestElementDimensionSquared) {
-            largestElementDimensionSquared = distanceSquared;
-          }
-        }
-      }
-      for (int dof = 0; dof < 3; dof++) {
-        proximitySearchCoords[3 * iElem + dof] /= numNodes;
-      }
-      proximitySearchRadii[iElem] =
-          radiusMultiplier * std::sqrt(largestElementDimensionSquared);
-      if (proximitySearchRadii[iElem] > maxProximitySearchRadius) {
-        maxProximitySearchRadius = proximitySearchRadii[iElem];
-      }
+      obcSolidElements.push_back(elements[iElem]);
     }
   }
 
-  // This is a work-around for an apparent bug in the proximity search
-  // There appears to be a glitch when many nodes have zero neighbors, so use a
-  // larger search radius than needed
-  vector<double> localValDouble(1), globalValDouble(1);
-  localValDouble[0] = maxProximitySearchRadius;
-  Teuchos::reduceAll(
-      *teuchosComm,
-      Teuchos::REDUCE_MAX,
-      1,
-      &localValDouble[0],
-      &globalValDouble[0]);
-  maxProximitySearchRadius = globalValDouble[0];
-  for (unsigned int i = 0; i < proximitySearchRadii.size(); i++) {
-    proximitySearchRadii[i] = maxProximitySearchRadius;
-  }
-
   Teuchos::RCP<Epetra_Comm> epetraComm =
       Albany::createEpetraCommFromTeuchosComm(teuchosComm);
 
-  // Create Epetra_BlockMaps for the Peridigm proximity search
-  Epetra_BlockMap epetraOneDimensionalMap(
-      -1,
-      static_cast<int>(elements.size()),
-      &proximitySearchGlobalElemIds[0],
-      1,
-      0,
-      *epetraComm);
-  Epetra_BlockMap epetraThreeDimensionalMap(
-      -1,
-      static_cast<int>(elements.size()),
-      &proximitySearchGlobalElemIds[0],
-      3,
-      0,
-      *epetraComm);
-
-  // Input for proximity search routine
-  Teuchos::RCP<Epetra_Vector> epetraProximitySearchCoords =
-      Teuchos::rcp(new Epetra_Vector(epetraThreeDimensionalMap));
-  Teuchos::RCP<Epetra_Vector> epetraProximitySearchRadii =
-      Teuchos::rcp(new Epetra_Vector(epetraOneDimensionalMap));
-  for (unsigned int iElem = 0; iElem < elements.size(); ++iElem) {
-    for (int dof = 0; dof < 3; dof++) {
-      (*epetraProximitySearchCoords)[3 * iElem + dof] =
-          proximitySearchCoords[3 * iElem + dof];
+  // Search coordinates of a solid element node, either the reference
+  // coordinates or the reference coordinates plus the Albany displacement
+  Teuchos::ArrayRCP<const ST> albanyCurrentDisplacement =
+      albanyOverlapSolutionVector->getData();
+  const Teuchos::RCP<const Tpetra_Map> albanyMap =
+      albanyOverlapSolutionVector->getMap();
+  auto solidNodeCoords = [&](stk::mesh::Entity node, double* coords) {
+    double* coord = stk::mesh::field_data(*coordinatesField, node);
+    for (int dof = 0; dof < 3; ++dof) { coords[dof] = coord[dof]; }
+    if (useCurrentConfiguration) {
+      int globalAlbanyNodeId = bulkData->identifier(node) - 1;
+      Tpetra_Map::local_ordinal_type albanyLocalId =
+          albanyMap->getLocalElement(3 * globalAlbanyNodeId);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(
+          albanyLocalId == Teuchos::OrdinalTraits<LO>::invalid(),
+          "\n\n**** Error in PeridigmManager::obcOverlappingElementSearch(), "
+          "invalid Albany local id.\n\n");
+      for (int dof = 0; dof < 3; ++dof) {
+        coords[dof] += albanyCurrentDisplacement[albanyLocalId + dof];
+      }
+    }
+  };
+
+  // Index the bounding boxes of the on-processor solid elements. The boxes
+  // are slightly inflated so that points on the element boundary are found.
+  std::vector<BoundingBoxGrid::Box> boxes(obcSolidElements.size());
+  BoundingBoxGrid::Box              processorBox;
+  processorBox.lo.fill(std::numeric_limits<double>::max());
+  processorBox.hi.fill(-std::numeric_limits<double>::max());
+  for (unsigned int iElem = 0; iElem < obcSolidElements.size(); ++iElem) {
+    int numNodes = bulkData->num_nodes(obcSolidElements[iElem]);
+    const stk::mesh::Entity* nodes =
+        bulkData->begin_nodes(obcSolidElements[iElem]);
+    BoundingBoxGrid::Box& box = boxes[iElem];
+    box.lo.fill(std::numeric_limits<double>::max());
+    box.hi.fill(-std::numeric_limits<double>::max());
+    for (int i = 0; i < numNodes; ++i) {
+      double coords[3];
+      solidNodeCoords(nodes[i], coords);
+      for (int dof = 0; dof < 3; ++dof) {
+        box.lo[dof] = std::min(box.lo[dof], coords[dof]);
+        box.hi[dof] = std::max(box.hi[dof], coords[dof]);
+      }
+    }
+    BoundingBoxGrid::inflate(box, 3, 0.01);
+    for (int dof = 0; dof < 3; ++dof) {
+      processorBox.lo[dof] = std::min(processorBox.lo[dof], box.lo[dof]);
+      processorBox.hi[dof] = std::max(processorBox.hi[dof], box.hi[dof]);
     }
-    (*epetraProximitySearchRadii)[iElem] = proximitySearchRadii[iElem];
+  }
+  obcElementGrid.build(3, boxes);
+
+  // Share the bounding boxes of all processors. Processors without solid
+  // elements have an empty (inverted) box.
+  int const           numProcs = teuchosComm->getSize();
+  std::vector<double> localBox(6), processorBoxes(6 * numProcs);
+  for (int dof = 0; dof < 3; ++dof) {
+    localBox[dof]     = processorBox.lo[dof];
+    localBox[3 + dof] = processorBox.hi[dof];
+  }
+  Teuchos::gatherAll(
+      *teuchosComm, 6, &localBox[0], 6 * numProcs, &processorBoxes[0]);
+
+  // Search coordinates of the on-processor sphere elements. In the current
+  // configuration, these are the Peridigm current positions.
+  Teuchos::RCP<Epetra_Vector> sphereCurrentCoords;
+  if (useCurrentConfiguration) {
+    std::vector<int> sphereNodeIds(sphereElements.size());
+    for (unsigned int iElem = 0; iElem < sphereElements.size(); ++iElem) {
+      sphereNodeIds[iElem] =
+          bulkData->identifier(bulkData->begin_nodes(sphereElements[iElem])[0]) -
+          1;
+    }
+    Epetra_BlockMap sphereMap(
+        -1,
+        static_cast<int>(sphereNodeIds.size()),
+        sphereNodeIds.data(),
+        3,
+        0,
+        *epetraComm);
+    sphereCurrentCoords = Teuchos::rcp(new Epetra_Vector(sphereMap));
+    Epetra_Vector& peridigmCurrentPositions = *(peridigm->getY());
+    Epetra_Import  currentCoordsImporter(
+        sphereMap, peridigmCurrentPositions.Map());
+    int err = sphereCurrentCoords->Import(
+        peridigmCurrentPositions, currentCoordsImporter, Insert);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(
+        err != 0,
+        "\n\n**** Error in PeridigmManager::obcOverlappingElementSearch(), "
+        "import operation failed!\n\n");
   }
 
-  // Output from proximity search routine
-  Teuchos::RCP<Epetra_BlockMap> epetraOneDimensionalOverlapMap;
-  int                           neighborListSize(0);
-  int*                          neighborList(0);
-
-  // Call the Peridigm proximity search routine
-  PeridigmNS::ProximitySearch::GlobalProximitySearch(
-      epetraProximitySearchCoords,
-      epetraProximitySearchRadii,
-      epetraOneDimensionalOverlapMap,
-      neighborListSize,
-      neighborList);
-
-  // Create a three-dimensional version of the overlap map
-  Epetra_BlockMap epetraThreeDimensionalOverlapMap(
-      epetraOneDimensionalOverlapMap->NumGlobalElements(),
-      epetraOneDimensionalOverlapMap->NumMyElements(),
-      epetraOneDimensionalOverlapMap->MyGlobalElements(),
-      3,
-      0,
-      *epetraComm);
-
-  // Ghost information for off-processor points
-  Teuchos::RCP<Epetra_Vector> epetraSphereVolume =
-      Teuchos::rcp(new Epetra_Vector(epetraOneDimensionalMap));
-  Teuchos::RCP<Epetra_Vector> epetraSphereNodeId =
-      Teuchos::rcp(new Epetra_Vector(epetraOneDimensionalMap));
-  for (unsigned int iElem = 0; iElem < elements.size(); ++iElem) {
-    int                      elemId = bulkData->identifier(elements[iElem]) - 1;
-    int                      numNodes = bulkData->num_nodes(elements[iElem]);
-    const stk::mesh::Entity* nodes    = bulkData->begin_nodes(elements[iElem]);
-    if (numNodes == 1) {
-      double* volume = stk::mesh::field_data(*volumeField, elements[iElem]);
-      (*epetraSphereVolume)[iElem] = volume[0];
-      (*epetraSphereNodeId)[iElem] =
-          static_cast<double>(bulkData->identifier(nodes[0]) - 1);
-    } else {
-      (*epetraSphereVolume)[iElem] = 0.0;
-      (*epetraSphereNodeId)[iElem] = -2;
+  // Send each sphere element to the processors whose bounding box contains
+  // it: node id, volume, initial coordinates and search coordinates
+  int const                        recordSize = 8;
+  std::vector<std::vector<double>> sendBuffers(numProcs);
+  for (unsigned int iElem = 0; iElem < sphereElements.size(); ++iElem) {
+    const stk::mesh::Entity node = bulkData->begin_nodes(sphereElements[iElem])[0];
+    double* coord  = stk::mesh::field_data(*coordinatesField, node);
+    double* volume = stk::mesh::field_data(*volumeField, sphereElements[iElem]);
+    double  searchCoords[3];
+    for (int dof = 0; dof < 3; ++dof) {
+      searchCoords[dof] = useCurrentConfiguration ?
+                              (*sphereCurrentCoords)[3 * iElem + dof] :
+                              coord[dof];
+    }
+    for (int proc = 0; proc < numProcs; ++proc) {
+      const double* procBox = &processorBoxes[6 * proc];
+      bool          inside  = true;
+      for (int dof = 0; dof < 3; ++dof) {
+        inside = inside && searchCoords[dof] >= procBox[dof] &&
+                 searchCoords[dof] <= procBox[3 + dof];
+      }
+      if (!inside) continue;
+      std::vector<double>& buffer = sendBuffers[proc];
+      buffer.push_back(static_cast<double>(bulkData->identifier(node) - 1));
+      buffer.push_back(volume[0]);
+      for (int dof = 0; dof < 3; ++dof) buffer.push_back(coord[dof]);
+      for (int dof = 0; dof < 3; ++dof) buffer.push_back(searchCoords[dof]);
     }
   }
+  std::vector<int>    exportProcs;
+  std::vector<double> exportData;
+  for (int proc = 0; proc < numProcs; ++proc) {
+    exportProcs.insert(
+        exportProcs.end(), sendBuffers[proc].size() / recordSize, proc);
+    exportData.insert(
+        exportData.end(), sendBuffers[proc].begin(), sendBuffers[proc].end());
+  }
 
-  // Bring all necessary off-processor data onto this processor
-  Epetra_Vector epetraOverlapCoords(epetraThreeDimensionalOverlapMap);
-  Epetra_Vector epetraOverlapSphereVolume(*epetraOneDimensionalOverlapMap);
-  Epetra_Vector epetraOverlapSphereNodeId(*epetraOneDimensionalOverlapMap);
-  Epetra_Import threeDimensionalImporter(
-      epetraThreeDimensionalOverlapMap, epetraThreeDimensionalMap);
-  Epetra_Import oneDimensionalImporter(
-      *epetraOneDimensionalOverlapMap, epetraOneDimensionalMap);
-  int coordsImportErrorCode = epetraOverlapCoords.Import(
-      *epetraProximitySearchCoords, threeDimensionalImporter, Insert);
-  int volumeImportErrorCode = epetraOverlapSphereVolume.Import(
-      *epetraSphereVolume, oneDimensionalImporter, Insert);
-  int sphereNodeIdImportErrorCode = epetraOverlapSphereNodeId.Import(
-      *epetraSphereNodeId, oneDimensionalImporter, Insert);
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(
-      coordsImportErrorCode != 0 || volumeImportErrorCode != 0 ||
-          sphereNodeIdImportErrorCode != 0,
-      "\n\n**** Error in PeridigmManager::obcOverlappingElementSearch(), "
-      "import operation failed!\n\n");
+  Teuchos::RCP<Epetra_Distributor> distributor =
+      Teuchos::rcp(epetraComm->CreateDistributor());
+  int numImports(0);
+  distributor->CreateFromSends(
+      static_cast<int>(exportProcs.size()),
+      exportProcs.data(),
+      true,
+      numImports);
+  int   importLength(0);
+  char* importBuffer(0);
+  distributor->Do(
+      reinterpret_cast<char*>(exportData.data()),
+      recordSize * static_cast<int>(sizeof(double)),
+      importLength,
+      importBuffer);
+  std::vector<double> importData(recordSize * numImports);
+  if (numImports > 0) {
+    std::memcpy(
+        importData.data(), importBuffer, importData.size() * sizeof(double));
+  }
+  delete[] importBuffer;
 
   // Store the cell topology for each on-processor element
   std::map<int, CellTopologyData> albanyGlobalElementIdToCellTopolotyData;
@@ -893,122 +891,112 @@ LCM::PeridigmManager::obcOverlappingElementSearch()
   }
 
   // All sphere elements that could possibly be within an on-processor solid
-  // element are now available on processor.  Some other points have been
-  // ghosted as well (barycenters of solid elements); they will be ignored as we
-  // check for peridynamic nodes within each on-processor solid element.
+  // element are now available on processor. For each of them, check the
+  // solid elements whose bounding box contains it. A box hit that is not
+  // within the element is counted as a miss.
+  obcSearchHits   = 0;
+  obcSearchMisses = 0;
 
-  // Loop over all the on-processor nodes and check to see if any of the
-  // peridynamic nodes identified by the proximity search are within the element
-  int neighborhoodListIndex = 0;
-  typedef PHX::KokkosViewFactory<RealType, PHX::Device> ViewFactory;
+  // We're interested in a single point in a single element in a
+  // three-dimensional simulation
+  int numCells      = 1;
+  int numQuadPoints = 1;
+  int numDim        = 3;
+
+  std::vector<int> candidates;
+  for (int iSphere = 0; iSphere < numImports; ++iSphere) {
+    const double* record               = &importData[recordSize * iSphere];
+    int           neighborSphereNodeId = static_cast<int>(record[0]);
+    double        neighborSphereVolume = record[1];
+    const double* initialCoords        = &record[2];
+    const double* searchCoords         = &record[5];
+
+    obcElementGrid.query(searchCoords, candidates);
+
+    for (unsigned int iCandidate = 0; iCandidate < candidates.size();
+         ++iCandidate) {
+      stk::mesh::Entity element = obcSolidElements[candidates[iCandidate]];
+
+      // Get the elements nodes and cell topology
+      int numNodesInElement = bulkData->num_nodes(element);
+      const stk::mesh::Entity* nodesInElement = bulkData->begin_nodes(element);
+      int globalElementId = bulkData->identifier(element) - 1;
+      std::map<int, CellTopologyData>::iterator it =
+          albanyGlobalElementIdToCellTopolotyData.find(globalElementId);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(
+          it == albanyGlobalElementIdToCellTopolotyData.end(),
+          "\n\n**** Error in PeridigmManager::obcOverlappingElementSearch(), "
+          "failed to find cell topology.\n\n");
+      const CellTopologyData& cellTopologyData = it->second;
+      shards::CellTopology    cellTopology(&cellTopologyData);
 
-  for (unsigned int iElem = 0; iElem < elements.size(); ++iElem) {
-    // Get the elements nodes and cell topology
-    int numNodesInElement = bulkData->num_nodes(elements[iElem]);
-    const stk::mesh::Entity* nodesInElement =
-        bulkData->begin_nodes(elements[iElem]);
-    int globalElementId = bulkData->identifier(elements[iElem]) - 1;
-    std::map<int, CellTopologyData>::iterator it =
-        albanyGlobalElementIdToCellTopolotyData.find(globalElementId);
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(
-        it == albanyGlobalElementIdToCellTopolotyData.end(),
-        "\n\n**** Error in PeridigmManager::obcOverlappingElementSearch(), "
-        "failed to find cell topology.\n\n");
-    const CellTopologyData& cellTopologyData = it->second;
-    shards::CellTopology    cellTopology(&cellTopologyData);
+      // Physical points, which are the physical (x, y, z) values of the
+      // peridynamic node (pay no attention to the "quadrature point"
+      // descriptor)
+      Kokkos::DynRankView<RealType, PHX::Device> physPoints(
+          "PPP", numCells, numQuadPoints, numDim);
 
-    // The neighbors are the nodes that might be within the element
-    int numNeighbors = neighborList[neighborhoodListIndex++];
+      // Reference points, which are the natural coordinates of the
+      // quadrature points
+      Kokkos::DynRankView<RealType, PHX::Device> refPoints(
+          "PPP", numCells, numQuadPoints, numDim);
 
-    // Skip peridynamic nodes
-    if (numNodesInElement == 1) {
-      neighborhoodListIndex += numNeighbors;
-    } else {
-      for (int iNeighbor = 0; iNeighbor < numNeighbors; iNeighbor++) {
-        int neighborIndex = neighborList[neighborhoodListIndex++];
-        int neighborSphereNodeId =
-            static_cast<int>(epetraOverlapSphereNodeId[neighborIndex]);
-        double neighborSphereVolume = epetraOverlapSphereVolume[neighborIndex];
-
-        // If the neighbor is a peridynamic sphere element, check to see if it's
-        // within the solid element
-        if (neighborSphereNodeId > -1) {
-          std::vector<double> neighborCoords(3);
-          for (int dof = 0; dof < 3; dof++) {
-            neighborCoords[dof] = epetraOverlapCoords[3 * neighborIndex + dof];
-          }
-
-          // We're interested in a single point in a single element in a
-          // three-dimensional simulation
-          int numCells      = 1;
-          int numQuadPoints = 1;
-          int numDim        = 3;
-
-          // Physical points, which are the physical (x, y, z) values of the
-          // peridynamic node (pay no attention to the "quadrature point"
-          // descriptor)
-          Kokkos::DynRankView<RealType, PHX::Device> physPoints(
-              "PPP", numCells, numQuadPoints, numDim);
-
-          // Reference points, which are the natural coordinates of the
-          // quadrature points
-          Kokkos::DynRankView<RealType, PHX::Device> refPoints(
-              "PPP", numCells, numQuadPoints, numDim);
-
-          // Cell workset, which is the set of nodes for the given element
-          Kokkos::DynRankView<RealType, PHX::Device> cellWorkset(
-              "PPP", numCells, numNodesInElement, numDim);
-
-          for (int dof = 0; dof < 3; dof++) {
-            physPoints(0, 0, dof) = neighborCoords[dof];
-          }
-
-          for (int i = 0; i < numNodesInElement; i++) {
-            double* coordinates =
-                stk::mesh::field_data(*coordinatesField, nodesInElement[i]);
-            for (int dof = 0; dof < 3; dof++) {
-              cellWorkset(0, i, dof) = coordinates[dof];
-            }
-          }
-
-          Intrepid2::CellTools<PHX::Device>::mapToReferenceFrame(
-              refPoints,
-              physPoints,
-              cellWorkset,
-              cellTopology);  //, -1); TODO: check this
-
-          bool refPointsAreNan = !boost::math::isfinite(refPoints(0, 0, 0)) ||
-                                 !boost::math::isfinite(refPoints(0, 0, 1)) ||
-                                 !boost::math::isfinite(refPoints(0, 0, 2));
-          TEUCHOS_TEST_FOR_EXCEPT_MSG(
-              refPointsAreNan,
-              "\n**** Error in PeridigmManager::obcOverlappingElementSearch(), "
-              "NaN in refPoints.\n");
-
-          Kokkos::DynRankView<RealType, PHX::Device> point("point", 3);
-          for (int dof = 0; dof < 3; dof++) {
-            point(dof) = refPoints(0, 0, dof);
-          }
-
-          int inElement =
-              Intrepid2::CellTools<PHX::Device>::checkPointInclusion(
-                  point, cellTopology);
-
-          if (inElement) {
-            OBCDataPoint dataPoint;
-            dataPoint.sphereElementVolume = neighborSphereVolume;
-            for (int dof = 0; dof < 3; dof++) {
-              dataPoint.initialCoords[dof] = neighborCoords[dof];
-              dataPoint.currentCoords[dof] = 0.0;
-              dataPoint.naturalCoords[dof] = point[dof];
-            }
-            dataPoint.peridigmGlobalId = neighborSphereNodeId;
-            dataPoint.albanyElement    = elements[iElem];
-            dataPoint.cellTopologyData = cellTopologyData;
-            obcDataPoints->push_back(dataPoint);
-          }
+      // Cell workset, which is the set of nodes for the given element
+      Kokkos::DynRankView<RealType, PHX::Device> cellWorkset(
+          "PPP", numCells, numNodesInElement, numDim);
+
+      for (int dof = 0; dof < 3; dof++) {
+        physPoints(0, 0, dof) = searchCoords[dof];
+      }
+
+      for (int i = 0; i < numNodesInElement; i++) {
+        double coordinates[3];
+        solidNodeCoords(nodesInElement[i], coordinates);
+        for (int dof = 0; dof < 3; dof++) {
+          cellWorkset(0, i, dof) = coordinates[dof];
         }
       }
+
+      Intrepid2::CellTools<PHX::Device>::mapToReferenceFrame(
+          refPoints,
+          physPoints,
+          cellWorkset,
+          cellTopology);  //, -1); TODO: check this
+
+      bool refPointsAreNan = !boost::math::isfinite(refPoints(0, 0, 0)) ||
+                             !boost::math::isfinite(refPoints(0, 0, 1)) ||
+                             !boost::math::isfinite(refPoints(0, 0, 2));
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(
+          refPointsAreNan,
+          "\n**** Error in PeridigmManager::obcOverlappingElementSearch(), "
+          "NaN in refPoints.\n");
+
+      Kokkos::DynRankView<RealType, PHX::Device> point("point", 3);
+      for (int dof = 0; dof < 3; dof++) { point(dof) = refPoints(0, 0, dof); }
+
+      int inElement = Intrepid2::CellTools<PHX::Device>::checkPointInclusion(
+          point, cellTopology);
+
+      if (!inElement) {
+        ++obcSearchMisses;
+        continue;
+      }
+
+      ++obcSearchHits;
+      OBCDataPoint dataPoint;
+      dataPoint.sphereElementVolume = neighborSphereVolume;
+      for (int dof = 0; dof < 3; dof++) {
+        dataPoint.initialCoords[dof] = initialCoords[dof];
+        dataPoint.currentCoords[dof] = 0.0;
+        dataPoint.naturalCoords[dof] = point[dof];
+      }
+      dataPoint.peridigmGlobalId = neighborSphereNodeId;
+      dataPoint.albanyElement    = element;
+      dataPoint.cellTopologyData = cellTopologyData;
+      obcDataPoints->push_back(dataPoint);
+
+      // A peridynamic node is assigned to the first solid element found
+      break;
     }
   }
 
@@ -1022,7 +1010,7 @@ LCM::PeridigmManager::obcOverlappingElementSearch()
   Epetra_BlockMap epetraTempMap(
       -1,
       static_cast<int>(tempGlobalIds.size()),
-      &tempGlobalIds[0],
+      tempGlobalIds.data(),
       3,
       0,
       *epetraComm);
@@ -1031,17 +1019,24 @@ LCM::PeridigmManager::obcOverlappingElementSearch()
       Teuchos::rcp(new Epetra_Vector(epetraTempMap));
 
   // As a sanity check, determine the total number of overlapping peridynamic
-  // nodes
-  vector<int> localVal(1), globalVal(1);
+  // nodes, and report the efficiency of the search
+  vector<int> localVal(3), globalVal(3);
   localVal[0] = static_cast<int>(obcDataPoints->size());
+  localVal[1] = obcSearchHits;
+  localVal[2] = obcSearchMisses;
   Teuchos::reduceAll(
-      *teuchosComm, Teuchos::REDUCE_SUM, 1, &localVal[0], &globalVal[0]);
+      *teuchosComm, Teuchos::REDUCE_SUM, 3, &localVal[0], &globalVal[0]);
   int numberOfOverlappingPeridynamicNodes = globalVal[0];
 
   if (teuchosComm->getRank() == 0) {
     std::cout << "\n-- Overlapping Element Search --" << std::endl;
+    std::cout << "  configuration: "
+              << (useCurrentConfiguration ? "current" : "reference")
+              << std::endl;
     std::cout << "  number of peridynamic nodes in overlap region: "
               << numberOfOverlappingPeridynamicNodes << std::endl;
+    std::cout << "  bounding box hits: " << globalVal[1]
+              << ", misses: " << globalVal[2] << std::endl;
   }
 }
 
@@ -1480,6 +1475,10 @@ LCM::PeridigmManager::updateState()
     for (unsigned int i = 0; i < previousSolutionPositions.size(); ++i)
       previousSolutionPositions[i] = (*peridigmY)[i];
     peridigm->updateState();
+    // Track the overlap region as the solid and the peridynamic nodes move
+    if (enableOptimizationBasedCoupling && obcUpdateOverlapSearch) {
+      obcOverlappingElementSearch(true);
+    }
   }
 }
 
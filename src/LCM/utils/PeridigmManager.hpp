@@ -11,6 +11,7 @@
 
 #include "Albany_AbstractDiscretization.hpp"
 #include "Albany_STKDiscretization.hpp"
+#include "BoundingBoxGrid.h"
 
 #include <Peridigm.hpp>
 #include <Peridigm_AlbanyDiscretization.hpp>
@@ -73,7 +74,14 @@ public:
 		  const Teuchos::RCP<const Teuchos_Comm>& comm);
 
   //! Identify the overlapping solid element for each peridynamic sphere element (applies only to overlapping discretizations).
-  void obcOverlappingElementSearch();
+  //! The search is done in the reference configuration, or in the current configuration to track a moving overlap region.
+  void obcOverlappingElementSearch(bool useCurrentConfiguration = false);
+
+  //! Number of peridynamic nodes found within a solid element by the last overlapping element search.
+  int obcSearchHitCount() const { return obcSearchHits; }
+
+  //! Number of solid elements whose bounding box, but not the element itself, contained a peridynamic node in the last search.
+  int obcSearchMissCount() const { return obcSearchMisses; }
 
   //! Evaluate the functional for optimization-based coupling
   double obcEvaluateFunctional(Epetra_Vector* obcFunctionalDerivWrtDisplacement = NULL);
@@ -159,6 +167,7 @@ private:
 
   bool enableOptimizationBasedCoupling;
   double obcScaleFactor;
+  bool obcUpdateOverlapSearch;
 
   double previousTime;
   double currentTime;
@@ -186,6 +195,12 @@ private:
 
   Teuchos::RCP<Epetra_Vector> obcPeridynamicNodeCurrentCoords;
 
+  //! On-processor solid elements and the index of their bounding boxes for the overlapping element search
+  std::vector<stk::mesh::Entity> obcSolidElements;
+  BoundingBoxGrid obcElementGrid;
+  int obcSearchHits;
+  int obcSearchMisses;
+
   int cubatureDegree;
 
   Teuchos::RCP<Tpetra_Vector> albanyOverlapSolutionVector;
@@ -0,0 +1,182 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef MOERTEL_BOUNDINGBOXTREE_HPP
+#define MOERTEL_BOUNDINGBOXTREE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace MoertelT {
+
+/*!
+\class BoundingBoxTree
+
+\brief <b> A static tree of axis-aligned bounding boxes </b>
+
+The tree is built top down by splitting the boxes at the median of their
+centers along the longest extent. A box query only descends into the
+subtrees whose bounds overlap the query box, so finding the boxes close to
+a segment costs O(log n) instead of a loop over all n boxes.
+
+The tree is meant to be rebuilt whenever the boxes change, e.g. once per
+integration of an interface in the current configuration.
+
+*/
+class BoundingBoxTree
+{
+ public:
+  struct Box
+  {
+    double lo[3];
+    double hi[3];
+  };
+
+  //! Expand a box by delta in all directions
+  static void
+  Inflate(Box& box, const double delta)
+  {
+    for (int j = 0; j < 3; ++j) {
+      box.lo[j] -= delta;
+      box.hi[j] += delta;
+    }
+  }
+
+  //! Search box of a segment with n nodes, whose coordinates are stored in x
+  //! with stride 3 and dim meaningful components: its bounding box, grown by
+  //! radius times the box diagonal. If the centroids of two segments are
+  //! within radius times the sum of their diameters (the quick overlap tests
+  //! of the mortar integration), their search boxes overlap.
+  static Box
+  SegmentSearchBox(
+      const double*     x,
+      const int         n,
+      const std::size_t dim,
+      const double      radius)
+  {
+    Box box;
+    for (std::size_t j = 0; j < 3; ++j) box.lo[j] = box.hi[j] = 0.0;
+    for (std::size_t j = 0; j < dim; ++j) box.lo[j] = box.hi[j] = x[j];
+    for (int i = 1; i < n; ++i)
+      for (std::size_t j = 0; j < dim; ++j) {
+        box.lo[j] = std::min(box.lo[j], x[3 * i + j]);
+        box.hi[j] = std::max(box.hi[j], x[3 * i + j]);
+      }
+
+    // The diameter of a segment is at most its box diagonal, and the distance
+    // of the centroids is at least the distance of the boxes
+    double diag2 = 0.0;
+    for (std::size_t j = 0; j < 3; ++j)
+      diag2 += (box.hi[j] - box.lo[j]) * (box.hi[j] - box.lo[j]);
+    Inflate(box, radius * std::sqrt(diag2) * (1.0 + 1.0e-10));
+
+    return box;
+  }
+
+  //! Build the tree over the given boxes
+  void
+  Build(const std::vector<Box>& boxes)
+  {
+    boxes_ = boxes;
+    nodes_.clear();
+    index_.resize(boxes_.size());
+    for (int i = 0; i < (int)index_.size(); ++i) index_[i] = i;
+    if (!boxes_.empty()) BuildNode(0, (int)index_.size());
+  }
+
+  //! Indices of the boxes overlapping box, in ascending order
+  void
+  Query(const Box& box, std::vector<int>& hits) const
+  {
+    hits.clear();
+    if (nodes_.empty()) return;
+    std::vector<int> stack(1, 0);
+    while (!stack.empty()) {
+      const Node& node = nodes_[stack.back()];
+      stack.pop_back();
+      if (!Overlap(node.box, box)) continue;
+      if (node.left < 0) {
+        for (int i = node.first; i < node.first + node.count; ++i)
+          if (Overlap(boxes_[index_[i]], box)) hits.push_back(index_[i]);
+      } else {
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+    std::sort(hits.begin(), hits.end());
+  }
+
+ private:
+  struct Node
+  {
+    Box box;
+    int left;   // children, -1 for a leaf
+    int right;
+    int first;  // range of index_ held by a leaf
+    int count;
+  };
+
+  static const int leaf_size_ = 4;
+
+  static bool
+  Overlap(const Box& a, const Box& b)
+  {
+    for (int j = 0; j < 3; ++j)
+      if (a.hi[j] < b.lo[j] || b.hi[j] < a.lo[j]) return false;
+    return true;
+  }
+
+  int
+  BuildNode(const int first, const int last)
+  {
+    const int id = nodes_.size();
+    nodes_.push_back(Node());
+
+    Box bounds = boxes_[index_[first]];
+    for (int i = first + 1; i < last; ++i)
+      for (int j = 0; j < 3; ++j) {
+        bounds.lo[j] = std::min(bounds.lo[j], boxes_[index_[i]].lo[j]);
+        bounds.hi[j] = std::max(bounds.hi[j], boxes_[index_[i]].hi[j]);
+      }
+    nodes_[id].box   = bounds;
+    nodes_[id].first = first;
+    nodes_[id].count = last - first;
+    nodes_[id].left  = -1;
+    nodes_[id].right = -1;
+    if (last - first <= leaf_size_) return id;
+
+    int axis = 0;
+    for (int j = 1; j < 3; ++j)
+      if (bounds.hi[j] - bounds.lo[j] > bounds.hi[axis] - bounds.lo[axis])
+        axis = j;
+
+    const int mid = first + (last - first) / 2;
+    std::nth_element(
+        index_.begin() + first,
+        index_.begin() + mid,
+        index_.begin() + last,
+        [&](const int a, const int b) {
+          return boxes_[a].lo[axis] + boxes_[a].hi[axis] <
+                 boxes_[b].lo[axis] + boxes_[b].hi[axis];
+        });
+
+    const int left   = BuildNode(first, mid);
+    const int right  = BuildNode(mid, last);
+    nodes_[id].left  = left;
+    nodes_[id].right = right;
+    return id;
+  }
+
+  std::vector<Box>  boxes_;
+  std::vector<int>  index_;
+  std::vector<Node> nodes_;
+};
+
+}  // namespace MoertelT
+
+#endif  // MOERTEL_BOUNDINGBOXTREE_HPP
@@ -18,6 +18,7 @@
 #include "Tpetra_CrsMatrix.hpp"
 
 // mrtr includes
+#include "Moertel_BoundingBoxTree.hpp"
 #include "Moertel_NodeT.hpp"
 #include "Moertel_ProjectorT.hpp"
 #include "Moertel_SegmentT.hpp"
@@ -1001,6 +1002,17 @@ class InterfaceT
       MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) & sseg,
       MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) & mseg);
 
+  // Bounding box of a segment in the current configuration, grown such that
+  // the boxes of two segments failing the quick overlap tests do not overlap
+  MoertelT::BoundingBoxTree::Box SearchBox(
+      MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) & seg);
+
+  // Bounding box tree of the search boxes of the master segments
+  void BuildMasterTree(
+      std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>>&
+                                 msegs,
+      MoertelT::BoundingBoxTree& mtree);
+
  private:
   int  Id_;            // the interface Id
   int  outlevel_;      // output level (0-10)
@@ -151,6 +151,13 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_3D()
   int mside = MortarSide();
   int sside = OtherSide(mside);
 
+  // only master segments whose search boxes overlap the one of the slave
+  // segment can pass the quick overlap test, find them with a tree
+  std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>> msegs;
+  MoertelT::BoundingBoxTree                                             mtree;
+  BuildMasterTree(msegs, mtree);
+  std::vector<int> candidates;
+
   // loop over all segments of slave side
   std::map<int, Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>>::
       iterator scurr;
@@ -182,13 +189,13 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_3D()
     // Teuchos::Time time(*lComm());
     // time.ResetStartTime();
 
-    // loop over all segments on the master side
-    std::map<int, Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>>::
-        iterator mcurr;
+    // loop over the candidate segments on the master side, in the order of
+    // rseg_[mside]
+    mtree.Query(SearchBox(*actsseg), candidates);
 
-    for (mcurr = rseg_[mside].begin(); mcurr != rseg_[mside].end(); ++mcurr) {
+    for (std::size_t m = 0; m < candidates.size(); ++m) {
       Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)> actmseg =
-          mcurr->second;
+          msegs[candidates[m]];
 #if 0
       std::cout << "Active mseg id " << actmseg->Id() << std::endl;
 #endif
@@ -197,7 +204,7 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_3D()
       // (whether there is an overlap or not will be checked inside)
       Integrate_3D_Section(*actsseg, *actmseg);
 
-    }  // for (mcurr=rseg_[mside].begin(); mcurr!=rseg_[mside].end(); ++mcurr)
+    }  // for (m=0; m<candidates.size(); ++m)
 
     // std::cout << "time for this slave segment: " << time.ElapsedTime() <<
     // std::endl;
@@ -291,6 +291,13 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_2D()
   int mside = MortarSide();
   int sside = OtherSide(mside);
 
+  // only master segments whose search boxes overlap the one of the slave
+  // segment can pass the quick overlap test, find them with a tree
+  std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>> msegs;
+  MoertelT::BoundingBoxTree                                             mtree;
+  BuildMasterTree(msegs, mtree);
+  std::vector<int> candidates;
+
   // loop over all segments of slave side
   std::map<int, Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>>::
       iterator scurr;
@@ -315,12 +322,12 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_2D()
     // if none of the nodes belongs to me, do nothing on this segment
     if (!foundone) continue;
 
-    // loop over all segments on the master side
-    std::map<int, Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>>::
-        iterator mcurr;
-    for (mcurr = rseg_[mside].begin(); mcurr != rseg_[mside].end(); ++mcurr) {
+    // loop over the candidate segments on the master side, in the order of
+    // rseg_[mside]
+    mtree.Query(SearchBox(*actsseg), candidates);
+    for (std::size_t m = 0; m < candidates.size(); ++m) {
       Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)> actmseg =
-          mcurr->second;
+          msegs[candidates[m]];
 
 #if 0
       std::cout << "Active mseg id " << actmseg->Id() << std::endl;
@@ -334,7 +341,7 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_2D()
         // overlap case found" error. Don't treat this as fatal.
       }
 
-    }  // for (mcurr=rseg_[mside].begin(); mcurr!=rseg_[mside].end(); ++mcurr)
+    }  // for (m=0; m<candidates.size(); ++m)
   }    // for (scurr=rseg_[sside].begin(); scurr!=rseg_[sside].end(); ++scurr)
 
   return true;
@@ -808,6 +815,53 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::QuickOverlapTest_2D(
   return true;
 }
 
+/*----------------------------------------------------------------------*
+  |  search box of a segment in the current configuration                |
+ *----------------------------------------------------------------------*/
+MOERTEL_TEMPLATE_STATEMENT
+MoertelT::BoundingBoxTree::Box
+MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::SearchBox(
+    MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) & seg)
+{
+  MoertelT::MOERTEL_TEMPLATE_CLASS(NodeT)** nodes = seg.Nodes();
+  const int nnode                                 = seg.Nnode();
+
+  std::vector<double> x(3 * nnode, 0.0);
+  for (int i = 0; i < nnode; ++i)
+    for (std::size_t j = 0; j < DIM; ++j) x[3 * i + j] = nodes[i]->XCoords()[j];
+
+  // Both quick overlap tests compare the distance of the centroids to
+  // Rough_Search_Radius times the sum of the segment diameters
+  return MoertelT::BoundingBoxTree::SegmentSearchBox(
+      x.data(), nnode, DIM, MoertelT::Rough_Search_Radius);
+}
+
+/*----------------------------------------------------------------------*
+  |  bounding box tree of the master segments                            |
+ *----------------------------------------------------------------------*/
+MOERTEL_TEMPLATE_STATEMENT
+void MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::BuildMasterTree(
+    std::vector<Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>>&
+                               msegs,
+    MoertelT::BoundingBoxTree& mtree)
+{
+  const int mside = MortarSide();
+
+  msegs.clear();
+  msegs.reserve(rseg_[mside].size());
+  std::vector<MoertelT::BoundingBoxTree::Box> mboxes;
+  mboxes.reserve(rseg_[mside].size());
+
+  std::map<int, Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT)>>::
+      iterator mcurr;
+  for (mcurr = rseg_[mside].begin(); mcurr != rseg_[mside].end(); ++mcurr) {
+    msegs.push_back(mcurr->second);
+    mboxes.push_back(SearchBox(*mcurr->second));
+  }
+
+  mtree.Build(mboxes);
+}
+
 #if 0  // old version
 /*----------------------------------------------------------------------*
   | integrate the master/slave side's contribution from the overlap      |
@@ -852,6 +852,8 @@ Topology::splitOpenFaces()
 
   stk::mesh::get_selected_entities(local_bulk, point_buckets, points);
 
+  split_points_.clear();
+
   // Collect open points
   for (stk::mesh::EntityVector::iterator i = points.begin(); i != points.end();
        ++i) {
@@ -1067,6 +1069,8 @@ Topology::splitOpenFaces()
     // Reset fracture state of point
     set_fracture_state(point, CLOSED);
 
+    split_points_.push_back(point);
+
 #if defined(DEBUG_LCM_TOPOLOGY)
     {
       std::string const file_name =
@@ -1086,6 +1090,8 @@ Topology::splitOpenFaces()
       stk::mesh::Entity new_point = j->second;
 
       bulk_data.copy_entity_fields(point, new_point);
+
+      split_points_.push_back(new_point);
     }
   }
 
@@ -209,6 +209,16 @@ public:
   void
   splitOpenFaces();
 
+  ///
+  /// \brief Points split by the last call to splitOpenFaces, both the
+  ///        original points and their new copies.
+  ///
+  stk::mesh::EntityVector const &
+  get_split_points() const
+  {
+    return split_points_;
+  }
+
   void
   insertSurfaceElements(std::set<EntityPair> const & fractured_faces);
 
@@ -895,6 +905,9 @@ private:
   std::set<EntityPair>
   fractured_faces_;
 
+  stk::mesh::EntityVector
+  split_points_;
+
   std::vector<stk::topology>
   topologies_;
 
@@ -12,6 +12,7 @@
 #include "Phalanx_Evaluator_Derived.hpp"
 #include "Phalanx_MDField.hpp"
 #include "Albany_Layouts.hpp"
+#include "Albany_LayeredColumns.hpp"
 
 #include "PHAL_AlbanyTraits.hpp"
 
@@ -40,6 +41,9 @@ public:
 
 protected:
 
+  // Vertical averages of the velocity components on the columns of the workset
+  void computeColumnAverages(typename Traits::EvalData d);
+
 
   typedef typename EvalT::ScalarT ScalarT;
 
@@ -52,6 +56,10 @@ protected:
   std::string meshPart;
 
   Teuchos::RCP<const CellTopologyData> cell_topo;
+
+  Albany::LayeredColumns columns;
+  std::vector<double> columnValues;
+  std::vector<std::vector<double>> columnAverages;
 };
 
 
@@ -58,6 +58,23 @@ postRegistrationSetup(typename Traits::SetupData d,
 }
 
 //**********************************************************************
+template<typename EvalT, typename Traits>
+void GatherVerticallyAveragedVelocityBase<EvalT, Traits>::
+computeColumnAverages(typename Traits::EvalData workset)
+{
+  Teuchos::RCP<const Tpetra_Vector> xT = Albany::getConstTpetraVector(workset.x);
+  Teuchos::ArrayRCP<const ST> xT_constView = xT->get1dView();
+  const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
+
+  columns.update(*workset.disc);
+  columnAverages.resize(vecDimFO);
+  for (std::size_t comp=0; comp<vecDimFO; ++comp) {
+    columns.gather(workset.wsIndex, xT_constView, solDOFManager, comp, columnValues);
+    columns.average(columnValues, columnAverages[comp]);
+  }
+}
+
+//**********************************************************************
 
 
 
@@ -72,9 +89,6 @@ template<typename Traits>
 void GatherVerticallyAveragedVelocity<PHAL::AlbanyTraits::Residual, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
-  Teuchos::RCP<const Tpetra_Vector> xT = Albany::getConstTpetraVector(workset.x);
-  Teuchos::ArrayRCP<const ST> xT_constView = xT->get1dView();
-
   Kokkos::deep_copy(this->averagedVel.get_view(), ScalarT(0.0));
 
   if (workset.sideSets == Teuchos::null)
@@ -86,18 +100,8 @@ evaluateFields(typename Traits::EvalData workset)
   if (it != ssList.end()) {
     const std::vector<Albany::SideStruct>& sideSet = it->second;
 
-    // Loop over the sides that form the boundary condition
-    const Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> >& wsElNodeID  = workset.disc->getWsElNodeID()[workset.wsIndex];
-    const Albany::LayeredMeshNumbering<LO>& layeredMeshNumbering = *workset.disc->getLayeredMeshNumbering();
-    const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
-
-    const Teuchos::ArrayRCP<double>& layers_ratio = layeredMeshNumbering.layers_ratio;
-    int numLayers = layeredMeshNumbering.numLayers;
-
-    Teuchos::ArrayRCP<double> quadWeights(numLayers+1); //doing trapezoidal rule
-    quadWeights[0] = 0.5*layers_ratio[0]; quadWeights[numLayers] = 0.5*layers_ratio[numLayers-1];
-    for(int i=1; i<numLayers; ++i)
-      quadWeights[i] = 0.5*(layers_ratio[i-1] + layers_ratio[i]);
+    // Vertical averages of all the columns of this workset
+    this->computeColumnAverages(workset);
 
     for (std::size_t iSide = 0; iSide < sideSet.size(); ++iSide) { // loop over the sides on this ws and name
       // Get the data that corresponds to the side
@@ -107,21 +111,13 @@ evaluateFields(typename Traits::EvalData workset)
       const CellTopologyData_Subcell& side =  this->cell_topo->side[elem_side];
       int numSideNodes = side.topology->node_count;
 
-      const Teuchos::ArrayRCP<GO>& elNodeID = wsElNodeID[elem_LID];
-
       //we only consider elements on the top.
-      LO baseId, ilayer;
       for (int i = 0; i < numSideNodes; ++i) {
         std::size_t node = side.node[i];
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(elNodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilayer);
+        const int icol = this->columns.columnIndex(workset.wsIndex, elem_LID, node);
         std::vector<double> avVel(this->vecDimFO,0);
-        for(int il=0; il<numLayers+1; ++il)
-        {
-          LO inode = layeredMeshNumbering.getId(baseId, il);
-          for(int comp=0; comp<this->vecDimFO; ++comp)
-            avVel[comp] += xT_constView[solDOFManager.getLocalDOF(inode, comp)]*quadWeights[il];
-        }
+        for(int comp=0; comp<this->vecDimFO; ++comp)
+          avVel[comp] = this->columnAverages[comp][icol];
         for(int comp=0; comp<this->vecDimFO; ++comp)
           this->averagedVel(elem_LID,elem_side,i,comp) = avVel[comp];
       }
@@ -141,9 +137,6 @@ template<typename Traits>
 void GatherVerticallyAveragedVelocity<PHAL::AlbanyTraits::Jacobian, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
-  Teuchos::RCP<const Tpetra_Vector> xT = Albany::getConstTpetraVector(workset.x);
-  Teuchos::ArrayRCP<const ST> xT_constView = xT->get1dView();
-  
   int neq = workset.wsElNodeEqID.extent(2);
 
   if (workset.sideSets == Teuchos::null)
@@ -161,17 +154,9 @@ evaluateFields(typename Traits::EvalData workset)
   if (it != ssList.end()) {
     const std::vector<Albany::SideStruct>& sideSet = it->second;
 
-    // Loop over the sides that form the boundary condition
-    const Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> >& wsElNodeID  = workset.disc->getWsElNodeID()[workset.wsIndex];
-    const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
-
-    const Teuchos::ArrayRCP<double>& layers_ratio = layeredMeshNumbering.layers_ratio;
-
-    Teuchos::ArrayRCP<double> quadWeights(numLayers+1); //doing trapezoidal rule
-
-    quadWeights[0] = 0.5*layers_ratio[0]; quadWeights[numLayers] = 0.5*layers_ratio[numLayers-1];
-    for(int i=1; i<numLayers; ++i)
-      quadWeights[i] = 0.5*(layers_ratio[i-1] + layers_ratio[i]);
+    // Vertical averages of all the columns of this workset
+    this->computeColumnAverages(workset);
+    const std::vector<double>& quadWeights = this->columns.quadWeights();
 
     for (std::size_t iSide = 0; iSide < sideSet.size(); ++iSide) { // loop over the sides on this ws and name
 
@@ -182,21 +167,12 @@ evaluateFields(typename Traits::EvalData workset)
       const CellTopologyData_Subcell& side =  this->cell_topo->side[elem_side];
       int numSideNodes = side.topology->node_count;
 
-      const Teuchos::ArrayRCP<GO>& elNodeID = wsElNodeID[elem_LID];
-      std::vector<double> velx(this->numNodes,0), vely(this->numNodes,0);
-
-      LO baseId, ilayer;
       for (int i = 0; i < numSideNodes; ++i) {
         std::size_t node = side.node[i];
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(elNodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilayer);
+        const int icol = this->columns.columnIndex(workset.wsIndex, elem_LID, node);
         std::vector<double> avVel(this->vecDimFO,0);
-        for(int il=0; il<numLayers+1; ++il)
-        {
-          LO inode = layeredMeshNumbering.getId(baseId, il);
-          for(int comp=0; comp<this->vecDimFO; ++comp)
-            avVel[comp] += xT_constView[solDOFManager.getLocalDOF(inode, comp)]*quadWeights[il];
-        }
+        for(int comp=0; comp<this->vecDimFO; ++comp)
+          avVel[comp] = this->columnAverages[comp][icol];
 
         for(int comp=0; comp<this->vecDimFO; ++comp) {
           this->averagedVel(elem_LID,elem_side,i,comp) = FadType(this->averagedVel(elem_LID,elem_side,i,comp).size(), avVel[comp]);
@@ -219,9 +195,7 @@ template<typename Traits>
 void GatherVerticallyAveragedVelocity<PHAL::AlbanyTraits::Tangent, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
-  Teuchos::RCP<const Tpetra_Vector> xT = Albany::getConstTpetraVector(workset.x);
   Teuchos::RCP<const Tpetra_MultiVector> VxT = Albany::getConstTpetraMultiVector(workset.Vx);
-  Teuchos::ArrayRCP<const ST> xT_constView = xT->get1dView();
 
 
   Kokkos::deep_copy(this->averagedVel.get_view(), ScalarT(0.0));
@@ -235,18 +209,8 @@ evaluateFields(typename Traits::EvalData workset)
   if (it != ssList.end()) {
     const std::vector<Albany::SideStruct>& sideSet = it->second;
 
-    // Loop over the sides that form the boundary condition
-    const Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> >& wsElNodeID  = workset.disc->getWsElNodeID()[workset.wsIndex];
-    const Albany::LayeredMeshNumbering<LO>& layeredMeshNumbering = *workset.disc->getLayeredMeshNumbering();
-    const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
-
-    const Teuchos::ArrayRCP<double>& layers_ratio = layeredMeshNumbering.layers_ratio;
-    int numLayers = layeredMeshNumbering.numLayers;
-
-    Teuchos::ArrayRCP<double> quadWeights(numLayers+1); //doing trapezoidal rule
-    quadWeights[0] = 0.5*layers_ratio[0]; quadWeights[numLayers] = 0.5*layers_ratio[numLayers-1];
-    for(int i=1; i<numLayers; ++i)
-      quadWeights[i] = 0.5*(layers_ratio[i-1] + layers_ratio[i]);
+    // Vertical averages of all the columns of this workset
+    this->computeColumnAverages(workset);
 
     for (std::size_t iSide = 0; iSide < sideSet.size(); ++iSide) { // loop over the sides on this ws and name
       // Get the data that corresponds to the side
@@ -256,21 +220,13 @@ evaluateFields(typename Traits::EvalData workset)
       const CellTopologyData_Subcell& side =  this->cell_topo->side[elem_side];
       int numSideNodes = side.topology->node_count;
 
-      const Teuchos::ArrayRCP<GO>& elNodeID = wsElNodeID[elem_LID];
-
       //we only consider elements on the top.
-      LO baseId, ilayer;
       for (int i = 0; i < numSideNodes; ++i) {
         std::size_t node = side.node[i];
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(elNodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilayer);
+        const int icol = this->columns.columnIndex(workset.wsIndex, elem_LID, node);
         std::vector<double> avVel(this->vecDimFO,0);
-        for(int il=0; il<numLayers+1; ++il)
-        {
-          LO inode = layeredMeshNumbering.getId(baseId, il);
-          for(int comp=0; comp<this->vecDimFO; ++comp)
-            avVel[comp] += xT_constView[solDOFManager.getLocalDOF(inode, comp)]*quadWeights[il];
-        }
+        for(int comp=0; comp<this->vecDimFO; ++comp)
+          avVel[comp] = this->columnAverages[comp][icol];
         for(int comp=0; comp<this->vecDimFO; ++comp) {
           this->averagedVel(elem_LID,elem_side,i,comp) = avVel[comp];
           if (VxT != Teuchos::null && workset.j_coeff != 0.0) {
@@ -294,9 +250,6 @@ template<typename Traits>
 void GatherVerticallyAveragedVelocity<PHAL::AlbanyTraits::DistParamDeriv, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
-  Teuchos::RCP<const Tpetra_Vector> xT = Albany::getConstTpetraVector(workset.x);
-  Teuchos::ArrayRCP<const ST> xT_constView = xT->get1dView();
-
   Kokkos::deep_copy(this->averagedVel.get_view(), ScalarT(0.0));
 
   if (workset.sideSets == Teuchos::null)
@@ -308,18 +261,8 @@ evaluateFields(typename Traits::EvalData workset)
   if (it != ssList.end()) {
     const std::vector<Albany::SideStruct>& sideSet = it->second;
 
-    // Loop over the sides that form the boundary condition
-    const Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> >& wsElNodeID  = workset.disc->getWsElNodeID()[workset.wsIndex];
-    const Albany::LayeredMeshNumbering<LO>& layeredMeshNumbering = *workset.disc->getLayeredMeshNumbering();
-    const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
-
-    const Teuchos::ArrayRCP<double>& layers_ratio = layeredMeshNumbering.layers_ratio;
-    int numLayers = layeredMeshNumbering.numLayers;
-
-    Teuchos::ArrayRCP<double> quadWeights(numLayers+1); //doing trapezoidal rule
-    quadWeights[0] = 0.5*layers_ratio[0]; quadWeights[numLayers] = 0.5*layers_ratio[numLayers-1];
-    for(int i=1; i<numLayers; ++i)
-      quadWeights[i] = 0.5*(layers_ratio[i-1] + layers_ratio[i]);
+    // Vertical averages of all the columns of this workset
+    this->computeColumnAverages(workset);
 
     for (std::size_t iSide = 0; iSide < sideSet.size(); ++iSide) { // loop over the sides on this ws and name
       // Get the data that corresponds to the side
@@ -329,21 +272,13 @@ evaluateFields(typename Traits::EvalData workset)
       const CellTopologyData_Subcell& side =  this->cell_topo->side[elem_side];
       int numSideNodes = side.topology->node_count;
 
-      const Teuchos::ArrayRCP<GO>& elNodeID = wsElNodeID[elem_LID];
-
       //we only consider elements on the top.
-      LO baseId, ilayer;
       for (int i = 0; i < numSideNodes; ++i) {
         std::size_t node = side.node[i];
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(elNodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilayer);
+        const int icol = this->columns.columnIndex(workset.wsIndex, elem_LID, node);
         std::vector<double> avVel(this->vecDimFO,0);
-        for(int il=0; il<numLayers+1; ++il)
-        {
-          LO inode = layeredMeshNumbering.getId(baseId, il);
-          for(int comp=0; comp<this->vecDimFO; ++comp)
-            avVel[comp] += xT_constView[solDOFManager.getLocalDOF(inode, comp)]*quadWeights[il];
-        }
+        for(int comp=0; comp<this->vecDimFO; ++comp)
+          avVel[comp] = this->columnAverages[comp][icol];
         for(int comp=0; comp<this->vecDimFO; ++comp)
           this->averagedVel(elem_LID,elem_side,i,comp) = avVel[comp];
       }
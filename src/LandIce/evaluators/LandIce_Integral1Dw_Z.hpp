@@ -13,6 +13,7 @@
 #include "Phalanx_Evaluator_Derived.hpp"
 #include "Phalanx_MDField.hpp"
 #include "Albany_Layouts.hpp"
+#include "Albany_LayeredColumns.hpp"
 
 #include "PHAL_AlbanyTraits.hpp"
 #include "Albany_SacadoTypes.hpp"
@@ -61,6 +62,10 @@ protected:
   bool StokesThermoCoupled;
 
   int offset, neq;
+
+  // Column tables, and w_z integrated along the columns of the workset
+  Albany::LayeredColumns columns;
+  std::vector<double>    int1D;
 };
 
 template<typename EvalT, typename Traits, typename ThicknessScalarT>
@@ -95,48 +95,25 @@ evaluateFields(typename Traits::EvalData workset)
 
     Kokkos::deep_copy(this->int1Dw_z.get_view(), ScalarT(0.0));
 
-    const Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> >& wsElNodeID  = workset.disc->getWsElNodeID()[workset.wsIndex];
-
-    const Albany::LayeredMeshNumbering<LO>& layeredMeshNumbering = *workset.disc->getLayeredMeshNumbering();
     const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
-    const Teuchos::ArrayRCP<double>& layers_ratio = layeredMeshNumbering.layers_ratio;
-    LO baseId, ilayer;
-    std::map<LO,std::pair<std::size_t,std::size_t> > basalCellsMap;
-
-    for ( std::size_t cell = 0; cell < workset.numCells; ++cell )
-    {
-      const Teuchos::ArrayRCP<GO>& nodeID = wsElNodeID[cell];
-
-      for (std::size_t node = 0; node < this->numNodes; ++node)
-      {
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(nodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilayer);
-
-        if(ilayer==0)
-          basalCellsMap[baseId]= std::make_pair(cell,node);
 
-        double int1D = 0;
-
-        for (int il = 0; il < ilayer; ++il)
-        {
-          LO inode0 = layeredMeshNumbering.getId(baseId, il);
-          LO inode1 = layeredMeshNumbering.getId(baseId, il+1);
-          int1D += 0.5 * ( xT_constView[solDOFManager.getLocalDOF(inode0, this->offset)] + xT_constView[solDOFManager.getLocalDOF(inode1, this->offset)] ) * layers_ratio[il];
-        }
-
-        this->int1Dw_z(cell,node) = int1D * this->thickness(cell,node);
-      }
-    }
+    // Integrate w_z along the columns of this workset, all levels at once
+    Albany::LayeredColumns& columns = this->columns;
+    columns.update(*workset.disc);
+    columns.gather(workset.wsIndex, xT_constView, solDOFManager, this->offset, this->int1D);
+    columns.integrate(this->int1D);
+    const int numLevels = columns.numLevels();
 
     for ( std::size_t cell = 0; cell < workset.numCells; ++cell )
     {
-      const Teuchos::ArrayRCP<GO>& nodeID = wsElNodeID[cell];
-
       for (std::size_t node = 0; node < this->numNodes; ++node)
       {
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(nodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilayer);
-        this->int1Dw_z(cell,node) += this->basal_velocity(basalCellsMap[baseId].first, basalCellsMap[baseId].second);
+        const int icol = columns.columnIndex(workset.wsIndex, cell, node);
+        const int ilayer = columns.level(workset.wsIndex, cell, node);
+        const std::pair<int,int>& basal = columns.basalNode(workset.wsIndex, icol);
+
+        this->int1Dw_z(cell,node) = this->int1D[icol*numLevels+ilayer] * this->thickness(cell,node);
+        this->int1Dw_z(cell,node) += this->basal_velocity(basal.first, basal.second);
       }
     }
 }
@@ -158,75 +135,44 @@ evaluateFields(typename Traits::EvalData workset)
 
     Kokkos::deep_copy(this->int1Dw_z.get_view(), ScalarT(0.0));
 
-    const Teuchos::ArrayRCP<Teuchos::ArrayRCP<GO> >& wsElNodeID  = workset.disc->getWsElNodeID()[workset.wsIndex];
-
-    const Albany::LayeredMeshNumbering<LO>& layeredMeshNumbering = *workset.disc->getLayeredMeshNumbering();
     const Albany::NodalDOFManager& solDOFManager = workset.disc->getOverlapDOFManager("ordinary_solution");
+    const Teuchos::ArrayRCP<double>& layers_ratio = workset.disc->getLayeredMeshNumbering()->layers_ratio;
 
-    const Teuchos::ArrayRCP<double>& layers_ratio = layeredMeshNumbering.layers_ratio;
-
-    LO baseId, ilevel, baseId_curr, ilevel_curr;
-    std::map<LO,std::pair<std::size_t,std::size_t> > basalCellsMap;
-
-    for ( std::size_t cell = 0; cell < workset.numCells; ++cell )
-    {
-      const Teuchos::ArrayRCP<GO>& nodeID = wsElNodeID[cell];
-
-      for (std::size_t node = 0; node < this->numNodes; ++node)
-      {
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(nodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilevel);
-
-        if(ilevel==0)
-          basalCellsMap[baseId]= std::make_pair(cell,node);
-
-        double int1D = 0;
-
-        for (int il = 0; il < ilevel; ++il)
-        {
-          LO inode0 = layeredMeshNumbering.getId(baseId, il);
-          LO inode1 = layeredMeshNumbering.getId(baseId, il+1);
-          int1D += 0.5 * ( xT_constView[solDOFManager.getLocalDOF(inode0, this->offset)] + xT_constView[solDOFManager.getLocalDOF(inode1, this->offset)] ) * layers_ratio[il];
-        }
-
-        this->int1Dw_z(cell,node) = FadType(this->int1Dw_z(cell,node).size(), int1D);
-      }
-    }
+    // Integrate w_z along the columns of this workset, all levels at once
+    Albany::LayeredColumns& columns = this->columns;
+    columns.update(*workset.disc);
+    columns.gather(workset.wsIndex, xT_constView, solDOFManager, this->offset, this->int1D);
+    columns.integrate(this->int1D);
+    const int numLevels = columns.numLevels();
 
     for ( std::size_t cell = 0; cell < workset.numCells; ++cell )
     {
-      const Teuchos::ArrayRCP<GO>& nodeID = wsElNodeID[cell];
-
       for (std::size_t node = 0; node < this->numNodes; ++node)
       {
-        LO lnodeId = workset.disc->getOverlapNodeMapT()->getLocalElement(nodeID[node]);
-        layeredMeshNumbering.getIndices(lnodeId, baseId, ilevel);
+        const int icol = columns.columnIndex(workset.wsIndex, cell, node);
+        const int ilevel = columns.level(workset.wsIndex, cell, node);
+        const std::pair<int,int>& basal = columns.basalNode(workset.wsIndex, icol);
 
+        this->int1Dw_z(cell,node) = FadType(this->int1Dw_z(cell,node).size(), this->int1D[icol*numLevels+ilevel]);
 
         // TODO implement the derivative for the extra term mb
         for (std::size_t node_curr = 0; node_curr < this->numNodes; ++node_curr)
+        {
+          if (columns.columnIndex(workset.wsIndex, cell, node_curr) == icol)
           {
-            LO lnodeId_curr = nodeID[node_curr];
-              layeredMeshNumbering.getIndices(lnodeId_curr, baseId_curr, ilevel_curr);
-              if (baseId_curr == baseId)
-              {
-                int idx = this->neq * node_curr + this->offset;
-                //int idx = this->offset * this->numNodes + node_curr;
-
-                if(ilevel_curr == ilevel - 1)
-                  this->int1Dw_z(cell,node).fastAccessDx(idx) = 0.5 * layers_ratio[ilevel_curr] * workset.j_coeff;
-
-                if( ((ilevel_curr == ilevel)||(ilevel_curr == ilevel - 1))&&(ilevel_curr > 0) )
-                  this->int1Dw_z(cell,node).fastAccessDx(idx) += 0.5 * layers_ratio[ilevel_curr - 1] * workset.j_coeff;
-              }
+            const int ilevel_curr = columns.level(workset.wsIndex, cell, node_curr);
+            int idx = this->neq * node_curr + this->offset;
+
+            if(ilevel_curr == ilevel - 1)
+              this->int1Dw_z(cell,node).fastAccessDx(idx) = 0.5 * layers_ratio[ilevel_curr] * workset.j_coeff;
+
+            if( ((ilevel_curr == ilevel)||(ilevel_curr == ilevel - 1))&&(ilevel_curr > 0) )
+              this->int1Dw_z(cell,node).fastAccessDx(idx) += 0.5 * layers_ratio[ilevel_curr - 1] * workset.j_coeff;
           }
+        }
 
         this->int1Dw_z(cell,node) *= this->thickness(cell,node);
-
-          if (0)//lnodeId == baseId)
-            this->int1Dw_z(cell,node) += this->basal_velocity(basalCellsMap[baseId].first, basalCellsMap[baseId].second);
-          else
-            this->int1Dw_z(cell,node) += Albany::ADValue(this->basal_velocity(basalCellsMap[baseId].first, basalCellsMap[baseId].second));
+        this->int1Dw_z(cell,node) += Albany::ADValue(this->basal_velocity(basal.first, basal.second));
       }
     }
 }
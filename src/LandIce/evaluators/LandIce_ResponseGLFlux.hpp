@@ -18,7 +18,8 @@ namespace LandIce {
  */
   template<typename EvalT, typename Traits>
   class ResponseGLFlux :
-    public PHAL::SeparableScatterScalarResponse<EvalT,Traits>
+    public PHAL::SeparableScatterScalarResponse<EvalT,Traits>,
+    public PHAL::SumOverRanksResponse
   {
   public:
     typedef typename EvalT::ScalarT ScalarT;
@@ -442,7 +442,10 @@ postRegistrationSetup(typename Traits::SetupData d,
   this->utils.setFieldData(force,fm);
 
   d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields());
-  if (d.memoizer_active()) memoizer.enable_memoizer();
+  if (d.memoizer_active()) {
+    memoizer.enable_memoizer();
+    memoizer.memoize_field(force);
+  }
 }
 
 //**********************************************************************
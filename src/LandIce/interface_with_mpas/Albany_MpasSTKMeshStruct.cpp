@@ -739,6 +739,8 @@ Albany::MpasSTKMeshStruct::getValidDiscretizationParameters() const
 {
   Teuchos::RCP<Teuchos::ParameterList> validPL =
     this->getValidGenericSTKParameters("Valid ASCII_DiscParams");
+  validPL->set<bool>("Persistent Session", false,
+      "Keep the discretization and the solver across calls from MPAS");
 
   return validPL;
 }
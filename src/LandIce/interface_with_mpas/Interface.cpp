@@ -14,6 +14,8 @@
 #include "Teuchos_RCP.hpp"
 #include "Albany_Utils.hpp"
 #include "Albany_SolverFactory.hpp"
+#include "Albany_ModelEvaluatorT.hpp"
+#include "Albany_TpetraThyraUtils.hpp"
 #include "Teuchos_XMLParameterListHelpers.hpp"
 #include "Teuchos_StandardCatchMacros.hpp"
 #include <stk_mesh/base/FieldBase.hpp>
@@ -49,6 +51,14 @@ bool MPAS_useGLP(true);
 #endif
 bool keptMesh =false;
 
+// Persistent session: the discretization, the solver (with its Jacobian and
+// preconditioner) and the solution importer are kept across MPAS calls as
+// long as only the geometry and the input fields change.
+bool persistentSession = false;
+std::string keptSolverType;
+Teuchos::RCP<Tpetra_Import> solutionImport;
+Teuchos::RCP<Tpetra_Vector> overlapSolution;
+
 typedef struct TET_ {
   int verts[4];
   int neighbours[4];
@@ -202,24 +212,57 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
 
 
 
-  if(!keptMesh) {
+  // When the mesh is kept and the solver setup does not change, the existing
+  // solver can be reused. The element fields above are views of the STK mesh
+  // data used by the worksets, but the nodal ones (surface height, thickness,
+  // basal friction, ...) are copied to the worksets, so they are copied again
+  // together with the coordinates. The memoized fields and the initial guess
+  // need to be updated too.
+  const std::string solverType = paramList->sublist("Piro").get("Solver Type", "NOX");
+  Teuchos::RCP<Albany::ModelEvaluatorT> model = Teuchos::nonnull(slvrfctry) ?
+      Teuchos::rcp_dynamic_cast<Albany::ModelEvaluatorT>(slvrfctry->returnModelT()) : Teuchos::null;
+  const bool reuseSolver = persistentSession && keptMesh && Teuchos::nonnull(solver) &&
+      Teuchos::nonnull(model) &&
+      (solverType == "NOX") && (keptSolverType == solverType) &&
+      albanyApp->getDiscretization()->getSideSetDiscretizations().empty();
+
+  if (reuseSolver) {
+    // The coordinates were moved and the input fields changed: redo what
+    // updateMesh does with them, and drop the memoized data of the old
+    // geometry and input fields.
+    auto stk_disc = Teuchos::rcp_dynamic_cast<Albany::STKDiscretization>(albanyApp->getDiscretization());
+    stk_disc->updateCoordinates();
+    albanyApp->invalidateMemoizedFields();
+
+    // Warm start: the solution field holds the velocity passed by MPAS.
+    Teuchos::RCP<const Tpetra_Vector> initialGuess = stk_disc->getSolutionFieldT();
+    ConverterT::getTpetraVector(albanyApp->getAdaptSolMgrT()->getCurrentSolution()->col(0))->assign(*initialGuess);
+    Thyra::ModelEvaluatorBase::InArgs<ST> nominalValues = model->getNominalValues();
+    Teuchos::RCP<Tpetra_Vector> x = Teuchos::rcp(new Tpetra_Vector(*initialGuess, Teuchos::Copy));
+    nominalValues.set_x(Albany::createThyraVector(x));
+    model->setNominalValues(nominalValues);
+  } else if(!keptMesh) {
     albanyApp->createDiscretization();
   } else {
     auto abs_disc = albanyApp->getDiscretization();
     auto stk_disc = Teuchos::rcp_dynamic_cast<Albany::STKDiscretization>(abs_disc);
     stk_disc->updateMesh();
   }
-  albanyApp->finalSetUp(paramList);
+  if (!reuseSolver)
+    albanyApp->finalSetUp(paramList);
 
   bool success = true;
   Teuchos::ArrayRCP<const ST> solution_constView;
   Teuchos::RCP<const Tpetra_Map> overlapMap;
   try {
+  if (!reuseSolver) {
 #ifdef MPAS_USE_EPETRA
-  solver = slvrfctry->createThyraSolverAndGetAlbanyApp(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
+    solver = slvrfctry->createThyraSolverAndGetAlbanyApp(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
 #else
-   solver = slvrfctry->createAndGetAlbanyAppT(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
+    solver = slvrfctry->createAndGetAlbanyAppT(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
 #endif
+    keptSolverType = solverType;
+  }
 
   Teuchos::ParameterList solveParams;
   solveParams.set("Compute Sensitivities", false);
@@ -240,10 +283,14 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
   }
 
   overlapMap = albanyApp->getDiscretization()->getOverlapMapT();
-  Teuchos::RCP<Tpetra_Import> import = Teuchos::rcp(new Tpetra_Import(albanyApp->getDiscretization()->getMapT(), overlapMap));
-  Teuchos::RCP<Tpetra_Vector> solution = Teuchos::rcp(new Tpetra_Vector(overlapMap));
-  solution->doImport(*albanyApp->getDiscretization()->getSolutionFieldT(), *import, Tpetra::INSERT);
-  solution_constView = solution->get1dView();
+  Teuchos::RCP<const Tpetra_Map> map = albanyApp->getDiscretization()->getMapT();
+  if (solutionImport.is_null() || solutionImport->getSourceMap() != map ||
+      solutionImport->getTargetMap() != overlapMap) {
+    solutionImport = Teuchos::rcp(new Tpetra_Import(map, overlapMap));
+    overlapSolution = Teuchos::rcp(new Tpetra_Vector(overlapMap));
+  }
+  overlapSolution->doImport(*albanyApp->getDiscretization()->getSolutionFieldT(), *solutionImport, Tpetra::INSERT);
+  solution_constView = overlapSolution->get1dView();
   }
   TEUCHOS_STANDARD_CATCH_STATEMENTS(true, std::cerr, success);
 
@@ -312,6 +359,8 @@ void velocity_solver_finalize() {
   slvrfctry = Teuchos::null;
   MPAS_dt = Teuchos::null;
   solver = Teuchos::null;
+  solutionImport = Teuchos::null;
+  overlapSolution = Teuchos::null;
   Kokkos::finalize_all();
 }
 
@@ -327,6 +376,8 @@ void velocity_solver_finalize() {
 
 void velocity_solver_compute_2d_grid(MPI_Comm reducedComm) {
   keptMesh = false;
+  solutionImport = Teuchos::null;
+  overlapSolution = Teuchos::null;
   mpiCommT = Albany::createTeuchosCommFromMpiComm(reducedComm);
 }
 
@@ -461,6 +512,7 @@ void velocity_solver_extrude_3d_grid(int nLayers, int nGlobalTriangles,
   discretizationList.set("Method", discretizationList.get("Method", "Extruded")); //set to Extruded is not defined
   discretizationList.set("Cubature Degree", discretizationList.get("Cubature Degree", 1));  //set 1 if not defined
   discretizationList.set("Interleaved Ordering", discretizationList.get("Interleaved Ordering", true));  //set true if not define
+  persistentSession = discretizationList.get("Persistent Session", false);  //reuse the solver across calls
   
   discretizationList.sublist("Required Fields Info").set<int>("Number Of Fields",9);
   Teuchos::ParameterList& field0 = discretizationList.sublist("Required Fields Info").sublist("Field 0");
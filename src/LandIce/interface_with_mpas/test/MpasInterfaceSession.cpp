@@ -0,0 +1,284 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+// Drives the MPAS velocity solver interface like MPAS does, on a small
+// structured basal mesh: two solves in one session with different
+// geometry and input fields, then the second solve again in a fresh
+// session. With "Persistent Session: true" the second solve reuses the
+// solver of the first one, and must still give the velocity of the fresh
+// session. Reads albany_input.yaml from the working directory.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "Interface.hpp"
+
+// Declared with Fortran pointers in Interface.hpp, defined with MPI_Comm
+void velocity_solver_compute_2d_grid(MPI_Comm reducedComm);
+
+// Provided by MPAS: the ranks sharing a basal vertex. None, on one rank.
+void procsSharingVertex(const int vertex, std::vector<int>& procIds)
+{
+  procIds.clear();
+}
+
+namespace {
+
+int const num_cells_1d = 4;
+int const num_vertices_1d = num_cells_1d + 1;
+int const num_layers = 3;
+double const cell_size = 5.0; // km
+
+//
+// Basal mesh: each square of a structured grid split in two triangles,
+// with the edges, and the triangles on each edge, as MPAS numbers them
+//
+struct BasalMesh
+{
+  std::vector<int> vertex_ids;
+  std::vector<double> coords;
+  std::vector<bool> is_boundary_vertex;
+  std::vector<int> vertices_on_tria;
+  std::vector<int> triangle_ids;
+  std::vector<int> vertices_on_edge;
+  std::vector<int> triangles_on_edge;
+  std::vector<int> triangle_positions_on_edge;
+  std::vector<bool> is_boundary_edge;
+  std::vector<int> edge_ids;
+};
+
+BasalMesh
+buildBasalMesh()
+{
+  BasalMesh mesh;
+
+  for (int j = 0; j < num_vertices_1d; ++j) {
+    for (int i = 0; i < num_vertices_1d; ++i) {
+      mesh.vertex_ids.push_back(i + num_vertices_1d * j);
+      mesh.coords.push_back(cell_size * i);
+      mesh.coords.push_back(cell_size * j);
+      mesh.coords.push_back(0.0);
+      mesh.is_boundary_vertex.push_back(
+          i == 0 || j == 0 || i == num_cells_1d || j == num_cells_1d);
+    }
+  }
+
+  for (int j = 0; j < num_cells_1d; ++j) {
+    for (int i = 0; i < num_cells_1d; ++i) {
+      int const v0 = i + num_vertices_1d * j;
+      int const v1 = v0 + 1;
+      int const v2 = v1 + num_vertices_1d;
+      int const v3 = v0 + num_vertices_1d;
+      int const triangles[2][3] = {{v0, v1, v2}, {v0, v2, v3}};
+      for (auto const& t : triangles) {
+        mesh.triangle_ids.push_back(mesh.triangle_ids.size());
+        mesh.vertices_on_tria.insert(mesh.vertices_on_tria.end(), t, t + 3);
+      }
+    }
+  }
+
+  // Edge k of a triangle joins its vertices k and k+1
+  std::map<std::pair<int, int>, int> edge_index;
+  int const num_triangles = mesh.triangle_ids.size();
+  for (int t = 0; t < num_triangles; ++t) {
+    for (int k = 0; k < 3; ++k) {
+      int const a = mesh.vertices_on_tria[3 * t + k];
+      int const b = mesh.vertices_on_tria[3 * t + (k + 1) % 3];
+      auto const key = std::make_pair(std::min(a, b), std::max(a, b));
+      auto it = edge_index.find(key);
+      if (it == edge_index.end()) {
+        int const e = mesh.edge_ids.size();
+        edge_index[key] = e;
+        mesh.edge_ids.push_back(e);
+        mesh.vertices_on_edge.push_back(a);
+        mesh.vertices_on_edge.push_back(b);
+        mesh.triangles_on_edge.push_back(t);
+        mesh.triangles_on_edge.push_back(-1);
+        mesh.triangle_positions_on_edge.push_back(k);
+        mesh.triangle_positions_on_edge.push_back(-1);
+        mesh.is_boundary_edge.push_back(true);
+      } else {
+        int const e = it->second;
+        mesh.triangles_on_edge[2 * e + 1] = t;
+        mesh.triangle_positions_on_edge[2 * e + 1] = k;
+        mesh.is_boundary_edge[e] = false;
+      }
+    }
+  }
+
+  return mesh;
+}
+
+//
+// Geometry and input fields of one MPAS call
+//
+struct Inputs
+{
+  double thickness;
+  double bed_slope;
+  double beta;
+  double stiffening_factor;
+  double temperature;
+};
+
+//
+// Call the velocity solver and return the velocity on the 3D vertices
+//
+std::vector<double>
+solve(
+    BasalMesh const& mesh,
+    Inputs const& inputs,
+    bool const first_time_step,
+    std::vector<double> const& initial_velocity,
+    int& error)
+{
+  int const num_vertices = mesh.vertex_ids.size();
+  int const num_triangles = mesh.triangle_ids.size();
+
+  std::vector<double> levels(num_layers + 1);
+  for (int il = 0; il <= num_layers; ++il) {
+    levels[il] = double(il) / num_layers;
+  }
+
+  std::vector<double> thickness(num_vertices, inputs.thickness);
+  std::vector<double> elevation(num_vertices);
+  std::vector<double> bed(num_vertices);
+  for (int v = 0; v < num_vertices; ++v) {
+    bed[v] = 0.2 - inputs.bed_slope * mesh.coords[3 * v];
+    elevation[v] = bed[v] + thickness[v];
+  }
+  std::vector<double> beta(num_vertices, inputs.beta);
+  std::vector<double> smb(num_vertices, 0.0);
+  std::vector<double> stiffening(num_vertices, inputs.stiffening_factor);
+  std::vector<double> regul_thickness(num_vertices, 1.0e-4);
+  std::vector<double> effective_pressure;
+  std::vector<double> temperature(
+      3 * num_layers * num_triangles, inputs.temperature);
+  std::vector<double> dissipation_heat(temperature.size(), 0.0);
+
+  std::vector<double> velocity(initial_velocity);
+
+  velocity_solver_solve_fo(
+      num_layers, num_vertices, num_triangles, false, first_time_step,
+      mesh.vertex_ids, mesh.triangle_ids, 1.0e-5, regul_thickness, levels,
+      elevation, thickness, beta, bed, smb, stiffening, effective_pressure,
+      temperature, dissipation_heat, velocity, error);
+
+  return velocity;
+}
+
+//
+// Start a session: build the Albany application and the mesh
+//
+void
+startSession(BasalMesh const& mesh)
+{
+  velocity_solver_compute_2d_grid(MPI_COMM_WORLD);
+
+  std::vector<int> const dirichlet_node_ids;
+  std::vector<int> const floating_edge_ids;
+
+  velocity_solver_extrude_3d_grid(
+      num_layers, mesh.triangle_ids.size(), mesh.vertex_ids.size(),
+      mesh.edge_ids.size(), 0, MPI_COMM_WORLD, mesh.vertex_ids,
+      mesh.vertex_ids, mesh.coords, mesh.is_boundary_vertex,
+      mesh.vertices_on_tria, mesh.is_boundary_edge, mesh.triangles_on_edge,
+      mesh.triangle_positions_on_edge, mesh.vertices_on_edge, mesh.edge_ids,
+      mesh.triangle_ids, dirichlet_node_ids, floating_edge_ids);
+}
+
+double
+maxAbsDifference(std::vector<double> const& a, std::vector<double> const& b)
+{
+  double diff = 0.0;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    diff = std::max(diff, std::abs(a[i] - b[i]));
+  }
+  return diff;
+}
+
+double
+maxAbs(std::vector<double> const& a)
+{
+  double value = 0.0;
+  for (auto const x : a) value = std::max(value, std::abs(x));
+  return value;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  int status = 0;
+  {
+    int fortran_comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+    velocity_solver_init_mpi(&fortran_comm);
+    velocity_solver_set_physical_parameters(
+        9.8, 910.0, 1028.0, 0.0, 1.0e-4, 3.0, 1.0e-2, true, 9.7546e-8);
+
+    BasalMesh const mesh = buildBasalMesh();
+
+    Inputs const first = {0.5, 0.002, 5.0, 1.0, 253.0};
+    Inputs const second = {0.6, 0.003, 2.0, 0.8, 263.0};
+
+    std::vector<double> const zero(
+        2 * (num_layers + 1) * mesh.vertex_ids.size(), 0.0);
+
+    int error = 0;
+
+    // Persistent session: the second call changes every input field
+    startSession(mesh);
+    std::vector<double> const velocity_first =
+        solve(mesh, first, true, zero, error);
+    status += error;
+    std::vector<double> const velocity_session =
+        solve(mesh, second, false, velocity_first, error);
+    status += error;
+
+    // Fresh session, from the same initial guess
+    startSession(mesh);
+    std::vector<double> const velocity_fresh =
+        solve(mesh, second, false, velocity_first, error);
+    status += error;
+
+    double const scale = maxAbs(velocity_fresh);
+    double const session_diff =
+        maxAbsDifference(velocity_session, velocity_fresh);
+    double const inputs_diff = maxAbsDifference(velocity_first, velocity_fresh);
+
+    std::cout << "Max velocity: " << scale << "\n";
+    std::cout << "Max difference, reused and fresh session: " << session_diff
+              << "\n";
+    std::cout << "Max difference, first and second inputs: " << inputs_diff
+              << "\n";
+
+    // The inputs must change the velocity, or the test proves nothing
+    double const tol = 1.0e-6;
+    if (!(scale > 0.0) || !(inputs_diff > 1.0e3 * tol * scale)) {
+      std::cout << "The two inputs give the same velocity\n";
+      ++status;
+    }
+    if (!(session_diff <= tol * scale)) {
+      std::cout << "The reused session does not match the fresh one\n";
+      ++status;
+    }
+
+    velocity_solver_finalize();
+  }
+  MPI_Finalize();
+
+  std::cout << (status == 0 ? "TEST PASSED" : "TEST FAILED") << std::endl;
+  return status == 0 ? 0 : 1;
+}
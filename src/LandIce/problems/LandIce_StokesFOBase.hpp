@@ -367,6 +367,9 @@ void StokesFOBase::constructStatesEvaluators (PHX::FieldManager<PHAL::AlbanyTrai
       if (fieldUsage == "Input" || fieldUsage == "Input-Output") {
         // Not a parameter but still required as input: load it.
         p->set<std::string>("Field Name", fieldName);
+        // Input-only fields (e.g., surface height and flow factor) do not
+        // change during a solve, so the loaded data can be memoized
+        p->set<bool>("Memoize", fieldUsage == "Input");
         if (field_scalar_type[stateName]==FieldScalarType::ParamScalar) {
           ev = Teuchos::rcp(new PHAL::LoadStateFieldPST<EvalT,PHAL::AlbanyTraits>(*p));
         } else if (field_scalar_type[stateName]==FieldScalarType::MeshScalar) {
@@ -558,6 +558,8 @@ main(int argc, char *argv[]) {
         Albany::writeMatrixMarket(xfinal->space(),"xfinal_distributed_map");
       }
     }
+
+    app->writeEvaluatorProfile();
   }
   TEUCHOS_STANDARD_CATCH_STATEMENTS(true, std::cerr, success);
   if (!success) status += 10000;
@@ -383,6 +383,7 @@ MPMD_App::compute(const std::string & noOp)
 void MPMD_App::finalize()
 /******************************************************************************/
 {
+  m_app->writeEvaluatorProfile();
   Kokkos::finalize_all();
 }
 
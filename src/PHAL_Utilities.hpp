@@ -7,6 +7,14 @@
 #ifndef PHAL_UTILITIES
 #define PHAL_UTILITIES
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "Albany_CommTypes.hpp"
 
 #include "Teuchos_RCP.hpp"
@@ -212,13 +220,19 @@ struct ExtendLayout
   }
 };
 
-/* In the case of a single workset, an MDField may not need to be recomputed.
- * Currently, this memoizer (which is not really a true memoizer) checks to 
- * see whether the workset index has changed in order to determine whether an 
- * MDField has to be recomputed.
+/* MDFieldMemoizer skips the evaluation of MDFields that do not depend on the
+ * solution, as determined from the field dependencies gathered by PHAL::Setup.
  *
- * WARNING: Use with caution. This class should not be used if an MDField
- * changes within the lifetime of the object.
+ * If the workset index has not changed since the last evaluation, the
+ * evaluated MDFields still hold the right data and nothing has to be done.
+ * Evaluators can also register their evaluated MDFields with memoize_field().
+ * The data of registered MDFields is then saved for every workset, keyed by
+ * workset index and field, and copied back when the workset is evaluated
+ * again. Saved data is discarded if the connectivity or the number of cells
+ * of the workset changes (e.g. after mesh adaptation), or if the memoizer
+ * generation of the workset changes. The Application bumps it when the
+ * coordinates or the parameter values change, or when the input fields are
+ * reloaded (Application::invalidateMemoizedFields).
  */
 template<typename Traits>
 class MDFieldMemoizer {
@@ -227,38 +241,105 @@ public:
   //! Constructor
   MDFieldMemoizer() :
     _enableMemoizer(false),
-    _prevWorksetIndex(-1) {
+    _prevWorksetIndex(-1),
+    _pendingWorksetIndex(-1) {
   }
 
-  //! Enable memoizer
+  //! Enable memoizer (discards registered MDFields and saved data)
   void enable_memoizer() {
     _enableMemoizer = true;
+    _prevWorksetIndex = -1;
+    _pendingWorksetIndex = -1;
+    _fields.clear();
+    _savedWorksets.clear();
+  }
+
+  //! Save the data of an evaluated MDField for every workset
+  //! (call after the field data has been set in postRegistrationSetup)
+  template<typename FieldT>
+  void memoize_field(const FieldT& field) {
+    if (!_enableMemoizer) return;
+
+    typedef typename std::decay<decltype(field.get_view())>::type ViewT;
+    typedef typename ViewT::HostMirror SavedViewT;
+
+    const ViewT view = field.get_view();
+    const auto saved = std::make_shared<std::map<int,SavedViewT>>();
+
+    SavedField savedField;
+    savedField.save = [view,saved] (const int wsIndex) {
+      auto it = saved->find(wsIndex);
+      if (it == saved->end())
+        it = saved->emplace(wsIndex, Kokkos::create_mirror(view)).first;
+      Kokkos::deep_copy(it->second, view);
+    };
+    savedField.restore = [view,saved] (const int wsIndex) {
+      Kokkos::deep_copy(view, saved->at(wsIndex));
+    };
+    _fields.push_back(savedField);
   }
 
-  //! Check if evaluated MDFields are saved (only works on single workset)
+  //! Check if evaluated MDFields are saved (and restore them if needed)
   bool have_saved_data(const typename Traits::EvalData workset,
       const std::vector<Teuchos::RCP<PHX::FieldTag>>& evalFields) {
     if (!_enableMemoizer) return false;
 
+    const int wsIndex = workset.wsIndex;
+    const WorksetKey key(workset.wsElNodeID.getRawPtr(), workset.numCells,
+                         workset.memoizerGeneration);
+
+    // The MDFields still hold the data computed in the previous call
+    if (_pendingWorksetIndex >= 0) {
+      for (const auto & field: _fields)
+        field.save(_pendingWorksetIndex);
+      _savedWorksets[_pendingWorksetIndex] = _prevKey;
+      _pendingWorksetIndex = -1;
+    }
+
+    // Check if MDFields are saved
+    bool saved = false, allSaved = true;
+    for (const auto & evalField: evalFields) {
+      if (workset.savedMDFields->count(evalField->identifier()) > 0)
+        saved = true;
+      else
+        allSaved = false;
+    }
+
+    const bool sameWorkset = wsIndex == _prevWorksetIndex && key == _prevKey;
+    _prevWorksetIndex = wsIndex;
+    _prevKey = key;
+
     // Check workset index
-    bool saved = false;
-    if (workset.wsIndex == _prevWorksetIndex) {
-      // Check if MDField is saved
-      for (const auto & evalField: evalFields) {
-        if (workset.savedMDFields->count(evalField->identifier()) > 0) {
-          saved = true;
-          break;
-        }
+    if (saved && sameWorkset) return true;
+
+    // Check saved data of this workset
+    if (allSaved && _fields.size() == evalFields.size()) {
+      const auto iter = _savedWorksets.find(wsIndex);
+      if (iter != _savedWorksets.end() && iter->second == key) {
+        for (const auto & field: _fields)
+          field.restore(wsIndex);
+        return true;
       }
+      _pendingWorksetIndex = wsIndex;
     }
-    _prevWorksetIndex = workset.wsIndex;
 
-    return saved;
+    return false;
   }
 
 private:
+  typedef std::tuple<const void*, unsigned int, unsigned int> WorksetKey;
+
+  struct SavedField {
+    std::function<void(const int)> save;
+    std::function<void(const int)> restore;
+  };
+
   bool _enableMemoizer;
   int _prevWorksetIndex;
+  int _pendingWorksetIndex;
+  WorksetKey _prevKey;
+  std::vector<SavedField> _fields;
+  std::map<int,WorksetKey> _savedWorksets;
 };
 
 } // namespace PHAL
@@ -137,6 +137,8 @@ struct Workset {
   int spatial_dimension_{0};
 
   Albany::StateArray* stateArrayPtr;
+  // Same arrays, indexed by Albany::StateHandle
+  const Albany::StateTable* stateTablePtr{nullptr};
 #if defined(ALBANY_EPETRA)
   Teuchos::RCP<Albany::EigendataStruct> eigenDataPtr;
   Teuchos::RCP<Epetra_MultiVector> auxDataPtr;
@@ -183,6 +185,10 @@ struct Workset {
   // List of saved MDFields (needed for memoization)
   Teuchos::RCP<const StringSet> savedMDFields;
 
+  // Changes whenever the memoized MDFields must be recomputed (coordinates,
+  // parameter values or input fields changed)
+  unsigned int memoizerGeneration{0};
+
   // Meta-function class encoding T<EvalT::ScalarT> given EvalT
   // where T is any lambda expression (typically a placeholder expression)
   template <typename T>
@@ -322,10 +322,12 @@ void AAdapt::AdaptiveSolutionManagerT::resizeMeshDataArrays(
   // TODO: ditch the overlapped_*T and keep only overlapped_*.
   //       You need to figure out how to pass the graph in a Tpetra-free way though...
   overlapped_fT = Teuchos::rcp(new Tpetra_Vector(overlapMapT));
-  overlapped_jacT = Teuchos::rcp(new Tpetra_CrsMatrix(overlapJacGraphT));
+  overlapped_f  = Albany::createThyraVector(overlapped_fT);
 
-  overlapped_f   = Albany::createThyraVector(overlapped_fT);
-  overlapped_jac = Albany::createThyraLinearOp(overlapped_jacT);
+  // Allocated by get_overlapped_jac(T)
+  overlapped_jac_graphT = overlapJacGraphT;
+  overlapped_jacT = Teuchos::null;
+  overlapped_jac  = Teuchos::null;
 
   // This call allocates the non-overlapped MV
   current_soln = disc_->getSolutionMV();
@@ -334,6 +336,23 @@ void AAdapt::AdaptiveSolutionManagerT::resizeMeshDataArrays(
   cas_manager = Teuchos::rcp( new Albany::CombineAndScatterManagerTpetra(owned_vs,overlapped_vs) );
 }
 
+Teuchos::RCP<Tpetra_CrsMatrix>
+AAdapt::AdaptiveSolutionManagerT::get_overlapped_jacT()
+{
+  if (overlapped_jacT.is_null()) {
+    overlapped_jacT = Teuchos::rcp(new Tpetra_CrsMatrix(overlapped_jac_graphT));
+    overlapped_jac  = Albany::createThyraLinearOp(overlapped_jacT);
+  }
+  return overlapped_jacT;
+}
+
+Teuchos::RCP<Thyra_LinearOp>
+AAdapt::AdaptiveSolutionManagerT::get_overlapped_jac()
+{
+  get_overlapped_jacT();
+  return overlapped_jac;
+}
+
 Teuchos::RCP<Tpetra_Vector>
 AAdapt::AdaptiveSolutionManagerT::updateAndReturnOverlapSolutionT(
     const Tpetra_Vector& solutionT /* not overlapped */)
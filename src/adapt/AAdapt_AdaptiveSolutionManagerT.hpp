@@ -58,10 +58,12 @@ public:
    Teuchos::RCP<const Tpetra_MultiVector> updateAndReturnOverlapSolutionMV(const Tpetra_MultiVector& solutionT /*not overlapped*/);
 
    Teuchos::RCP<Tpetra_Vector> get_overlapped_fT() {return overlapped_fT;}
-   Teuchos::RCP<Tpetra_CrsMatrix> get_overlapped_jacT() {return overlapped_jacT;}
+   // The overlapped Jacobian is allocated on first use, so that runs that
+   // never assemble the full Jacobian (e.g., matrix-free) do not store it.
+   Teuchos::RCP<Tpetra_CrsMatrix> get_overlapped_jacT();
 
    Teuchos::RCP<Thyra_Vector>   get_overlapped_f()   const {return overlapped_f;}
-   Teuchos::RCP<Thyra_LinearOp> get_overlapped_jac() const {return overlapped_jac;}
+   Teuchos::RCP<Thyra_LinearOp> get_overlapped_jac();
 
    Teuchos::RCP<Tpetra_Import> get_importerT() {return importerT;}
    Teuchos::RCP<Tpetra_Export> get_exporterT() {return exporterT;}
@@ -91,6 +93,7 @@ private:
 
     Teuchos::RCP<Tpetra_Vector> overlapped_fT;
     Teuchos::RCP<Tpetra_CrsMatrix> overlapped_jacT;
+    Teuchos::RCP<const Tpetra_CrsGraph> overlapped_jac_graphT;
 
     Teuchos::RCP<Thyra_Vector>   overlapped_f;
     Teuchos::RCP<Thyra_LinearOp> overlapped_jac;
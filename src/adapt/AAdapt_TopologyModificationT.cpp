@@ -126,9 +126,10 @@ AAdapt::TopologyModT::adaptMesh() {
 
   topology_->splitOpenFaces();
 
-  // Throw away all the Albany data structures and re-build them from the mesh
+  // Re-build the Albany data structures from the mesh. Only the graph rows
+  // around the split points need to be recomputed.
 
-  stk_discretization_->updateMesh();
+  stk_discretization_->updateMesh(topology_->get_split_points());
 
   return true;
 }
@@ -176,6 +176,10 @@ class AbstractDiscretization {
     //! Set coordinates (overlap map) for mesh adaptation.
     virtual void setCoordinates(const Teuchos::ArrayRCP<const double>& c) = 0;
 
+    //! Counter that changes whenever the coordinates change, so that data
+    //! computed from them can be invalidated. The default never changes.
+    virtual unsigned int getCoordinatesGeneration() const { return 0; }
+
     //! The reference configuration manager handles updating the reference
     //! configuration. This is only relevant, and also only optional, in the
     //! case of mesh adaptation.
@@ -0,0 +1,140 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_LayeredColumns.hpp"
+
+#include "Teuchos_TestForException.hpp"
+
+#include <unordered_map>
+
+namespace Albany {
+
+LayeredColumns::LayeredColumns ()
+ : disc_(nullptr)
+ , numLevels_(0)
+{
+  // Nothing to do here
+}
+
+void LayeredColumns::update (AbstractDiscretization& disc)
+{
+  Teuchos::RCP<const Tpetra_Map> overlapNodeMap = disc.getOverlapNodeMapT();
+  Teuchos::RCP<LayeredMeshNumbering<LO>> numbering = disc.getLayeredMeshNumbering();
+
+  if (disc_==&disc && overlapNodeMap==overlapNodeMap_ && numbering==numbering_) {
+    return;
+  }
+
+  TEUCHOS_TEST_FOR_EXCEPTION (numbering.is_null(), std::logic_error,
+                              "Error! The discretization does not have a layered mesh numbering.\n");
+
+  disc_ = &disc;
+  overlapNodeMap_ = overlapNodeMap;
+  numbering_ = numbering;
+
+  // Layer ratios and trapezoidal weights
+  const int numLayers = numbering_->numLayers;
+  numLevels_ = numLayers+1;
+  layersRatio_.assign(numbering_->layers_ratio.begin(),numbering_->layers_ratio.end());
+  quadWeights_.assign(numLevels_,0.0);
+  for (int il=0; il<numLayers; ++il) {
+    quadWeights_[il]   += 0.5*layersRatio_[il];
+    quadWeights_[il+1] += 0.5*layersRatio_[il];
+  }
+
+  // Workset tables
+  const auto& wsElNodeID = disc.getWsElNodeID();
+  const int numWorksets = wsElNodeID.size();
+  wsNodesPerCell_.assign(numWorksets,0);
+  wsColumns_.assign(numWorksets,std::vector<LO>());
+  wsNodeColumn_.assign(numWorksets,std::vector<int>());
+  wsNodeLevel_.assign(numWorksets,std::vector<int>());
+  wsBasalNodes_.assign(numWorksets,std::vector<std::pair<int,int>>());
+
+  std::unordered_map<LO,int> columnIndex;
+  for (int ws=0; ws<numWorksets; ++ws) {
+    const int numCells = wsElNodeID[ws].size();
+    if (numCells==0) {
+      continue;
+    }
+    const int numNodes = wsElNodeID[ws][0].size();
+    wsNodesPerCell_[ws] = numNodes;
+    wsNodeColumn_[ws].resize(numCells*numNodes);
+    wsNodeLevel_[ws].resize(numCells*numNodes);
+
+    columnIndex.clear();
+    for (int cell=0; cell<numCells; ++cell) {
+      for (int node=0; node<numNodes; ++node) {
+        const LO lnodeId = overlapNodeMap_->getLocalElement(wsElNodeID[ws][cell][node]);
+        LO column, level;
+        numbering_->getIndices(lnodeId,column,level);
+
+        auto it = columnIndex.find(column);
+        if (it==columnIndex.end()) {
+          it = columnIndex.emplace(column,static_cast<int>(wsColumns_[ws].size())).first;
+          wsColumns_[ws].push_back(column);
+          wsBasalNodes_[ws].push_back(std::make_pair(0,0));
+        }
+        wsNodeColumn_[ws][cell*numNodes+node] = it->second;
+        wsNodeLevel_[ws][cell*numNodes+node] = level;
+
+        if (level==0) {
+          wsBasalNodes_[ws][it->second] = std::make_pair(cell,node);
+        }
+      }
+    }
+  }
+}
+
+void LayeredColumns::gather (int ws,
+                             const Teuchos::ArrayRCP<const ST>& x,
+                             const NodalDOFManager& dofManager,
+                             int comp,
+                             std::vector<double>& values) const
+{
+  const std::vector<LO>& columns = wsColumns_[ws];
+  values.resize(columns.size()*numLevels_);
+  for (std::size_t icol=0; icol<columns.size(); ++icol) {
+    double* column_values = values.data() + icol*numLevels_;
+    for (int il=0; il<numLevels_; ++il) {
+      column_values[il] = x[dofManager.getLocalDOF(numbering_->getId(columns[icol],il),comp)];
+    }
+  }
+}
+
+void LayeredColumns::integrate (std::vector<double>& values) const
+{
+  const std::size_t numColumns = values.size()/numLevels_;
+  for (std::size_t icol=0; icol<numColumns; ++icol) {
+    double* column_values = values.data() + icol*numLevels_;
+    double below = column_values[0];
+    double integral = 0.0;
+    column_values[0] = 0.0;
+    for (int il=1; il<numLevels_; ++il) {
+      const double current = column_values[il];
+      integral += 0.5*(below+current)*layersRatio_[il-1];
+      column_values[il] = integral;
+      below = current;
+    }
+  }
+}
+
+void LayeredColumns::average (const std::vector<double>& values,
+                              std::vector<double>& averages) const
+{
+  const std::size_t numColumns = values.size()/numLevels_;
+  averages.assign(numColumns,0.0);
+  for (std::size_t icol=0; icol<numColumns; ++icol) {
+    const double* column_values = values.data() + icol*numLevels_;
+    double avg = 0.0;
+    for (int il=0; il<numLevels_; ++il) {
+      avg += column_values[il]*quadWeights_[il];
+    }
+    averages[icol] = avg;
+  }
+}
+
+} // namespace Albany
@@ -0,0 +1,101 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_LAYERED_COLUMNS_HPP
+#define ALBANY_LAYERED_COLUMNS_HPP
+
+#include "Albany_AbstractDiscretization.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace Albany {
+
+// Column tables for vertical operators on layered meshes.
+//
+// For each workset, the columns touched by its cells are listed once, and
+// each (cell,node) knows its column (as an index in that list) and its level.
+// The tables are built on the first call to update, and rebuilt only if the
+// discretization changes, so evaluators do not need to convert node GIDs or
+// search for basal nodes at every evaluation.
+//
+// Column values are stored in contiguous, column ordered buffers:
+// values[icol*numLevels()+level], with icol an index in worksetColumns(ws).
+// Vertical integrals and averages use the trapezoidal rule on the layer
+// ratios, so they cost O(numLevels()) per column.
+class LayeredColumns
+{
+public:
+  LayeredColumns ();
+
+  // Build the tables, unless they are up to date with disc
+  void update (AbstractDiscretization& disc);
+
+  int numLevels () const { return numLevels_; }
+
+  // Trapezoidal weights of the levels for a vertical average
+  const std::vector<double>& quadWeights () const { return quadWeights_; }
+
+  // Overlap node LIDs of the columns touched by workset ws
+  const std::vector<LO>& worksetColumns (int ws) const { return wsColumns_[ws]; }
+
+  // Index in worksetColumns(ws) of the column of the node of a cell
+  int columnIndex (int ws, int cell, int node) const {
+    return wsNodeColumn_[ws][cell*wsNodesPerCell_[ws]+node];
+  }
+
+  // Level of the node of a cell
+  int level (int ws, int cell, int node) const {
+    return wsNodeLevel_[ws][cell*wsNodesPerCell_[ws]+node];
+  }
+
+  // (cell,node) of the basal node of a workset column. If the basal node is
+  // not in the workset, this is (0,0).
+  const std::pair<int,int>& basalNode (int ws, int icol) const {
+    return wsBasalNodes_[ws][icol];
+  }
+
+  // Overlap node LID at a level of a column
+  LO nodeId (LO column, int level) const {
+    return numbering_->getId(column,level);
+  }
+
+  // Gather the component comp of x at all levels of the workset columns
+  void gather (int ws,
+               const Teuchos::ArrayRCP<const ST>& x,
+               const NodalDOFManager& dofManager,
+               int comp,
+               std::vector<double>& values) const;
+
+  // In place inclusive prefix sums: values at level l become the integral,
+  // in units of the column thickness, from the base to level l
+  void integrate (std::vector<double>& values) const;
+
+  // Vertical average of each column
+  void average (const std::vector<double>& values,
+                std::vector<double>& averages) const;
+
+private:
+
+  // What the tables were built for
+  const AbstractDiscretization*         disc_;
+  Teuchos::RCP<const Tpetra_Map>        overlapNodeMap_;
+  Teuchos::RCP<LayeredMeshNumbering<LO>> numbering_;
+
+  int                 numLevels_;
+  std::vector<double> layersRatio_;
+  std::vector<double> quadWeights_;
+
+  std::vector<int>                             wsNodesPerCell_;
+  std::vector<std::vector<LO>>                 wsColumns_;
+  std::vector<std::vector<int>>                wsNodeColumn_;
+  std::vector<std::vector<int>>                wsNodeLevel_;
+  std::vector<std::vector<std::pair<int,int>>> wsBasalNodes_;
+};
+
+} // namespace Albany
+
+#endif // ALBANY_LAYERED_COLUMNS_HPP
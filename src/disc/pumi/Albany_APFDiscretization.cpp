@@ -1168,6 +1168,8 @@ void Albany::APFDiscretization::computeWorksetInfo()
       }
     }
   }
+
+  Albany::indexStateArrays(stateArrays);
 }
 
 void Albany::APFDiscretization::forEachNodeSetNode(
@@ -152,6 +152,7 @@ class APFDiscretization : public Albany::AbstractDiscretization {
     //! Set stateArrays
     void setStateArrays(Albany::StateArrays& sa) override {
       stateArrays = sa;
+      Albany::indexStateArrays(stateArrays);
       return;
     }
 
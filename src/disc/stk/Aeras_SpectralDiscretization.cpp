@@ -2723,6 +2723,8 @@ void Aeras::SpectralDiscretization::computeWorksetInfo()
       }
     }
   }
+
+  Albany::indexStateArrays(stateArrays);
 }
 
 void Aeras::SpectralDiscretization::computeSideSetsLines()
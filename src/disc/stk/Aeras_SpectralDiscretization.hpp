@@ -387,6 +387,7 @@ namespace Aeras
     //! Set stateArrays
     void setStateArrays(Albany::StateArrays& sa) override {
       stateArrays = sa;
+      Albany::indexStateArrays(stateArrays);
       return;
     }
 
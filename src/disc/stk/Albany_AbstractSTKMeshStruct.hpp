@@ -10,6 +10,7 @@
 
 #include <vector>
 #include <fstream>
+#include <utility>
 
 #include "Albany_AbstractMeshStruct.hpp"
 
@@ -58,10 +59,17 @@ namespace Albany {
     int numDim;
     int neq;
     bool interleavedOrdering;
+    // Order of the local node ids: Input (mesh order) or Morton
+    std::string nodeOrdering;
 
     bool exoOutput;
     std::string exoOutFile;
     int exoOutputInterval;
+    // Write Exodus output steps on a background thread
+    bool asyncOutput;
+    // With asyncOutput, each transient output field and the copy the
+    // background thread writes it from
+    std::vector<std::pair<stk::mesh::FieldBase*, stk::mesh::FieldBase*> > asyncOutputFields;
     std::string cdfOutFile;
     bool cdfOutput;
     unsigned nLat;
@@ -0,0 +1,76 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_AsyncOutputQueue.hpp"
+
+namespace Albany {
+
+AsyncOutputQueue&
+AsyncOutputQueue::instance()
+{
+  static AsyncOutputQueue queue;
+  return queue;
+}
+
+AsyncOutputQueue::~AsyncOutputQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  changed.notify_all();
+  if (worker.joinable()) worker.join();
+}
+
+void
+AsyncOutputQueue::push(std::function<void()> task)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  if (!worker.joinable()) worker = std::thread(&AsyncOutputQueue::run, this);
+  changed.wait(lock, [this] { return tasks.size() < max_pending; });
+  tasks.push_back(std::move(task));
+  changed.notify_all();
+}
+
+void
+AsyncOutputQueue::flush()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  changed.wait(lock, [this] { return tasks.empty() && !busy; });
+  if (error) {
+    std::exception_ptr e = error;
+    error                = nullptr;
+    std::rethrow_exception(e);
+  }
+}
+
+void
+AsyncOutputQueue::run()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    changed.wait(lock, [this] { return stopping || !tasks.empty(); });
+    // Pending tasks are still run when stopping, so no output is lost
+    if (tasks.empty()) return;
+
+    std::function<void()> task = std::move(tasks.front());
+    tasks.pop_front();
+    busy = true;
+    changed.notify_all();
+    lock.unlock();
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> error_lock(mutex);
+      if (!error) error = std::current_exception();
+    }
+    lock.lock();
+    busy = false;
+    changed.notify_all();
+  }
+}
+
+}  // namespace Albany
@@ -0,0 +1,68 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_ASYNC_OUTPUT_QUEUE_HPP
+#define ALBANY_ASYNC_OUTPUT_QUEUE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Albany {
+
+/*
+ * A single background thread that runs output tasks in order.
+ *
+ * The Exodus/NetCDF libraries are not thread safe, so there is one queue
+ * per process, and any code touching an output file must call flush()
+ * before doing so. Tasks must not access mesh data that the solver may
+ * modify: they are meant for writing data that was copied for them, such
+ * as the output field copies of STKDiscretization.
+ */
+class AsyncOutputQueue
+{
+ public:
+  static AsyncOutputQueue&
+  instance();
+
+  ~AsyncOutputQueue();
+
+  // Queue a task, blocking while the queue holds max_pending tasks
+  void
+  push(std::function<void()> task);
+
+  // Wait until all tasks have run. Rethrows the first exception thrown by a
+  // task since the last flush.
+  void
+  flush();
+
+ private:
+  AsyncOutputQueue() = default;
+
+  AsyncOutputQueue(const AsyncOutputQueue&) = delete;
+  AsyncOutputQueue&
+  operator=(const AsyncOutputQueue&) = delete;
+
+  void
+  run();
+
+  static constexpr int max_pending = 4;
+
+  std::deque<std::function<void()>> tasks;
+  std::mutex                        mutex;
+  std::condition_variable           changed;
+  std::thread                       worker;
+  std::exception_ptr                error;
+  bool                              busy     = false;
+  bool                              stopping = false;
+};
+
+}  // namespace Albany
+
+#endif  // ALBANY_ASYNC_OUTPUT_QUEUE_HPP
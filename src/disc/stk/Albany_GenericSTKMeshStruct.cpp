@@ -19,7 +19,12 @@
 #include <stk_io/IossBridge.hpp>
 #endif
 
+#ifdef ALBANY_MPI
+#include <mpi.h>
+#endif
+
 #include "Albany_Utils.hpp"
+#include "Albany_BinaryVectorIO.hpp"
 #include <stk_mesh/base/GetEntities.hpp>
 #include <stk_mesh/base/CreateAdjacentEntities.hpp>
 
@@ -98,6 +103,9 @@ Albany::GenericSTKMeshStruct::GenericSTKMeshStruct(
   }
 
   interleavedOrdering = params->get("Interleaved Ordering",true);
+  nodeOrdering = params->get<std::string>("Node Ordering","Input");
+  TEUCHOS_TEST_FOR_EXCEPTION(nodeOrdering!="Input" && nodeOrdering!="Morton", std::logic_error,
+                             "Error! Invalid Node Ordering '" << nodeOrdering << "'. Valid choices are Input and Morton.\n");
   allElementBlocksHaveSamePhysics = true;
   compositeTet = params->get<bool>("Use Composite Tet 10", false);
   num_time_deriv = params->get<int>("Number Of Time Derivatives");
@@ -201,6 +209,9 @@ void Albany::GenericSTKMeshStruct::SetupFieldData(
   if (exoOutput)
     exoOutFile = params->get<std::string>("Exodus Output File Name");
   exoOutputInterval = params->get<int>("Exodus Write Interval", 1);
+  asyncOutput = params->get<bool>("Asynchronous Output", false);
+  if (exoOutput && asyncOutput)
+    declareAsyncOutputFields(commT);
   cdfOutput = params->isType<std::string>("NetCDF Output File Name");
   if (cdfOutput)
     cdfOutFile = params->get<std::string>("NetCDF Output File Name");
@@ -249,6 +260,51 @@ void Albany::GenericSTKMeshStruct::SetupFieldData(
 
 }
 
+void Albany::GenericSTKMeshStruct::declareAsyncOutputFields(
+    const Teuchos::RCP<const Teuchos_Comm>& commT)
+{
+#ifdef ALBANY_SEACAS
+#ifdef ALBANY_MPI
+  // The output thread may call MPI (through Ioss) while the main thread does
+  int provided;
+  MPI_Query_thread(&provided);
+  if (provided < MPI_THREAD_MULTIPLE) {
+    if (commT->getRank() == 0)
+      *Teuchos::VerboseObjectBase::getDefaultOStream()
+          << "\nWARNING: Asynchronous Output needs MPI initialized with "
+          << "MPI_THREAD_MULTIPLE: writing the Exodus output synchronously.\n"
+          << std::endl;
+    asyncOutput = false;
+    return;
+  }
+#endif
+
+  // The output thread writes the steps from copies of the fields, so that
+  // the solver can keep updating the fields meanwhile. Only the fields
+  // registered for transient output are copied. The copies have the layout
+  // and the io role of the fields, and a single state.
+  const stk::mesh::FieldVector fields = metaData->get_fields();
+  for (stk::mesh::FieldBase* field : fields)
+  {
+    const Ioss::Field::RoleType* role = stk::io::get_field_role(*field);
+    if (role == NULL || *role != Ioss::Field::TRANSIENT)
+      continue;
+
+    stk::mesh::FieldBase* copy = metaData->declare_field_base(
+        field->name() + "_async_output", field->entity_rank(),
+        field->data_traits(), field->field_array_rank(),
+        field->dimension_tags(), 1);
+    for (const stk::mesh::FieldRestriction& r : field->restrictions())
+      metaData->declare_field_restriction(*copy, r.selector(),
+          r.num_scalars_per_entity(), r.dimension());
+
+    stk::io::set_field_role(*copy, *role);
+
+    asyncOutputFields.push_back(std::make_pair(field, copy));
+  }
+#endif
+}
+
 void Albany::GenericSTKMeshStruct::setAllPartsIO()
 {
 #ifdef ALBANY_SEACAS
@@ -1165,7 +1221,10 @@ void Albany::GenericSTKMeshStruct::loadRequiredInputFields (const AbstractFieldC
     ftype  = fparams.get<std::string>("Field Type","INVALID");
     if (fusage == "Input" || fusage == "Input-Output") {
       forigin = fparams.get<std::string>("Field Origin","INVALID");
-      if (forigin=="File" && fparams.isParameter("File Name")) {
+      // Binary (non layered) files are read without the serial map
+      if (forigin=="File" && fparams.isParameter("File Name") &&
+          (ftype.find("Layered")!=std::string::npos ||
+           !isBinaryVectorFile(fparams.get<std::string>("File Name"),commT))) {
         if (ftype.find("Node")!=std::string::npos) {
           node_field_ascii_loads = true;
         } else if (ftype.find("Elem")!=std::string::npos) {
@@ -1387,7 +1446,16 @@ void Albany::GenericSTKMeshStruct::loadField (const std::string& field_name, con
   out->getOStream()->flush();
   // Read the input file and stuff it in the Tpetra multivector
 
-  if (scalar)
+  const bool binary = !layered && isBinaryVectorFile(fname,commT);
+  if (binary)
+  {
+    // Binary files are read in parallel, directly on the (possibly) overlapping map
+    serial_req_mvec = readBinaryMultiVector(fname,map);
+    TEUCHOS_TEST_FOR_EXCEPTION (scalar && serial_req_mvec->getNumVectors()!=1, Teuchos::Exceptions::InvalidParameterValue,
+                                "Error in GenericSTKMeshStruct: file " << fname << " stores more than one vector, "
+                                "but field '" << field_name << "' is a scalar.\n");
+  }
+  else if (scalar)
   {
     if (layered)
     {
@@ -1447,6 +1515,11 @@ void Albany::GenericSTKMeshStruct::loadField (const std::string& field_name, con
   }
 
   // Fill the (possibly) parallel vector
+  if (binary)
+  {
+    field_mv = serial_req_mvec;
+    return;
+  }
   field_mv = Teuchos::rcp(new Tpetra_MultiVector(map,serial_req_mvec->getNumVectors()));
   field_mv->doImport(*serial_req_mvec,importOperator,Tpetra::INSERT);
 }
@@ -1963,6 +2036,7 @@ Albany::GenericSTKMeshStruct::getValidGenericSTKParameters(std::string listname)
 #endif
   validPL->set<bool>("Output DTK Field to Exodus", true, "Boolean indicating whether to write dtk field to exodus file");
   validPL->set<int>("Exodus Write Interval", 3, "Step interval to write solution data to Exodus file");
+  validPL->set<bool>("Asynchronous Output", false, "Write Exodus output steps from copies of the transient fields on a background thread (one file per process; needs MPI_THREAD_MULTIPLE; not for meshes modified during the run)");
   validPL->set<std::string>("NetCDF Output File Name", "",
       "Request NetCDF output to given file name. Requires SEACAS build");
   validPL->set<int>("NetCDF Write Interval", 1, "Step interval to write solution data to NetCDF file");
@@ -1977,6 +2051,7 @@ Albany::GenericSTKMeshStruct::getValidGenericSTKParameters(std::string listname)
   validPL->set<int>("Workset Size", DEFAULT_WORKSET_SIZE, "Upper bound on workset (bucket) size");
   validPL->set<bool>("Use Automatic Aura", false, "Use automatic aura with BulkData");
   validPL->set<bool>("Interleaved Ordering", true, "Flag for interleaved or blocked unknown ordering");
+  validPL->set<std::string>("Node Ordering", "Input", "Order of the local node ids: Input (as in the mesh) or Morton (along a Morton curve, for locality of gathers, scatters and SpMV)");
   validPL->set<bool>("Separate Evaluators by Element Block", false,
                      "Flag for different evaluation trees for each Element Block");
   validPL->set<std::string>("Transform Type", "None", "None or ISMIP-HOM Test A"); //for LandIce problem that require tranformation of STK mesh
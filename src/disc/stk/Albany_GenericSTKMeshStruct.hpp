@@ -87,6 +87,10 @@ namespace Albany {
     //! Sets all mesh parts as IO parts (will be written to file)
     void setAllPartsIO();
 
+    //! Declare the copies of the fields written by the Asynchronous Output,
+    //! or turn it off if MPI does not allow the output thread
+    void declareAsyncOutputFields(const Teuchos::RCP<const Teuchos_Comm>& commT);
+
     //! Determine if a percept mesh object is needed
     bool buildEMesh;
     bool buildPerceptEMesh();
@@ -4,8 +4,11 @@
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
 
+#include <cstdint>
+#include <cstring>
 #include <limits>
 
+#include "Albany_AsyncOutputQueue.hpp"
 #include "Albany_BucketArray.hpp"
 #include "Albany_NodalGraphUtils.hpp"
 #include "Albany_STKDiscretization.hpp"
@@ -18,6 +21,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <set>
 #include <string>
 
 #include <Shards_BasicTopologies.hpp>
@@ -38,6 +42,7 @@
 
 #ifdef ALBANY_SEACAS
 #include <Ionit_Initializer.h>
+#include <Ioss_Property.h>
 #include <netcdf.h>
 
 #ifdef ALBANY_PAR_NETCDF
@@ -72,6 +77,50 @@ const Tpetra::global_size_t INVALID =
 // Uncomment the following line if you want debug output to be printed to screen
 // #define OUTPUT_TO_SCREEN
 
+namespace {
+
+// Sort the nodes along a Morton (Z-order) curve through the box [lo,hi], so
+// that nodes close in space get close local ids. Ties are broken by gid, so
+// the relative order of the nodes does not depend on the subset being sorted.
+void
+sortAlongMortonCurve(
+    std::vector<stk::mesh::Entity>&                           nodes,
+    const stk::mesh::BulkData&                                bulkData,
+    const Albany::AbstractSTKFieldContainer::VectorFieldType& coordinates_field,
+    const int                                                 numDim,
+    const double                                              lo[3],
+    const double                                              hi[3])
+{
+  // 21 bits per dimension fit three dimensions in 64 bits
+  constexpr int           bits  = 21;
+  constexpr std::uint64_t max_q = (std::uint64_t(1) << bits) - 1;
+
+  std::vector<std::pair<std::pair<std::uint64_t, stk::mesh::EntityId>, stk::mesh::Entity>> keyed(nodes.size());
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    const double* x = stk::mesh::field_data(coordinates_field, nodes[i]);
+    std::uint64_t key = 0;
+    for (int dim = 0; dim < numDim; ++dim) {
+      const double  len = hi[dim] - lo[dim];
+      const double  t   = len > 0 ? (x[dim] - lo[dim]) / len : 0.0;
+      std::uint64_t q   = static_cast<std::uint64_t>(std::max(0.0, std::min(1.0, t)) * max_q);
+      for (int b = 0; b < bits; ++b) {
+        key |= ((q >> b) & 1) << (b * numDim + dim);
+      }
+    }
+    keyed[i] = std::make_pair(std::make_pair(key, bulkData.identifier(nodes[i])), nodes[i]);
+  }
+
+  std::sort(keyed.begin(), keyed.end(),
+            [](const decltype(keyed)::value_type& a, const decltype(keyed)::value_type& b) {
+              return a.first < b.first;
+            });
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    nodes[i] = keyed[i].second;
+  }
+}
+
+} // anonymous namespace
+
 Albany::STKDiscretization::STKDiscretization(
     const Teuchos::RCP<Teuchos::ParameterList>&  discParams_,
     Teuchos::RCP<Albany::AbstractSTKMeshStruct>& stkMeshStruct_,
@@ -101,6 +150,14 @@ Albany::STKDiscretization::STKDiscretization(
 Albany::STKDiscretization::~STKDiscretization()
 {
 #ifdef ALBANY_SEACAS
+  // Close pending output steps before the output database goes away
+  try {
+    AsyncOutputQueue::instance().flush();
+  } catch (const std::exception& e) {
+    *out << "WARNING: failed to close an output step: " << e.what()
+         << std::endl;
+  }
+
   if (stkMeshStruct->cdfOutput) {
     if (netCDFp) {
       const int ierr = nc_close(netCDFp);
@@ -913,6 +970,10 @@ Albany::STKDiscretization::writeSolutionToFileT(
 {
 #ifdef ALBANY_SEACAS
 
+  // Wait for pending output steps (of any discretization) to be closed before
+  // touching any file
+  AsyncOutputQueue::instance().flush();
+
   if (stkMeshStruct->exoOutput && stkMeshStruct->transferSolutionToCoords) {
     Teuchos::RCP<AbstractSTKFieldContainer> container =
         stkMeshStruct->getFieldContainer();
@@ -927,33 +988,42 @@ Albany::STKDiscretization::writeSolutionToFileT(
   }
 
   // Skip this write unless the proper interval has been reached
+  std::function<void()> exo_step;
   if (stkMeshStruct->exoOutput &&
       !(outputInterval % stkMeshStruct->exoOutputInterval)) {
     double time_label = monotonicTimeLabel(time);
 
-    mesh_data->begin_output_step(outputFileIdx, time_label);
-    int out_step = mesh_data->write_defined_output_fields(outputFileIdx);
-    // Writing mesh global variables
-    for (auto& it : stkMeshStruct->getFieldContainer()->getMeshVectorStates()) {
-      mesh_data->write_global(outputFileIdx, it.first, it.second);
-    }
-    for (auto& it :
-         stkMeshStruct->getFieldContainer()->getMeshScalarIntegerStates()) {
-      mesh_data->write_global(outputFileIdx, it.first, it.second);
-    }
-    mesh_data->end_output_step(outputFileIdx);
+    Albany::syncSwappedStates(stateArrays);
 
-    if (mapT->getComm()->getRank() == 0) {
-      *out << "Albany::STKDiscretization::writeSolution: writing time " << time;
-      if (time_label != time) *out << " with label " << time_label;
-      *out << " to index " << out_step << " in file "
-           << stkMeshStruct->exoOutFile << std::endl;
+    // The first step defines the output fields, which involves all the
+    // ranks, so it is always written here
+    if (stkMeshStruct->asyncOutput && outputInterval > 0) {
+      exo_step = snapshotExodusOutputStep(time_label);
+
+      if (mapT->getComm()->getRank() == 0) {
+        *out << "Albany::STKDiscretization::writeSolution: queueing time "
+             << time;
+        if (time_label != time) *out << " with label " << time_label;
+        *out << " for file " << stkMeshStruct->exoOutFile << std::endl;
+      }
+    } else {
+      int out_step = writeExodusOutputStep(time_label);
+
+      if (mapT->getComm()->getRank() == 0) {
+        *out << "Albany::STKDiscretization::writeSolution: writing time "
+             << time;
+        if (time_label != time) *out << " with label " << time_label;
+        *out << " to index " << out_step << " in file "
+             << stkMeshStruct->exoOutFile << std::endl;
+      }
     }
   }
   if (stkMeshStruct->cdfOutput &&
       !(outputInterval % stkMeshStruct->cdfOutputInterval)) {
     double time_label = monotonicTimeLabel(time);
 
+    Albany::syncSwappedStates(stateArrays);
+
     const int out_step = processNetCDFOutputRequestT(solnT);
 
     if (mapT->getComm()->getRank() == 0) {
@@ -978,6 +1048,9 @@ Albany::STKDiscretization::writeSolutionToFileT(
       it.second->writeSolutionToFileT(ss_solnT, time, overlapped);
     }
   }
+  // The step is written from the copies of the output fields while the
+  // solver continues
+  if (exo_step) AsyncOutputQueue::instance().push(exo_step);
 #endif
 }
 
@@ -989,6 +1062,10 @@ Albany::STKDiscretization::writeSolutionMVToFile(
 {
 #ifdef ALBANY_SEACAS
 
+  // Wait for pending output steps (of any discretization) to be closed before
+  // touching any file
+  AsyncOutputQueue::instance().flush();
+
   if (stkMeshStruct->exoOutput && stkMeshStruct->transferSolutionToCoords) {
     Teuchos::RCP<AbstractSTKFieldContainer> container =
         stkMeshStruct->getFieldContainer();
@@ -1003,33 +1080,42 @@ Albany::STKDiscretization::writeSolutionMVToFile(
   }
 
   // Skip this write unless the proper interval has been reached
+  std::function<void()> exo_step;
   if (stkMeshStruct->exoOutput &&
       !(outputInterval % stkMeshStruct->exoOutputInterval)) {
     double time_label = monotonicTimeLabel(time);
 
-    mesh_data->begin_output_step(outputFileIdx, time_label);
-    int out_step = mesh_data->write_defined_output_fields(outputFileIdx);
-    // Writing mesh global variables
-    for (auto& it : stkMeshStruct->getFieldContainer()->getMeshVectorStates()) {
-      mesh_data->write_global(outputFileIdx, it.first, it.second);
-    }
-    for (auto& it :
-         stkMeshStruct->getFieldContainer()->getMeshScalarIntegerStates()) {
-      mesh_data->write_global(outputFileIdx, it.first, it.second);
-    }
-    mesh_data->end_output_step(outputFileIdx);
+    Albany::syncSwappedStates(stateArrays);
 
-    if (mapT->getComm()->getRank() == 0) {
-      *out << "Albany::STKDiscretization::writeSolution: writing time " << time;
-      if (time_label != time) *out << " with label " << time_label;
-      *out << " to index " << out_step << " in file "
-           << stkMeshStruct->exoOutFile << std::endl;
+    // The first step defines the output fields, which involves all the
+    // ranks, so it is always written here
+    if (stkMeshStruct->asyncOutput && outputInterval > 0) {
+      exo_step = snapshotExodusOutputStep(time_label);
+
+      if (mapT->getComm()->getRank() == 0) {
+        *out << "Albany::STKDiscretization::writeSolution: queueing time "
+             << time;
+        if (time_label != time) *out << " with label " << time_label;
+        *out << " for file " << stkMeshStruct->exoOutFile << std::endl;
+      }
+    } else {
+      int out_step = writeExodusOutputStep(time_label);
+
+      if (mapT->getComm()->getRank() == 0) {
+        *out << "Albany::STKDiscretization::writeSolution: writing time "
+             << time;
+        if (time_label != time) *out << " with label " << time_label;
+        *out << " to index " << out_step << " in file "
+             << stkMeshStruct->exoOutFile << std::endl;
+      }
     }
   }
   if (stkMeshStruct->cdfOutput &&
       !(outputInterval % stkMeshStruct->cdfOutputInterval)) {
     double time_label = monotonicTimeLabel(time);
 
+    Albany::syncSwappedStates(stateArrays);
+
     const int out_step = processNetCDFOutputRequestMV(solnT);
 
     if (mapT->getComm()->getRank() == 0) {
@@ -1056,6 +1142,9 @@ Albany::STKDiscretization::writeSolutionMVToFile(
     }
   }
 
+  // The step is written from the copies of the output fields while the
+  // solver continues
+  if (exo_step) AsyncOutputQueue::instance().push(exo_step);
 #endif
 }
 
@@ -1593,6 +1682,34 @@ Albany::STKDiscretization::computeNodalMaps(bool overlapped)
   numGlobalNodes =
       maxGID + 1;  // maxGID is the same for overlapped and unique maps
 
+  // Bounding box of the local nodes, for the Morton renumbering. It is the
+  // same for all the maps below, so the node order is consistent among them.
+  const bool morton_order = (stkMeshStruct->nodeOrdering == "Morton");
+  // The layered numbering of extruded meshes is built on the local ids in
+  // mesh order (column stride = number of 2D nodes), so they must not move.
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      morton_order && Teuchos::nonnull(stkMeshStruct->layered_mesh_numbering),
+      std::logic_error,
+      "Error! Node Ordering = Morton is not supported on layered (extruded) "
+      "meshes: the layered mesh numbering relies on the input local ids.\n");
+  const int  numDim       = stkMeshStruct->numDim;
+  AbstractSTKFieldContainer::VectorFieldType* coordinates_field =
+      stkMeshStruct->getCoordinatesField();
+  double lo[3] = {0.0, 0.0, 0.0}, hi[3] = {0.0, 0.0, 0.0};
+  if (morton_order) {
+    for (int dim = 0; dim < numDim; ++dim) {
+      lo[dim] = std::numeric_limits<double>::max();
+      hi[dim] = std::numeric_limits<double>::lowest();
+    }
+    for (const auto& node : nodes) {
+      const double* x = stk::mesh::field_data(*coordinates_field, node);
+      for (int dim = 0; dim < numDim; ++dim) {
+        lo[dim] = std::min(lo[dim], x[dim]);
+        hi[dim] = std::max(hi[dim], x[dim]);
+      }
+    }
+  }
+
   // build maps
   for (auto it = mapOfDOFsStructs.begin(); it != mapOfDOFsStructs.end(); ++it) {
     stk::mesh::Selector selector(map_type_selector);
@@ -1613,6 +1730,9 @@ Albany::STKDiscretization::computeNodalMaps(bool overlapped)
 
     stk::mesh::get_selected_entities(
         selector, bulkData.buckets(stk::topology::NODE_RANK), nodes);
+    if (morton_order) {
+      sortAlongMortonCurve(nodes, bulkData, *coordinates_field, numDim, lo, hi);
+    }
 
     numNodes = nodes.size();
 
@@ -1717,21 +1837,15 @@ Albany::STKDiscretization::computeGraphs()
 }
 
 void
-Albany::STKDiscretization::computeGraphsUpToFillComplete()
+Albany::STKDiscretization::computeGraphsUpToFillComplete(
+    Tpetra::ProfileType const profile)
 {
-  std::map<int, stk::mesh::Part*>::iterator pv = stkMeshStruct->partVec.begin();
-  int nodes_per_element =
-      metaData.get_cell_topology(*(pv->second)).getNodeCount();
-
   // Loads member data:  overlap_graph, numOverlapodes, overlap_node_map,
   // coordinates, graphs
 
   overlap_graphT =
       Teuchos::null;  // delete existing graph happens here on remesh
 
-  overlap_graphT =
-      Teuchos::rcp(new Tpetra_CrsGraph(overlap_mapT, neq * nodes_per_element));
-
   stk::mesh::Selector select_owned_in_part =
       stk::mesh::Selector(metaData.universal_part()) &
       stk::mesh::Selector(metaData.locally_owned_part());
@@ -1744,9 +1858,6 @@ Albany::STKDiscretization::computeGraphsUpToFillComplete()
   if (commT->getRank() == 0)
     *out << "STKDisc: " << cells.size() << " elements on Proc 0 " << std::endl;
 
-  Tpetra_GO                     row, col;
-  Teuchos::ArrayView<Tpetra_GO> colAV;
-
   // determining the equations that are defined on the whole domain
   std::vector<int> globalEqns;
   for (int k(0); k < neq; ++k) {
@@ -1755,100 +1866,153 @@ Albany::STKDiscretization::computeGraphsUpToFillComplete()
     }
   }
 
-  for (std::size_t i = 0; i < cells.size(); i++) {
-    stk::mesh::Entity        e         = cells[i];
-    stk::mesh::Entity const* node_rels = bulkData.begin_nodes(e);
-    const size_t             num_nodes = bulkData.num_nodes(e);
-
-    // loop over local nodes
-    for (std::size_t j = 0; j < num_nodes; j++) {
-      stk::mesh::Entity rowNode = node_rels[j];
-
-      // loop over eqs
-      for (std::size_t k = 0; k < globalEqns.size(); ++k) {
-        row = getGlobalDOF(gid(rowNode), globalEqns[k]);
-        for (std::size_t l = 0; l < num_nodes; l++) {
-          stk::mesh::Entity colNode = node_rels[l];
-          for (std::size_t m = 0; m < neq; m++)  // Note: here we cycle through
-                                                 // ALL the eqns (not just the
-                                                 // global ones),
-          {  //       since they could all be coupled with this eq
-            col   = getGlobalDOF(gid(colNode), m);
-            colAV = Teuchos::arrayView(&col, 1);
-            overlap_graphT->insertGlobalIndices(row, colAV);
+  // The graph is built from the node to node adjacency. Every row of a node
+  // has the same columns: all the eqns of the adjacent nodes, since they
+  // could all be coupled with the row eq.
+  const LO num_overlap_nodes = overlap_node_mapT->getNodeNumElements();
+
+  std::vector<std::vector<GO>> node_adjacency(num_overlap_nodes);
+  for (auto node : overlapnodes) {
+    const LO inode = overlap_node_mapT->getLocalElement(gid(node));
+    nodeAdjacency(node, node_adjacency[inode]);
+  }
+
+  // Side set equations are only coupled through the sides of their side
+  // sets. In case we only have equations on side sets (no "volume" eqns),
+  // there would be problem with linear solvers. To avoid this, we put one
+  // diagonal entry for every side set equation.
+  std::map<int, std::vector<std::vector<GO>>> side_adjacency;
+  for (auto it = sideSetEquations.begin(); it != sideSetEquations.end();
+       ++it) {
+    std::vector<std::vector<GO>>& eq_adjacency = side_adjacency[it->first];
+    eq_adjacency.resize(num_overlap_nodes);
+
+    // Number of side sets this eq is defined on
+    int numSideSets = it->second.size();
+    for (int ss(0); ss < numSideSets; ++ss) {
+      stk::mesh::Part& part =
+          *stkMeshStruct->ssPartVec.find(it->second[ss])->second;
+
+      // Get all owned sides in this side set
+      stk::mesh::Selector select_owned_in_sspart =
+          stk::mesh::Selector(part) &
+          stk::mesh::Selector(metaData.locally_owned_part());
+
+      std::vector<stk::mesh::Entity> sides;
+      stk::mesh::get_selected_entities(
+          select_owned_in_sspart,
+          bulkData.buckets(metaData.side_rank()),
+          sides);  // store the result in "sides"
+
+      // Loop on all the sides of this sideset
+      for (std::size_t localSideID = 0; localSideID < sides.size();
+           localSideID++) {
+        stk::mesh::Entity        sidee     = sides[localSideID];
+        stk::mesh::Entity const* node_rels = bulkData.begin_nodes(sidee);
+        const size_t             num_nodes = bulkData.num_nodes(sidee);
+
+        for (std::size_t j = 0; j < num_nodes; j++) {
+          std::vector<GO>& adjacency = eq_adjacency[
+              overlap_node_mapT->getLocalElement(gid(node_rels[j]))];
+          for (std::size_t k = 0; k < num_nodes; k++) {
+            adjacency.push_back(gid(node_rels[k]));
           }
         }
       }
     }
+
+    for (auto& adjacency : eq_adjacency) {
+      std::sort(adjacency.begin(), adjacency.end());
+      adjacency.erase(
+          std::unique(adjacency.begin(), adjacency.end()), adjacency.end());
+    }
   }
 
-  if (sideSetEquations.size() > 0) {
-    // iterator over all sideSet-defined equations
-    std::map<int, std::vector<std::string>>::iterator it;
-    for (it = sideSetEquations.begin(); it != sideSetEquations.end(); ++it) {
-      // Get the eq number
-      int eq = it->first;
-
-      // In case we only have equations on side sets (no "volume" eqns),
-      // there would be problem with linear solvers. To avoid this, we
-      // put one diagonal entry for every side set equation.
-      // NOTE: some nodes will be processed twice, but this is safe
-      //       in Tpetra_CrsGraph: the redundant indices will be discarded
-      for (std::size_t inode = 0; inode < overlapnodes.size(); ++inode) {
-        stk::mesh::Entity node = overlapnodes[inode];
-        row                    = getGlobalDOF(gid(node), it->first);
-        colAV                  = Teuchos::arrayView(&row, 1);
-        overlap_graphT->insertGlobalIndices(row, colAV);
-      }
+  // Exact number of entries of every row of the overlap graph
+  Teuchos::ArrayRCP<size_t> num_entries(overlap_mapT->getNodeNumElements(), 0);
 
-      // Number of side sets this eq is defined on
-      int numSideSets = it->second.size();
-      for (int ss(0); ss < numSideSets; ++ss) {
-        stk::mesh::Part& part =
-            *stkMeshStruct->ssPartVec.find(it->second[ss])->second;
-
-        // Get all owned sides in this side set
-        stk::mesh::Selector select_owned_in_sspart =
-            stk::mesh::Selector(part) &
-            stk::mesh::Selector(metaData.locally_owned_part());
-
-        std::vector<stk::mesh::Entity> sides;
-        stk::mesh::get_selected_entities(
-            select_owned_in_sspart,
-            bulkData.buckets(metaData.side_rank()),
-            sides);  // store the result in "sides"
-
-        // Loop on all the sides of this sideset
-        for (std::size_t localSideID = 0; localSideID < sides.size();
-             localSideID++) {
-          stk::mesh::Entity        sidee     = sides[localSideID];
-          stk::mesh::Entity const* node_rels = bulkData.begin_nodes(sidee);
-          const size_t             num_nodes = bulkData.num_nodes(sidee);
-
-          // loop over local nodes of the side (row)
-          for (std::size_t i = 0; i < num_nodes; i++) {
-            stk::mesh::Entity rowNode = node_rels[i];
-            row                       = getGlobalDOF(gid(rowNode), eq);
-
-            // loop over local nodes of the side (col)
-            for (std::size_t j = 0; j < num_nodes; j++) {
-              stk::mesh::Entity colNode = node_rels[j];
-
-              // loop on all the equations (the eq may be coupled with other
-              // eqns)
-              for (std::size_t m = 0; m < neq; m++) {
-                col   = getGlobalDOF(gid(colNode), m);
-                colAV = Teuchos::arrayView(&col, 1);
-                overlap_graphT->insertGlobalIndices(row, colAV);
-              }
-            }
-          }
-        }
+  for (LO inode = 0; inode < num_overlap_nodes; ++inode) {
+    const GO node_gid = overlap_node_mapT->getGlobalElement(inode);
+
+    for (std::size_t k = 0; k < globalEqns.size(); ++k) {
+      const LO row = overlap_mapT->getLocalElement(
+          getGlobalDOF(node_gid, globalEqns[k]));
+      num_entries[row] = node_adjacency[inode].size() * neq;
+    }
+    for (auto const& eq_adjacency : side_adjacency) {
+      const LO row = overlap_mapT->getLocalElement(
+          getGlobalDOF(node_gid, eq_adjacency.first));
+      num_entries[row] =
+          std::max<size_t>(eq_adjacency.second[inode].size() * neq, 1);
+    }
+  }
+
+  overlap_graphT = Teuchos::rcp(
+      new Tpetra_CrsGraph(overlap_mapT, num_entries.getConst(), profile));
+
+  Teuchos::Array<Tpetra_GO> cols;
+  for (LO inode = 0; inode < num_overlap_nodes; ++inode) {
+    const GO node_gid = overlap_node_mapT->getGlobalElement(inode);
+
+    insertNodeRows(node_gid, globalEqns, node_adjacency[inode], cols);
+
+    for (auto const& eq_adjacency : side_adjacency) {
+      const Tpetra_GO row = getGlobalDOF(node_gid, eq_adjacency.first);
+      if (eq_adjacency.second[inode].size() > 0) {
+        insertNodeRows(
+            node_gid,
+            std::vector<int>(1, eq_adjacency.first),
+            eq_adjacency.second[inode],
+            cols);
+      } else {
+        overlap_graphT->insertGlobalIndices(row, Teuchos::arrayView(&row, 1));
       }
     }
   }
 }
 
+void
+Albany::STKDiscretization::nodeAdjacency(
+    stk::mesh::Entity const node,
+    std::vector<GO>&        adjacency) const
+{
+  adjacency.clear();
+  stk::mesh::Entity const* elems     = bulkData.begin_elements(node);
+  const size_t             num_elems = bulkData.num_elements(node);
+  for (std::size_t i = 0; i < num_elems; ++i) {
+    if (!bulkData.bucket(elems[i]).owned()) continue;
+    stk::mesh::Entity const* node_rels = bulkData.begin_nodes(elems[i]);
+    const size_t             num_nodes = bulkData.num_nodes(elems[i]);
+    for (std::size_t j = 0; j < num_nodes; ++j) {
+      adjacency.push_back(gid(node_rels[j]));
+    }
+  }
+  std::sort(adjacency.begin(), adjacency.end());
+  adjacency.erase(
+      std::unique(adjacency.begin(), adjacency.end()), adjacency.end());
+}
+
+void
+Albany::STKDiscretization::insertNodeRows(
+    GO const                   node_gid,
+    std::vector<int> const&    eqns,
+    std::vector<GO> const&     adjacency,
+    Teuchos::Array<Tpetra_GO>& cols)
+{
+  if (adjacency.empty()) return;
+
+  // Insert each row with a single call
+  cols.resize(adjacency.size() * neq);
+  for (std::size_t l = 0; l < adjacency.size(); ++l) {
+    for (int m = 0; m < neq; ++m) {
+      cols[l * neq + m] = getGlobalDOF(adjacency[l], m);
+    }
+  }
+  for (auto eq : eqns) {
+    overlap_graphT->insertGlobalIndices(getGlobalDOF(node_gid, eq), cols());
+  }
+}
+
 void
 Albany::STKDiscretization::fillCompleteGraphs()
 {
@@ -1866,6 +2030,97 @@ Albany::STKDiscretization::fillCompleteGraphs()
   graphT->fillComplete();
 }
 
+void
+Albany::STKDiscretization::patchGraphs(
+    Teuchos::RCP<const Tpetra_CrsGraph> const& old_overlap_graph,
+    stk::mesh::EntityVector const&             changed_nodes)
+{
+  stk::mesh::Selector select_owned_in_part =
+      stk::mesh::Selector(metaData.universal_part()) &
+      stk::mesh::Selector(metaData.locally_owned_part());
+
+  stk::mesh::get_selected_entities(
+      select_owned_in_part,
+      bulkData.buckets(stk::topology::ELEMENT_RANK),
+      cells);
+
+  // Only the nodes of the elements touching a changed node can have gained
+  // or lost neighbors
+  std::set<GO> affected;
+  for (auto node : changed_nodes) {
+    if (!bulkData.is_valid(node)) continue;
+    stk::mesh::Entity const* elems     = bulkData.begin_elements(node);
+    const size_t             num_elems = bulkData.num_elements(node);
+    for (std::size_t i = 0; i < num_elems; ++i) {
+      stk::mesh::Entity const* node_rels = bulkData.begin_nodes(elems[i]);
+      const size_t             num_nodes = bulkData.num_nodes(elems[i]);
+      for (std::size_t j = 0; j < num_nodes; ++j) {
+        affected.insert(gid(node_rels[j]));
+      }
+    }
+  }
+
+  // Recompute the adjacency of the affected nodes and of the nodes that are
+  // new to this rank, as in computeGraphs. All the rows of a node have the
+  // same columns.
+  const Tpetra_LO invalid = Teuchos::OrdinalTraits<Tpetra_LO>::invalid();
+  const Tpetra_Map& old_rows = *old_overlap_graph->getRowMap();
+
+  std::map<GO, std::vector<GO>> adjacency;
+  for (auto node : overlapnodes) {
+    const GO node_gid = gid(node);
+    if (affected.count(node_gid) == 0 &&
+        old_rows.getLocalElement(getGlobalDOF(node_gid, 0)) != invalid) {
+      continue;
+    }
+    nodeAdjacency(node, adjacency[node_gid]);
+  }
+
+  // Exact number of entries of every row of the overlap graph
+  Teuchos::ArrayRCP<size_t> num_entries(overlap_mapT->getNodeNumElements(), 0);
+  for (auto node : overlapnodes) {
+    const GO   node_gid = gid(node);
+    const auto it       = adjacency.find(node_gid);
+    const size_t num_cols =
+        it != adjacency.end() ?
+            it->second.size() * neq :
+            old_overlap_graph->getNumEntriesInGlobalRow(
+                getGlobalDOF(node_gid, 0));
+    for (int k = 0; k < neq; ++k) {
+      num_entries[overlap_mapT->getLocalElement(getGlobalDOF(node_gid, k))] =
+          num_cols;
+    }
+  }
+
+  overlap_graphT = Teuchos::rcp(new Tpetra_CrsGraph(
+      overlap_mapT, num_entries.getConst(), Tpetra::StaticProfile));
+
+  std::vector<int> eqns(neq);
+  for (int k = 0; k < neq; ++k) eqns[k] = k;
+
+  Teuchos::Array<Tpetra_GO> cols;
+  for (auto node : overlapnodes) {
+    const GO   node_gid = gid(node);
+    const auto it       = adjacency.find(node_gid);
+    if (it != adjacency.end()) {
+      insertNodeRows(node_gid, eqns, it->second, cols);
+      continue;
+    }
+
+    // Unchanged row: copy it from the old graph
+    const Tpetra_GO row      = getGlobalDOF(node_gid, 0);
+    size_t          num_cols = 0;
+    cols.resize(old_overlap_graph->getNumEntriesInGlobalRow(row));
+    old_overlap_graph->getGlobalRowCopy(row, cols(), num_cols);
+    if (cols.size() == 0) continue;
+    for (int k = 0; k < neq; ++k) {
+      overlap_graphT->insertGlobalIndices(getGlobalDOF(node_gid, k), cols());
+    }
+  }
+
+  fillCompleteGraphs();
+}
+
 void
 Albany::STKDiscretization::insertPeridigmNonzerosIntoGraph()
 {
@@ -1880,8 +2135,9 @@ Albany::STKDiscretization::insertPeridigmNonzerosIntoGraph()
     Teuchos::RCP<const Epetra_FECrsMatrix> peridigmMatrix =
         LCM::PeridigmManager::self()->getTangentStiffnessMatrix();
 
-    // Allocate nonzeros for the standard FEM portion of the graph
-    computeGraphsUpToFillComplete();
+    // Allocate nonzeros for the standard FEM portion of the graph. The rows
+    // grow below, so they are not statically allocated.
+    computeGraphsUpToFillComplete(Tpetra::DynamicProfile);
 
     // Allocate nonzeros for the peridynamic portion of the graph
     int                    peridigmLocalRow;
@@ -1916,9 +2172,114 @@ Albany::STKDiscretization::insertPeridigmNonzerosIntoGraph()
 #endif
 }
 
+void
+Albany::STKDiscretization::syncSwappedStateFields()
+{
+  // After an odd number of swaps, the "_old" array of a state views the mesh
+  // field of the new state, which therefore holds the latest old values. The
+  // rebuilt arrays view their own fields again, so copy those values over.
+  // This goes through the fields, since the mesh may have changed under the
+  // old arrays.
+  auto sync = [&](std::map<std::string, bool>& swapped,
+                  stk::mesh::EntityRank const  rank) {
+    for (auto const& it : swapped) {
+      if (!it.second) continue;
+      stk::mesh::FieldBase const* field = metaData.get_field(rank, it.first);
+      stk::mesh::FieldBase const* field_old =
+          metaData.get_field(rank, it.first + "_old");
+      // Nodal states gathered to the elements only have nodal fields
+      if (field == nullptr || field_old == nullptr) continue;
+      for (auto const* buck : bulkData.buckets(rank)) {
+        unsigned const bytes =
+            stk::mesh::field_bytes_per_entity(*field, *buck) * buck->size();
+        if (bytes == 0) continue;
+        std::memcpy(
+            stk::mesh::field_data(*field_old, *buck),
+            stk::mesh::field_data(*field, *buck),
+            bytes);
+      }
+    }
+    swapped.clear();
+  };
+  sync(stateArrays.swappedElemStates, stk::topology::ELEMENT_RANK);
+  sync(stateArrays.swappedNodeStates, stk::topology::NODE_RANK);
+}
+
+void
+Albany::STKDiscretization::fillNodalStateArrays(
+    stk::mesh::Bucket const& buck,
+    int const                b)
+{
+  typedef AbstractSTKFieldContainer::ScalarFieldType ScalarFieldType;
+  typedef AbstractSTKFieldContainer::VectorFieldType VectorFieldType;
+  typedef AbstractSTKFieldContainer::TensorFieldType TensorFieldType;
+
+  const Albany::StateInfoStruct& nodal_states =
+      stkMeshStruct->getFieldContainer()->getNodalSIS();
+
+  for (int is = 0; is < nodal_states.size(); ++is) {
+    const std::string&                    name = nodal_states[is]->name;
+    const Albany::StateStruct::FieldDims& dim  = nodal_states[is]->dim;
+    MDArray& array = stateArrays.elemStateArrays[b][name];
+    int      dim0  = buck.size();  // may be different from dim[0];
+    switch (dim.size()) {
+      case 2:  // scalar
+      {
+        const ScalarFieldType& field = *metaData.get_field<ScalarFieldType>(
+            stk::topology::NODE_RANK, name);
+        for (int i = 0; i < dim0; i++) {
+          stk::mesh::Entity        element = buck[i];
+          stk::mesh::Entity const* rel     = bulkData.begin_nodes(element);
+          for (int j = 0; j < dim[1]; j++) {
+            stk::mesh::Entity rowNode = rel[j];
+            array(i, j) = *stk::mesh::field_data(field, rowNode);
+          }
+        }
+        break;
+      }
+      case 3:  // vector
+      {
+        const VectorFieldType& field = *metaData.get_field<VectorFieldType>(
+            stk::topology::NODE_RANK, name);
+        for (int i = 0; i < dim0; i++) {
+          stk::mesh::Entity        element = buck[i];
+          stk::mesh::Entity const* rel     = bulkData.begin_nodes(element);
+          for (int j = 0; j < dim[1]; j++) {
+            stk::mesh::Entity rowNode = rel[j];
+            double*           entry = stk::mesh::field_data(field, rowNode);
+            for (int k = 0; k < dim[2]; k++) array(i, j, k) = entry[k];
+          }
+        }
+        break;
+      }
+      case 4:  // tensor
+      {
+        const TensorFieldType& field = *metaData.get_field<TensorFieldType>(
+            stk::topology::NODE_RANK, name);
+        for (int i = 0; i < dim0; i++) {
+          stk::mesh::Entity        element = buck[i];
+          stk::mesh::Entity const* rel     = bulkData.begin_nodes(element);
+          for (int j = 0; j < dim[1]; j++) {
+            stk::mesh::Entity rowNode = rel[j];
+            double*           entry = stk::mesh::field_data(field, rowNode);
+            for (int k = 0; k < dim[2]; k++)
+              for (int l = 0; l < dim[3]; l++)
+                array(i, j, k, l) = entry[k * dim[3] + l];  // check this,
+                                                            // is stride
+                                                            // Correct?
+          }
+        }
+        break;
+      }
+    }
+  }
+}
+
 void
 Albany::STKDiscretization::computeWorksetInfo()
 {
+  syncSwappedStateFields();
+
   stk::mesh::Selector select_owned_in_part =
       stk::mesh::Selector(metaData.universal_part()) &
       stk::mesh::Selector(metaData.locally_owned_part());
@@ -2026,63 +2387,23 @@ Albany::STKDiscretization::computeWorksetInfo()
         int                  dim0 = buck.size();  // may be different from dim[0];
         switch (dim.size()) {
           case 2:  // scalar
-          {
-            const ScalarFieldType& field = *metaData.get_field<ScalarFieldType>(
-                stk::topology::NODE_RANK, name);
             stateVec.resize(dim0 * dim[1]);
             array.assign<ElemTag, NodeTag>(stateVec.data(), dim0, dim[1]);
-            for (int i = 0; i < dim0; i++) {
-              stk::mesh::Entity        element = buck[i];
-              stk::mesh::Entity const* rel     = bulkData.begin_nodes(element);
-              for (int j = 0; j < dim[1]; j++) {
-                stk::mesh::Entity rowNode = rel[j];
-                array(i, j) = *stk::mesh::field_data(field, rowNode);
-              }
-            }
             break;
-          }
           case 3:  // vector
-          {
-            const VectorFieldType& field = *metaData.get_field<VectorFieldType>(
-                stk::topology::NODE_RANK, name);
             stateVec.resize(dim0 * dim[1] * dim[2]);
             array.assign<ElemTag, NodeTag, CompTag>(
                 stateVec.data(), dim0, dim[1], dim[2]);
-            for (int i = 0; i < dim0; i++) {
-              stk::mesh::Entity        element = buck[i];
-              stk::mesh::Entity const* rel     = bulkData.begin_nodes(element);
-              for (int j = 0; j < dim[1]; j++) {
-                stk::mesh::Entity rowNode = rel[j];
-                double*           entry = stk::mesh::field_data(field, rowNode);
-                for (int k = 0; k < dim[2]; k++) array(i, j, k) = entry[k];
-              }
-            }
             break;
-          }
           case 4:  // tensor
-          {
-            const TensorFieldType& field = *metaData.get_field<TensorFieldType>(
-                stk::topology::NODE_RANK, name);
             stateVec.resize(dim0 * dim[1] * dim[2] * dim[3]);
             array.assign<ElemTag, NodeTag, CompTag, CompTag>(
                 stateVec.data(), dim0, dim[1], dim[2], dim[3]);
-            for (int i = 0; i < dim0; i++) {
-              stk::mesh::Entity        element = buck[i];
-              stk::mesh::Entity const* rel     = bulkData.begin_nodes(element);
-              for (int j = 0; j < dim[1]; j++) {
-                stk::mesh::Entity rowNode = rel[j];
-                double*           entry = stk::mesh::field_data(field, rowNode);
-                for (int k = 0; k < dim[2]; k++)
-                  for (int l = 0; l < dim[3]; l++)
-                    array(i, j, k, l) = entry[k * dim[3] + l];  // check this,
-                                                                // is stride
-                                                                // Correct?
-              }
-            }
             break;
-          }
         }
       }
+
+      fillNodalStateArrays(buck, b);
     }
 
 #if defined(ALBANY_LCM)
@@ -2380,6 +2701,8 @@ Albany::STKDiscretization::computeWorksetInfo()
       }
     }
   }
+
+  Albany::indexStateArrays(stateArrays);
 }
 
 void
@@ -2642,6 +2965,8 @@ void
 Albany::STKDiscretization::setupExodusOutput()
 {
 #ifdef ALBANY_SEACAS
+  AsyncOutputQueue::instance().flush();
+
   if (stkMeshStruct->exoOutput) {
     outputInterval = 0;
 
@@ -2652,6 +2977,36 @@ Albany::STKDiscretization::setupExodusOutput()
     mesh_data = Teuchos::rcp(
         new stk::io::StkMeshIoBroker(Albany::getMpiCommFromTeuchosComm(commT)));
     mesh_data->set_bulk_data(bulkData);
+
+    // The copies for Asynchronous Output are only written in place of their
+    // fields. A transient field declared after them has no copy, and then
+    // the output is written synchronously.
+    std::set<const stk::mesh::FieldBase*> async_copies;
+    for (const auto& it : stkMeshStruct->asyncOutputFields)
+      async_copies.insert(it.second);
+    if (stkMeshStruct->asyncOutput) {
+      std::set<const stk::mesh::FieldBase*> copied;
+      for (const auto& it : stkMeshStruct->asyncOutputFields)
+        copied.insert(it.first);
+      for (const stk::mesh::FieldBase* field : metaData.get_fields()) {
+        const Ioss::Field::RoleType* role = stk::io::get_field_role(*field);
+        if (role == NULL || *role != Ioss::Field::TRANSIENT) continue;
+        if (copied.count(field) > 0 || async_copies.count(field) > 0) continue;
+        if (commT->getRank() == 0)
+          *out << "\nWARNING: field " << field->name() << " was declared "
+               << "after the Asynchronous Output copies: writing the Exodus "
+               << "output synchronously.\n"
+               << std::endl;
+        stkMeshStruct->asyncOutput = false;
+        break;
+      }
+    }
+
+    if (stkMeshStruct->asyncOutput) {
+      // The output thread of each rank writes its steps on its own, which
+      // needs one file per process
+      mesh_data->property_add(Ioss::Property("COMPOSE_RESULTS", 0));
+    }
     outputFileIdx = mesh_data->create_output_mesh(str, stk::io::WRITE_RESULTS);
 
     // Adding mesh global variables
@@ -2667,8 +3022,20 @@ Albany::STKDiscretization::setupExodusOutput()
           outputFileIdx, it.first, mvs, stk::util::ParameterType::INTEGER);
     }
 
+    if (stkMeshStruct->asyncOutput) {
+      // Output the copies of the fields, under the names of the originals
+      for (const auto& it : stkMeshStruct->asyncOutputFields) {
+        try {
+          mesh_data->add_field(outputFileIdx, *it.second, it.first->name());
+        } catch (std::runtime_error const&) {
+        }
+      }
+      return;
+    }
+
     const stk::mesh::FieldVector& fields = mesh_data->meta_data().get_fields();
     for (size_t i = 0; i < fields.size(); i++) {
+      if (async_copies.count(fields[i]) > 0) continue;
       // Hacky, but doesn't appear to be a way to query if a field is already
       // going to be output.
       try {
@@ -2686,6 +3053,68 @@ Albany::STKDiscretization::setupExodusOutput()
 #endif
 }
 
+int
+Albany::STKDiscretization::writeExodusOutputStep(const double time_label)
+{
+#ifdef ALBANY_SEACAS
+  mesh_data->begin_output_step(outputFileIdx, time_label);
+  int out_step = mesh_data->write_defined_output_fields(outputFileIdx);
+  // Writing mesh global variables
+  for (auto& it : stkMeshStruct->getFieldContainer()->getMeshVectorStates()) {
+    mesh_data->write_global(outputFileIdx, it.first, it.second);
+  }
+  for (auto& it :
+       stkMeshStruct->getFieldContainer()->getMeshScalarIntegerStates()) {
+    mesh_data->write_global(outputFileIdx, it.first, it.second);
+  }
+  mesh_data->end_output_step(outputFileIdx);
+  return out_step;
+#else
+  return 0;
+#endif
+}
+
+std::function<void()>
+Albany::STKDiscretization::snapshotExodusOutputStep(const double time_label)
+{
+#ifdef ALBANY_SEACAS
+  // The previous step has been written (writeSolution flushes the output
+  // queue first), so the copies are free to overwrite
+  for (const auto& it : stkMeshStruct->asyncOutputFields) {
+    const stk::mesh::FieldBase& field = *it.first;
+    const stk::mesh::FieldBase& copy  = *it.second;
+    for (const stk::mesh::Bucket* bucket :
+         bulkData.buckets(field.entity_rank())) {
+      const unsigned bytes =
+          stk::mesh::field_bytes_per_entity(field, *bucket);
+      if (bytes == 0) continue;
+      std::memcpy(
+          stk::mesh::field_data(copy, *bucket),
+          stk::mesh::field_data(field, *bucket),
+          bytes * bucket->size());
+    }
+  }
+
+  // The mesh global variables are copied into the task
+  stk::io::StkMeshIoBroker* const io  = mesh_data.get();
+  const size_t                    idx = outputFileIdx;
+  AbstractSTKFieldContainer::MeshVectorState vector_states =
+      stkMeshStruct->getFieldContainer()->getMeshVectorStates();
+  AbstractSTKFieldContainer::MeshScalarIntegerState integer_states =
+      stkMeshStruct->getFieldContainer()->getMeshScalarIntegerStates();
+
+  return [io, idx, time_label, vector_states, integer_states]() mutable {
+    io->begin_output_step(idx, time_label);
+    io->write_defined_output_fields(idx);
+    for (auto& it : vector_states) io->write_global(idx, it.first, it.second);
+    for (auto& it : integer_states) io->write_global(idx, it.first, it.second);
+    io->end_output_step(idx);
+  };
+#else
+  return std::function<void()>();
+#endif
+}
+
 namespace {
 const std::vector<double>
 spherical_to_cart(const std::pair<double, double>& sphere)
@@ -3285,6 +3714,8 @@ Albany::STKDiscretization::reNameExodusOutput(std::string& filename)
 {
 #ifdef ALBANY_SEACAS
   if (stkMeshStruct->exoOutput && !mesh_data.is_null()) {
+    AsyncOutputQueue::instance().flush();
+
     // Delete the mesh data object and recreate it
     mesh_data = Teuchos::null;
 
@@ -3569,6 +4000,53 @@ Albany::STKDiscretization::buildSideSetProjectors()
 void
 Albany::STKDiscretization::updateMesh()
 {
+  updateMeshImpl(nullptr);
+}
+
+void
+Albany::STKDiscretization::updateMesh(
+    stk::mesh::EntityVector const& changed_nodes)
+{
+  updateMeshImpl(&changed_nodes);
+}
+
+void
+Albany::STKDiscretization::updateCoordinates()
+{
+  ++coordinatesGeneration;
+
+  // Same order as in updateMeshImpl
+  setupMLCoords();
+  transformMesh();
+
+  // The nodal states seen by the worksets are copies of the STK fields, so
+  // new input values must be copied again
+  stk::mesh::Selector select_owned_in_part =
+      stk::mesh::Selector(metaData.universal_part()) &
+      stk::mesh::Selector(metaData.locally_owned_part());
+
+  stk::mesh::BucketVector const& buckets =
+      bulkData.get_buckets(stk::topology::ELEMENT_RANK, select_owned_in_part);
+
+  for (int b = 0; b < buckets.size(); b++) {
+    fillNodalStateArrays(*buckets[b], b);
+  }
+}
+
+void
+Albany::STKDiscretization::updateMeshImpl(
+    stk::mesh::EntityVector const* changed_nodes)
+{
+  // The coordinates may have moved, or have been transformed again
+  ++coordinatesGeneration;
+
+  // The old graph is patched if possible. With side set equations the rows
+  // of a node differ by equation, so they are all recomputed.
+  Teuchos::RCP<const Tpetra_CrsGraph> old_overlap_graph = overlap_graphT;
+  const bool patch_graphs = changed_nodes != nullptr &&
+                            Teuchos::nonnull(old_overlap_graph) &&
+                            sideSetEquations.empty();
+
   const Albany::StateInfoStruct& nodal_param_states =
       stkMeshStruct->getFieldContainer()->getNodalParameterSIS();
   nodalDOFsStructContainer.addEmptyDOFsStruct("ordinary_solution", "", neq);
@@ -3604,7 +4082,11 @@ Albany::STKDiscretization::updateMesh()
 
   transformMesh();
 
-  computeGraphs();
+  if (patch_graphs) {
+    patchGraphs(old_overlap_graph, *changed_nodes);
+  } else {
+    computeGraphs();
+  }
 
   computeWorksetInfo();
 #ifdef OUTPUT_TO_SCREEN
@@ -7,6 +7,7 @@
 #ifndef ALBANY_STKDISCRETIZATION_HPP
 #define ALBANY_STKDISCRETIZATION_HPP
 
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -30,6 +31,7 @@
 #include <stk_mesh/base/Types.hpp>
 #include <stk_util/parallel/Parallel.hpp>
 #ifdef ALBANY_SEACAS
+#include <stk_io/IossBridge.hpp>
 #include <stk_io/StkMeshIoBroker.hpp>
 #endif
 
@@ -277,6 +279,11 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   getCoordinates() const;
   void
   setCoordinates(const Teuchos::ArrayRCP<const double>& c);
+  unsigned int
+  getCoordinatesGeneration() const
+  {
+    return coordinatesGeneration;
+  }
   void
   setReferenceConfigurationManager(
       const Teuchos::RCP<AAdapt::rc::Manager>& rcm);
@@ -305,6 +312,7 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   setStateArrays(Albany::StateArrays& sa)
   {
     stateArrays = sa;
+    Albany::indexStateArrays(stateArrays);
     return;
   }
 
@@ -492,6 +500,22 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   void
   updateMesh();
 
+  //! After a local mesh modification that only changed the elements around
+  //! changed_nodes (e.g., nodes split to open faces). The graph rows of the
+  //! nodes away from them keep their columns and are copied, instead of
+  //! being recomputed from all the elements. Everything else is rebuilt as
+  //! in updateMesh(): the maps, the worksets, the node and side sets, and
+  //! the state arrays, which are not remapped from the old ones.
+  void
+  updateMesh(stk::mesh::EntityVector const& changed_nodes);
+
+  //! After the node coordinates and nodal input fields were changed in
+  //! place, with the same connectivity: transform the mesh again, pass the
+  //! new coordinates to the preconditioner and copy the nodal states to the
+  //! worksets again. The graphs and worksets are kept.
+  void
+  updateCoordinates();
+
   //! Function that transforms an STK mesh of a unit cube (for LandIce problems)
   void
   transformMesh();
@@ -636,9 +660,16 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   //! Process STK mesh for Overlap nodal quantitites
   void
   computeOverlapNodesAndUnknowns();
+  //! Undo the swaps of old states on the mesh fields, before the state
+  //! arrays are rebuilt on them
+  void
+  syncSwappedStateFields();
   //! Process STK mesh for Workset/Bucket Info
   void
   computeWorksetInfo();
+  //! Copy the nodal state fields to the element-node arrays of workset b
+  void
+  fillNodalStateArrays(stk::mesh::Bucket const& buck, int const b);
   //! Process STK mesh for NodeSets
   void
   computeNodeSets();
@@ -648,6 +679,13 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   //! Call stk_io for creating exodus output file
   void
   setupExodusOutput();
+  //! Write the output fields and mesh global variables as an Exodus step
+  int
+  writeExodusOutputStep(const double time_label);
+  //! Copy the output fields to the copies the output database reads, and
+  //! return the task that writes the step from them (Asynchronous Output)
+  std::function<void()>
+  snapshotExodusOutputStep(const double time_label);
   //! Call stk_io for creating NetCDF output file
   void
   setupNetCDFOutput();
@@ -747,6 +785,8 @@ class STKDiscretization : public Albany::AbstractDiscretization {
       wsElNodeID;
 
   mutable Teuchos::ArrayRCP<double>       coordinates;
+  //! Incremented on every mesh update
+  unsigned int                            coordinatesGeneration{0};
   Teuchos::RCP<Tpetra_MultiVector>        coordMV;
   Albany::WorksetArray<std::string>::type wsEBNames;
   Albany::WorksetArray<int>::type         wsPhysIndex;
@@ -862,9 +902,36 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   printVertexConnectivity();
 
   void
-  computeGraphsUpToFillComplete();
+  computeGraphsUpToFillComplete(
+      Tpetra::ProfileType const profile = Tpetra::StaticProfile);
   void
   fillCompleteGraphs();
+
+  //! Global ids of the nodes sharing a locally owned element with node,
+  //! sorted and unique
+  void
+  nodeAdjacency(stk::mesh::Entity const node, std::vector<GO>& adjacency) const;
+
+  //! Insert the overlap graph rows of eqns at a node. Every row gets all the
+  //! eqns of the adjacent nodes as columns.
+  void
+  insertNodeRows(
+      GO const                   node_gid,
+      std::vector<int> const&    eqns,
+      std::vector<GO> const&     adjacency,
+      Teuchos::Array<Tpetra_GO>& cols);
+
+  //! Rebuild the graphs after a local mesh modification, only recomputing
+  //! the rows of the nodes sharing an element with changed_nodes and of the
+  //! nodes new to this rank. The other rows are still copied one by one, so
+  //! the cost stays linear in the size of the graph.
+  void
+  patchGraphs(
+      Teuchos::RCP<const Tpetra_CrsGraph> const& old_overlap_graph,
+      stk::mesh::EntityVector const&             changed_nodes);
+
+  void
+  updateMeshImpl(stk::mesh::EntityVector const* changed_nodes);
 };
 }
 
@@ -59,8 +59,14 @@ void GatherCoordinateVector<EvalT, Traits>::postRegistrationSetup(typename Trait
   numVertices = dims[1];
   numDim = dims[2];
 
-  d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields());
-  if (d.memoizer_active()) memoizer.enable_memoizer();
+  // With a displacement the coordinates move with the solution, so neither
+  // they nor anything computed from them can be memoized
+  d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields(),
+                            dispVecName.is_null());
+  if (d.memoizer_active()) {
+    memoizer.enable_memoizer();
+    memoizer.memoize_field(coordVec);
+  }
 }
 
 // **********************************************************************
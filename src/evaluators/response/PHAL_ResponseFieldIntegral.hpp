@@ -14,8 +14,9 @@ namespace PHAL {
  * \brief Response Description
  */
   template<typename EvalT, typename Traits>
-  class ResponseFieldIntegral : 
-    public PHAL::SeparableScatterScalarResponse<EvalT,Traits>
+  class ResponseFieldIntegral :
+    public PHAL::SeparableScatterScalarResponse<EvalT,Traits>,
+    public PHAL::SumOverRanksResponse
   {
   public:
     typedef typename EvalT::ScalarT ScalarT;
@@ -17,8 +17,9 @@ namespace PHAL {
  * temperature. 
  */
   template<typename EvalT, typename Traits>
-  class ResponseThermalEnergy : 
-    public PHAL::SeparableScatterScalarResponse<EvalT,Traits>
+  class ResponseThermalEnergy :
+    public PHAL::SeparableScatterScalarResponse<EvalT,Traits>,
+    public PHAL::SumOverRanksResponse
   {
   public:
     typedef typename EvalT::ScalarT ScalarT;
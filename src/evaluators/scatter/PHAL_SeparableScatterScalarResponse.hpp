@@ -15,6 +15,18 @@
 
 namespace PHAL {
 
+/** \brief Marks response evaluators whose global response is the plain sum
+ * of the rank contributions.
+ *
+ * Such evaluators only reduce the local response with REDUCE_SUM over
+ * workset.comm in postEvaluate, so several of them can be evaluated in one
+ * pass and reduced together (see Albany::FusedScalarResponseFunction).
+ */
+class SumOverRanksResponse {
+public:
+  virtual ~SumOverRanksResponse() {}
+};
+
 /** \brief Handles scattering of separable scalar response functions into epetra
  * data structures.
  *
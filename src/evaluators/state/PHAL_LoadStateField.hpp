@@ -38,7 +38,10 @@ private:
   PHX::MDField<ScalarType> data;
   std::string fieldName;
   std::string stateName;
+  Albany::StateHandle stateHandle;
 
+  // Keep the loaded data of every workset (input-only states)
+  bool memoize;
   MDFieldMemoizer<Traits> memoizer;
 };
 
@@ -62,7 +65,10 @@ private:
   PHX::MDField<ParamScalarT> data;
   std::string fieldName;
   std::string stateName;
+  Albany::StateHandle stateHandle;
 
+  // Keep the loaded data of every workset (input-only states)
+  bool memoize;
   MDFieldMemoizer<Traits> memoizer;
 };
 
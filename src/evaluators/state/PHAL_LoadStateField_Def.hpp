@@ -21,6 +21,8 @@ LoadStateFieldBase(const Teuchos::ParameterList& p)
 {
   fieldName =  p.get<std::string>("Field Name");
   stateName =  p.get<std::string>("State Name");
+  stateHandle = Albany::getStateHandle(stateName);
+  memoize = p.isParameter("Memoize") && p.get<bool>("Memoize");
 
   PHX::MDField<ScalarType> f(fieldName, p.get<Teuchos::RCP<PHX::DataLayout> >("State Field Layout") );
   data = f;
@@ -37,7 +39,10 @@ void LoadStateFieldBase<EvalT, Traits, ScalarType>::postRegistrationSetup(typena
   this->utils.setFieldData(data,fm);
 
   d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields());
-  if (d.memoizer_active()) memoizer.enable_memoizer();
+  if (d.memoizer_active()) {
+    memoizer.enable_memoizer();
+    if (memoize) memoizer.memoize_field(data);
+  }
 }
 
 // **********************************************************************
@@ -49,10 +54,12 @@ void LoadStateFieldBase<EvalT, Traits, ScalarType>::evaluateFields(typename Trai
   //cout << "LoadStateFieldBase importing state " << stateName << " to field "
   //     << fieldName << " with size " << data.size() << endl;
 
-  const Albany::MDArray& stateToLoad = (*workset.stateArrayPtr)[stateName];
+  // A state missing from this workset loads as zero
+  const Albany::MDArray* stateToLoad = workset.stateTablePtr->get(stateHandle);
+  const int size = stateToLoad ? stateToLoad->size() : 0;
   PHAL::MDFieldIterator<ScalarType> d(data);
-  for (int i = 0; ! d.done() && i < stateToLoad.size(); ++d, ++i)
-    *d = stateToLoad[i];
+  for (int i = 0; ! d.done() && i < size; ++d, ++i)
+    *d = (*stateToLoad)[i];
   for ( ; ! d.done(); ++d) *d = 0.;
 }
 
@@ -62,6 +69,8 @@ LoadStateField(const Teuchos::ParameterList& p)
 {
   fieldName =  p.get<std::string>("Field Name");
   stateName =  p.get<std::string>("State Name");
+  stateHandle = Albany::getStateHandle(stateName);
+  memoize = p.isParameter("Memoize") && p.get<bool>("Memoize");
 
   PHX::MDField<ParamScalarT> f(fieldName, p.get<Teuchos::RCP<PHX::DataLayout> >("State Field Layout") );
   data = f;
@@ -78,7 +87,10 @@ void LoadStateField<EvalT, Traits>::postRegistrationSetup(typename Traits::Setup
   this->utils.setFieldData(data,fm);
 
   d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields());
-  if (d.memoizer_active()) memoizer.enable_memoizer();
+  if (d.memoizer_active()) {
+    memoizer.enable_memoizer();
+    if (memoize) memoizer.memoize_field(data);
+  }
 }
 
 // **********************************************************************
@@ -90,10 +102,12 @@ void LoadStateField<EvalT, Traits>::evaluateFields(typename Traits::EvalData wor
   //cout << "LoadStateField importing state " << stateName << " to field " 
   //     << fieldName << " with size " << data.size() << endl;
 
-  const Albany::MDArray& stateToLoad = (*workset.stateArrayPtr)[stateName];
+  // A state missing from this workset loads as zero
+  const Albany::MDArray* stateToLoad = workset.stateTablePtr->get(stateHandle);
+  const int size = stateToLoad ? stateToLoad->size() : 0;
   PHAL::MDFieldIterator<ParamScalarT> d(data);
-  for (int i = 0; ! d.done() && i < stateToLoad.size(); ++d, ++i)
-    *d = stateToLoad[i];
+  for (int i = 0; ! d.done() && i < size; ++d, ++i)
+    *d = (*stateToLoad)[i];
   for ( ; ! d.done(); ++d) *d = 0.;
 }
 
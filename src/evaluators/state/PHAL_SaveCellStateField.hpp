@@ -63,6 +63,7 @@ private:
   PHX::MDField<const MeshScalarT,Cell,QuadPoint> weights;
   std::string fieldName;
   std::string stateName;
+  Albany::StateHandle stateHandle;
   int i_index;
   int j_index;
   int k_index;
@@ -66,6 +66,7 @@ private:
   PHX::MDField<const ScalarT> field;
   std::string fieldName;
   std::string stateName;
+  Albany::StateHandle stateHandle;
 
   bool nodalState;
   bool worksetState;
@@ -48,6 +48,7 @@ SaveStateField(const Teuchos::ParameterList& p)
 {
   fieldName =  p.get<std::string>("Field Name");
   stateName =  p.get<std::string>("State Name");
+  stateHandle = Albany::getStateHandle(stateName);
 
   Teuchos::RCP<PHX::DataLayout> layout = p.get<Teuchos::RCP<PHX::DataLayout> >("State Field Layout");
   field = decltype(field)(fieldName, layout );
@@ -108,13 +109,12 @@ saveElemState(typename Traits::EvalData workset)
 {
   // Get shards Array (from STK) for this state
   // Need to check if we can just copy full size -- can assume same ordering?
-  Albany::StateArray::const_iterator it;
-  it = workset.stateArrayPtr->find(stateName);
+  const Albany::MDArray* it = workset.stateTablePtr->get(stateHandle);
 
-  TEUCHOS_TEST_FOR_EXCEPTION((it == workset.stateArrayPtr->end()), std::logic_error,
+  TEUCHOS_TEST_FOR_EXCEPTION((it == nullptr), std::logic_error,
          std::endl << "Error: cannot locate " << stateName << " in PHAL_SaveStateField_Def" << std::endl);
 
-  Albany::MDArray sta = it->second;
+  Albany::MDArray sta = *it;
   std::vector<PHX::DataLayout::size_type> dims;
   sta.dimensions(dims);
   int size = dims.size();
@@ -162,13 +162,12 @@ saveWorksetState(typename Traits::EvalData workset)
 {
   // Get shards Array (from STK) for this state
   // Need to check if we can just copy full size -- can assume same ordering?
-  Albany::StateArray::const_iterator it;
-  it = workset.stateArrayPtr->find(stateName);
+  const Albany::MDArray* it = workset.stateTablePtr->get(stateHandle);
 
-  TEUCHOS_TEST_FOR_EXCEPTION((it == workset.stateArrayPtr->end()), std::logic_error,
+  TEUCHOS_TEST_FOR_EXCEPTION((it == nullptr), std::logic_error,
          std::endl << "Error: cannot locate " << stateName << " in PHAL_SaveStateField_Def" << std::endl);
 
-  Albany::MDArray sta = it->second;
+  Albany::MDArray sta = *it;
   std::vector<PHX::DataLayout::size_type> dims;
   sta.dimensions(dims);
   int size = dims.size();
@@ -24,6 +24,10 @@ namespace PHAL {
 
     This evaluator interpolates nodal DOF values to quad points.
 
+    With "Use MDField Memoization", the evaluated fields of every workset
+    are saved and copied back until the coordinates or the parameters
+    change (see PHAL::MDFieldMemoizer).
+
 */
 template<typename EvalT, typename Traits>
 class ComputeBasisFunctions : public PHX::EvaluatorWithBaseImpl<Traits>,
@@ -81,6 +81,12 @@ postRegistrationSetup(typename Traits::SetupData d,
 
   d.fill_field_dependencies(this->dependentFields(),this->evaluatedFields());
   if (d.memoizer_active()) memoizer.enable_memoizer();
+  memoizer.memoize_field(weighted_measure);
+  memoizer.memoize_field(jacobian_det);
+  memoizer.memoize_field(BF);
+  memoizer.memoize_field(wBF);
+  memoizer.memoize_field(GradBF);
+  memoizer.memoize_field(wGradBF);
 }
 
 //**********************************************************************
@@ -154,10 +154,19 @@ Albany::AbstractProblem::getGenericProblemParams(std::string listname) const
   validPL->set<int>("Number Of Time Derivatives", 1, "Number of time derivatives in use in the problem");
 
   validPL->set<bool>("Use MDField Memoization", false, "Use memoization to avoid recomputing MDFields");
+  validPL->set<int>("Workset Fill Threads", 1, "Number of threads evaluating worksets concurrently in residual and Jacobian fills (builds with ALBANY_THREADED_FILL only)");
+  validPL->set<std::string>("Evaluator Profile File", "", "Write time, calls, cells and estimated bytes of each evaluator to this .csv or .json file after the solve");
+  validPL->set<bool>("Swap Old States", false, "Update old states by swapping arrays; their mesh fields are only synchronized when written. STK discretizations only: other discretizations throw");
   validPL->set<bool>("Ignore Residual In Jacobian", false,
                      "Ignore residual calculations while computing the Jacobian (only generally appropriate for linear problems)");
   validPL->set<double>("Perturb Dirichlet", 0.0,
                      "Add this (small) perturbation to the diagonal to prevent Mass Matrices from being singular for Dirichlets)");
+  validPL->set<bool>("Constant Jacobian", false,
+                     "The Jacobian only depends on the mesh, the parameters and the time step: assemble dF/dx, dF/dxdot and dF/dxdotdot once and recombine them at every fill (Tpetra builds only)");
+  validPL->set<bool>("Matrix-Free Jacobian", false,
+                     "Do not assemble the Jacobian: apply it with a Tangent fill (requires a solver that only applies W, e.g. Belos)");
+  validPL->set<std::string>("Matrix-Free Preconditioner", "None",
+                     "Preconditioner supplied with the matrix-free Jacobian: None or Block Jacobi (inverse of the node blocks of the Jacobian)");
 
   validPL->sublist("Model Order Reduction", false, "Specify the options relative to model order reduction");
 
@@ -8,6 +8,7 @@
 #include "Albany_FieldManagerScalarResponseFunction.hpp"
 #include <algorithm>
 #include "PHAL_Utilities.hpp"
+#include "PHAL_SeparableScatterScalarResponse.hpp"
 
 #include "Albany_TpetraThyraUtils.hpp"
 #include "Albany_DistributedParameterLibrary.hpp"
@@ -24,6 +25,7 @@ FieldManagerScalarResponseFunction(
   problem(problem_),
   meshSpecs(meshSpecs_),
   stateMgr(stateMgr_),
+  sum_separable(false),
   performedPostRegSetup(false)
 {
   setup(responseParams);
@@ -40,6 +42,7 @@ FieldManagerScalarResponseFunction(
   problem(problem_),
   meshSpecs(meshSpecs_),
   stateMgr(stateMgr_),
+  sum_separable(false),
   performedPostRegSetup(false)
 {
 }
@@ -92,6 +95,20 @@ setup(Teuchos::ParameterList& responseParams)
   vis_response_graph = 
     responseParams.get("Phalanx Graph Visualization Detail", 0);
   vis_response_name = responseParams.get<std::string>("Name");
+
+  // The response can be evaluated in a fused pass if the evaluator of the
+  // response field says its global value is a sum over the ranks
+  sum_separable = false;
+  const auto& nodes = rfm->getDagManager<PHAL::AlbanyTraits::Residual>().getDagNodes();
+  for (const auto& node : nodes) {
+    const auto evaluator = node.get();
+    for (const auto& tag : evaluator->evaluatedFields()) {
+      if (tag->identifier() == tags[0]->identifier()) {
+        sum_separable =
+          dynamic_cast<const PHAL::SumOverRanksResponse*>(&*evaluator) != nullptr;
+      }
+    }
+  }
   std::replace(vis_response_name.begin(), vis_response_name.end(), ' ', '_');
   std::transform(vis_response_name.begin(), vis_response_name.end(), 
 		 vis_response_name.begin(), ::tolower);
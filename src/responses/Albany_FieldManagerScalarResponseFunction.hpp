@@ -37,6 +37,10 @@ namespace Albany {
     //! Get the number of responses
     virtual unsigned int numResponses() const;
 
+    //! Whether the response evaluator is a PHAL::SumOverRanksResponse,
+    //! so that the response can be fused with other responses
+    bool isSumSeparable() const { return sum_separable; }
+
     //! Perform post registration setup
     void postRegSetup();
 
@@ -146,8 +150,13 @@ namespace Albany {
     //! Response name for visualization file
     std::string vis_response_name;
 
+    //! Global response is a sum over the ranks
+    bool sum_separable;
+
   private:
 
+    friend class FusedScalarResponseFunction;
+
     template <typename EvalT> void evaluate(PHAL::Workset& workset);
 
     //! Restrict the field manager to an element block, as is done for fm and
@@ -0,0 +1,415 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+
+#include "Albany_FusedScalarResponseFunction.hpp"
+#include "Albany_ThyraUtils.hpp"
+#include "Albany_DistributedParameterLibrary.hpp"
+
+#include "Teuchos_CommHelpers.hpp"
+#include "Teuchos_DefaultSerialComm.hpp"
+
+#include <vector>
+
+Albany::FusedScalarResponseFunction::
+FusedScalarResponseFunction(
+  const Teuchos::RCP<Albany::Application>& application_,
+  const Teuchos::Array< Teuchos::RCP<FieldManagerScalarResponseFunction> >& responses_) :
+  ScalarResponseFunction(application_->getComm()),
+  application(application_),
+  responses(responses_),
+  serialComm(Teuchos::rcp(new Teuchos::SerialComm<int>()))
+{
+  for (int i=0; i<responses.size(); ++i) {
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        !responses[i]->isSumSeparable(), std::logic_error,
+        "Error! Response '" << responses[i]->vis_response_name << "' is not "
+        "the sum of the rank contributions, and cannot be fused.\n");
+  }
+}
+
+void
+Albany::FusedScalarResponseFunction::
+postRegSetup()
+{
+  for (int i=0; i<responses.size(); ++i) {
+    responses[i]->postRegSetup();
+  }
+}
+
+Albany::FusedScalarResponseFunction::
+~FusedScalarResponseFunction()
+{
+}
+
+unsigned int
+Albany::FusedScalarResponseFunction::
+numResponses() const
+{
+  unsigned int n = 0;
+  for (int i=0; i<responses.size(); ++i)
+    n += responses[i]->numResponses();
+  return n;
+}
+
+void
+Albany::FusedScalarResponseFunction::
+checkPostRegSetup() const
+{
+  for (int i=0; i<responses.size(); ++i) {
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        !responses[i]->performedPostRegSetup, Teuchos::Exceptions::InvalidParameter,
+        std::endl << "Post registration setup not performed in field manager " <<
+        std::endl << "Forgot to call \"postRegSetup\"? ");
+  }
+}
+
+void
+Albany::FusedScalarResponseFunction::
+setOutputs(PHAL::Workset& workset, const Outputs& outputs)
+{
+  workset.g                     = outputs.g;
+  workset.dgdx                  = outputs.dgdx;
+  workset.dgdxdot               = outputs.dgdxdot;
+  workset.dgdxdotdot            = outputs.dgdxdotdot;
+  workset.dgdp                  = outputs.dgdp;
+  workset.overlapped_dgdx       = outputs.overlapped_dgdx;
+  workset.overlapped_dgdxdot    = outputs.overlapped_dgdxdot;
+  workset.overlapped_dgdxdotdot = outputs.overlapped_dgdxdotdot;
+  workset.overlapped_dgdp       = outputs.overlapped_dgdp;
+}
+
+template<typename EvalT>
+void Albany::FusedScalarResponseFunction::
+evaluate (PHAL::Workset& workset, const Teuchos::Array<Outputs>& outputs)
+{
+  const WorksetArray<int>::type&
+    wsPhysIndex = application->getDiscretization()->getWsPhysIndex();
+
+  // The responses are sums over the cells, so the evaluators only add up the
+  // local cells, and all the global values are summed at once afterwards.
+  workset.comm = serialComm;
+
+  for (int i=0; i<responses.size(); ++i) {
+    setOutputs(workset, outputs[i]);
+    responses[i]->rfm->preEvaluate<EvalT>(workset);
+  }
+  // TODO: merge the response DAGs of each physics block into one field
+  // manager, so that the gather, basis and interpolation evaluators the
+  // responses share run once per workset rather than once per response.
+  // This needs the problems to register the evaluators of all the responses
+  // of a block together, and the response evaluators to scatter into g at
+  // their own offset rather than from index 0.
+  for (int ws = 0, numWorksets = application->getNumWorksets();
+       ws < numWorksets; ws++) {
+    application->loadWorksetBucketInfo<EvalT>(workset, ws);
+    for (int i=0; i<responses.size(); ++i) {
+      const int element_block_index = responses[i]->element_block_index;
+      if (element_block_index >= 0 && element_block_index != wsPhysIndex[ws])
+        continue;
+      setOutputs(workset, outputs[i]);
+      responses[i]->rfm->evaluateFields<EvalT>(workset);
+    }
+  }
+  for (int i=0; i<responses.size(); ++i) {
+    setOutputs(workset, outputs[i]);
+    responses[i]->rfm->postEvaluate<EvalT>(workset);
+  }
+
+  workset.comm = commT;
+}
+
+void
+Albany::FusedScalarResponseFunction::
+sumOverRanks(const Teuchos::Array< Teuchos::RCP<Thyra_MultiVector> >& mvs) const
+{
+  std::vector<ST> local, global;
+  for (int k=0; k<mvs.size(); ++k) {
+    auto data = getNonconstLocalData(mvs[k]);
+    for (int col=0; col<data.size(); ++col) {
+      local.insert(local.end(), data[col].begin(), data[col].end());
+    }
+  }
+  if (local.empty()) {
+    return;
+  }
+
+  global.resize(local.size());
+  Teuchos::reduceAll<int,ST>(*commT, Teuchos::REDUCE_SUM, local.size(),
+                             local.data(), global.data());
+
+  std::size_t slot = 0;
+  for (int k=0; k<mvs.size(); ++k) {
+    auto data = getNonconstLocalData(mvs[k]);
+    for (int col=0; col<data.size(); ++col) {
+      for (int j=0; j<data[col].size(); ++j) {
+        data[col][j] = global[slot++];
+      }
+    }
+  }
+}
+
+void
+Albany::FusedScalarResponseFunction::
+evaluateResponse(const double current_time,
+    const Teuchos::RCP<const Thyra_Vector>& x,
+    const Teuchos::RCP<const Thyra_Vector>& xdot,
+    const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+    const Teuchos::Array<ParamVec>& p,
+    const Teuchos::RCP<Thyra_Vector>& g)
+{
+  if (g.is_null()) {
+    return;
+  }
+  checkPostRegSetup();
+
+  Teuchos::Array<Outputs> outputs(responses.size());
+  Teuchos::Array< Teuchos::RCP<Thyra_MultiVector> > replicated;
+  for (int i=0; i<responses.size(); ++i) {
+    outputs[i].g = Thyra::createMember(responses[i]->responseVectorSpace());
+    outputs[i].g->assign(0.0);
+    replicated.push_back(outputs[i].g);
+  }
+
+  // Set data in Workset struct
+  PHAL::Workset workset;
+  application->setupBasicWorksetInfo(workset, current_time, x, xdot, xdotdot, p);
+
+  // Perform fill via field managers
+  evaluate<PHAL::AlbanyTraits::Residual>(workset, outputs);
+  sumOverRanks(replicated);
+
+  // Copy into the monolithic vector
+  Teuchos::ArrayRCP<ST> g_data = getNonconstLocalData(g);
+  unsigned int offset = 0;
+  for (int i=0; i<responses.size(); ++i) {
+    Teuchos::ArrayRCP<const ST> gi_data = getLocalData(outputs[i].g.getConst());
+    for (unsigned int j=0; j<responses[i]->numResponses(); ++j) {
+      g_data[offset+j] = gi_data[j];
+    }
+    offset += responses[i]->numResponses();
+  }
+}
+
+void
+Albany::FusedScalarResponseFunction::
+evaluateTangent(const double alpha,
+    const double beta,
+    const double omega,
+    const double current_time,
+    bool sum_derivs,
+    const Teuchos::RCP<const Thyra_Vector>& x,
+    const Teuchos::RCP<const Thyra_Vector>& xdot,
+    const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+    const Teuchos::Array<ParamVec>& p,
+    ParamVec* deriv_p,
+    const Teuchos::RCP<const Thyra_MultiVector>& Vx,
+    const Teuchos::RCP<const Thyra_MultiVector>& Vxdot,
+    const Teuchos::RCP<const Thyra_MultiVector>& Vxdotdot,
+    const Teuchos::RCP<const Thyra_MultiVector>& Vp,
+    const Teuchos::RCP<Thyra_Vector>& g,
+    const Teuchos::RCP<Thyra_MultiVector>& gx,
+    const Teuchos::RCP<Thyra_MultiVector>& gp)
+{
+  checkPostRegSetup();
+
+  Teuchos::Array<Outputs> outputs(responses.size());
+  Teuchos::Array< Teuchos::RCP<Thyra_MultiVector> > replicated;
+  for (int i=0; i<responses.size(); ++i) {
+    auto vs_i = responses[i]->responseVectorSpace();
+    if (!g.is_null()) {
+      outputs[i].g = Thyra::createMember(vs_i);
+      replicated.push_back(outputs[i].g);
+    }
+    if (!gx.is_null()) {
+      outputs[i].dgdx = Thyra::createMembers(vs_i,gx->domain()->dim());
+      replicated.push_back(outputs[i].dgdx);
+    }
+    if (!gp.is_null()) {
+      outputs[i].dgdp = Thyra::createMembers(vs_i,gp->domain()->dim());
+      replicated.push_back(outputs[i].dgdp);
+    }
+  }
+
+  // Set data in Workset struct
+  PHAL::Workset workset;
+  application->setupTangentWorksetInfo(workset, current_time, sum_derivs,
+                x, xdot, xdotdot, p, deriv_p, Vx, Vxdot, Vxdotdot, Vp);
+
+  // Perform fill via field managers
+  evaluate<PHAL::AlbanyTraits::Tangent>(workset, outputs);
+  sumOverRanks(replicated);
+
+  // Copy into the monolithic (multi)vectors
+  Teuchos::ArrayRCP<ST> g_data;
+  Teuchos::ArrayRCP<Teuchos::ArrayRCP<ST>> gx_data, gp_data;
+  if (!g.is_null())  { g_data  = getNonconstLocalData(g);  }
+  if (!gx.is_null()) { gx_data = getNonconstLocalData(gx); }
+  if (!gp.is_null()) { gp_data = getNonconstLocalData(gp); }
+
+  unsigned int offset = 0;
+  for (int i=0; i<responses.size(); ++i) {
+    const unsigned int num_i = responses[i]->numResponses();
+    if (!g.is_null()) {
+      Teuchos::ArrayRCP<const ST> gi_data = getLocalData(outputs[i].g.getConst());
+      for (unsigned int j=0; j<num_i; ++j) {
+        g_data[offset+j] = gi_data[j];
+      }
+    }
+    if (!gx.is_null()) {
+      Teuchos::ArrayRCP<Teuchos::ArrayRCP<const ST>> gxi_data = getLocalData(outputs[i].dgdx.getConst());
+      for (int col=0; col<gx->domain()->dim(); ++col) {
+        for (unsigned int j=0; j<num_i; ++j) {
+          gx_data[col][offset+j] = gxi_data[col][j];
+        }
+      }
+    }
+    if (!gp.is_null()) {
+      Teuchos::ArrayRCP<Teuchos::ArrayRCP<const ST>> gpi_data = getLocalData(outputs[i].dgdp.getConst());
+      for (int col=0; col<gp->domain()->dim(); ++col) {
+        for (unsigned int j=0; j<num_i; ++j) {
+          gp_data[col][offset+j] = gpi_data[col][j];
+        }
+      }
+    }
+    offset += num_i;
+  }
+}
+
+void
+Albany::FusedScalarResponseFunction::
+evaluateGradient(const double current_time,
+    const Teuchos::RCP<const Thyra_Vector>& x,
+    const Teuchos::RCP<const Thyra_Vector>& xdot,
+    const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+    const Teuchos::Array<ParamVec>& p,
+    ParamVec* /* deriv_p */,
+    const Teuchos::RCP<Thyra_Vector>& g,
+    const Teuchos::RCP<Thyra_MultiVector>& dg_dx,
+    const Teuchos::RCP<Thyra_MultiVector>& dg_dxdot,
+    const Teuchos::RCP<Thyra_MultiVector>& dg_dxdotdot,
+    const Teuchos::RCP<Thyra_MultiVector>& /* dg_dp */)
+{
+  checkPostRegSetup();
+
+  // Set data in Workset struct
+  PHAL::Workset workset;
+  application->setupBasicWorksetInfo(workset, current_time, x, xdot, xdotdot, p);
+
+  Teuchos::RCP<const Thyra_VectorSpace> overlapped_vs =
+    workset.x_cas_manager->getOverlappedVectorSpace();
+
+  // The values are set by the first pass only, and summed at the end
+  bool need_g = !g.is_null();
+  Teuchos::Array<Outputs> outputs(responses.size());
+  Teuchos::Array< Teuchos::RCP<Thyra_MultiVector> > replicated;
+  if (need_g) {
+    for (int i=0; i<responses.size(); ++i) {
+      outputs[i].g = Thyra::createMember(responses[i]->responseVectorSpace());
+      replicated.push_back(outputs[i].g);
+    }
+  }
+
+  // dg_dx, dg_dxdot, and dg_dxdotdot for the i-th response are simply
+  // a subview of the columns of the corresponding input MV's, at the proper offset
+  const auto derivativePass = [&](const Teuchos::RCP<Thyra_MultiVector>& dg,
+                                  Teuchos::RCP<Thyra_MultiVector> Outputs::* dg_i,
+                                  Teuchos::RCP<Thyra_MultiVector> Outputs::* overlapped_dg_i) {
+    unsigned int offset = 0;
+    for (int i=0; i<responses.size(); ++i) {
+      const unsigned int num_i = responses[i]->numResponses();
+      Teuchos::Range1D colRange(offset, offset+num_i-1);
+      outputs[i].dgdx = outputs[i].dgdxdot = outputs[i].dgdxdotdot = Teuchos::null;
+      outputs[i].overlapped_dgdx = outputs[i].overlapped_dgdxdot = outputs[i].overlapped_dgdxdotdot = Teuchos::null;
+      outputs[i].*dg_i = dg->subView(colRange);
+      outputs[i].*overlapped_dg_i = Thyra::createMembers(overlapped_vs,num_i);
+      if (!need_g) {
+        outputs[i].g = Teuchos::null;
+      }
+      offset += num_i;
+    }
+    evaluate<PHAL::AlbanyTraits::Jacobian>(workset, outputs);
+    need_g = false;
+  };
+
+  // Perform fill via field managers (dg/dx)
+  if (!dg_dx.is_null()) {
+    workset.m_coeff = 0.0;
+    workset.j_coeff = 1.0;
+    workset.n_coeff = 0.0;
+    derivativePass(dg_dx, &Outputs::dgdx, &Outputs::overlapped_dgdx);
+  }
+
+  // Perform fill via field managers (dg/dxdot)
+  if (!dg_dxdot.is_null()) {
+    workset.m_coeff = 1.0;
+    workset.j_coeff = 0.0;
+    workset.n_coeff = 0.0;
+    derivativePass(dg_dxdot, &Outputs::dgdxdot, &Outputs::overlapped_dgdxdot);
+  }
+
+  // Perform fill via field managers (dg/dxdotdot)
+  if (!dg_dxdotdot.is_null()) {
+    workset.m_coeff = 0.0;
+    workset.j_coeff = 0.0;
+    workset.n_coeff = 1.0;
+    derivativePass(dg_dxdotdot, &Outputs::dgdxdotdot, &Outputs::overlapped_dgdxdotdot);
+  }
+
+  // As in FieldManagerScalarResponseFunction, g is only set by a derivative pass
+  if (!g.is_null() && !need_g) {
+    sumOverRanks(replicated);
+
+    // Copy into the monolithic vector
+    Teuchos::ArrayRCP<ST> g_data = getNonconstLocalData(g);
+    unsigned int offset = 0;
+    for (int i=0; i<responses.size(); ++i) {
+      Teuchos::ArrayRCP<const ST> gi_data = getLocalData(outputs[i].g.getConst());
+      for (unsigned int j=0; j<responses[i]->numResponses(); ++j) {
+        g_data[offset+j] = gi_data[j];
+      }
+      offset += responses[i]->numResponses();
+    }
+  }
+}
+
+void
+Albany::FusedScalarResponseFunction::
+evaluateDistParamDeriv(
+    const double current_time,
+    const Teuchos::RCP<const Thyra_Vector>& x,
+    const Teuchos::RCP<const Thyra_Vector>& xdot,
+    const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+    const Teuchos::Array<ParamVec>& param_array,
+    const std::string& dist_param_name,
+    const Teuchos::RCP<Thyra_MultiVector>& dg_dp)
+{
+  if (dg_dp.is_null()) {
+    return;
+  }
+  checkPostRegSetup();
+
+  // Set data in Workset struct
+  PHAL::Workset workset;
+  application->setupBasicWorksetInfo(workset, current_time, x, xdot, xdotdot, param_array);
+  workset.dist_param_deriv_name = dist_param_name;
+  workset.p_cas_manager = workset.distParamLib->get(dist_param_name)->get_cas_manager();
+
+  // dg_dp for the i-th response is simply a subview of the columns
+  // of the input MV, at the proper offset
+  Teuchos::Array<Outputs> outputs(responses.size());
+  unsigned int offset = 0;
+  for (int i=0; i<responses.size(); ++i) {
+    const unsigned int num_i = responses[i]->numResponses();
+    Teuchos::Range1D colRange(offset, offset+num_i-1);
+    outputs[i].dgdp = dg_dp->subView(colRange);
+    outputs[i].overlapped_dgdp = Thyra::createMembers(workset.p_cas_manager->getOverlappedVectorSpace(),num_i);
+    offset += num_i;
+  }
+
+  // Perform fill via field managers
+  evaluate<PHAL::AlbanyTraits::DistParamDeriv>(workset, outputs);
+}
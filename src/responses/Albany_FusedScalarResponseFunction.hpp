@@ -0,0 +1,150 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_FUSED_SCALAR_RESPONSE_FUNCTION_HPP
+#define ALBANY_FUSED_SCALAR_RESPONSE_FUNCTION_HPP
+
+#include "Albany_FieldManagerScalarResponseFunction.hpp"
+#include "Teuchos_Array.hpp"
+
+namespace Albany {
+
+  /*!
+   * \brief Evaluates several field manager responses in a single pass
+   *
+   * Each FieldManagerScalarResponseFunction scatters the solution to the
+   * overlapped map, runs its own loop over the worksets, and reduces its
+   * values across ranks. This class does the setup once, evaluates every
+   * response field manager on a workset before moving to the next one, and
+   * sums the values (and tangents) of all the responses with one collective.
+   *
+   * Only responses whose evaluator is a PHAL::SumOverRanksResponse can be
+   * fused (see FieldManagerScalarResponseFunction::isSumSeparable). The
+   * responses are stacked in the order given.
+   *
+   * The field managers are not merged: each response still runs its own
+   * gather, basis function and interpolation evaluators on the workset.
+   */
+  class FusedScalarResponseFunction :
+    public ScalarResponseFunction {
+  public:
+
+    //! Constructor
+    FusedScalarResponseFunction(
+      const Teuchos::RCP<Albany::Application>& application,
+      const Teuchos::Array< Teuchos::RCP<FieldManagerScalarResponseFunction> >& responses);
+
+    //! Perform post registration setup
+    virtual void postRegSetup();
+
+    //! Destructor
+    virtual ~FusedScalarResponseFunction();
+
+    //! Get the number of responses
+    virtual unsigned int numResponses() const;
+
+    //! Evaluate responses
+    virtual void
+    evaluateResponse(const double current_time,
+      const Teuchos::RCP<const Thyra_Vector>& x,
+      const Teuchos::RCP<const Thyra_Vector>& xdot,
+      const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+      const Teuchos::Array<ParamVec>& p,
+      const Teuchos::RCP<Thyra_Vector>& g);
+
+    //! Evaluate tangent = dg/dx*dx/dp + dg/dxdot*dxdot/dp + dg/dp
+    virtual void
+    evaluateTangent(const double alpha,
+      const double beta,
+      const double omega,
+      const double current_time,
+      bool sum_derivs,
+      const Teuchos::RCP<const Thyra_Vector>& x,
+      const Teuchos::RCP<const Thyra_Vector>& xdot,
+      const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+      const Teuchos::Array<ParamVec>& p,
+      ParamVec* deriv_p,
+      const Teuchos::RCP<const Thyra_MultiVector>& Vx,
+      const Teuchos::RCP<const Thyra_MultiVector>& Vxdot,
+      const Teuchos::RCP<const Thyra_MultiVector>& Vxdotdot,
+      const Teuchos::RCP<const Thyra_MultiVector>& Vp,
+      const Teuchos::RCP<Thyra_Vector>& g,
+      const Teuchos::RCP<Thyra_MultiVector>& gx,
+      const Teuchos::RCP<Thyra_MultiVector>& gp);
+
+    //! Evaluate gradient = dg/dx, dg/dxdot, dg/dp
+    virtual void
+    evaluateGradient(const double current_time,
+      const Teuchos::RCP<const Thyra_Vector>& x,
+      const Teuchos::RCP<const Thyra_Vector>& xdot,
+      const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+      const Teuchos::Array<ParamVec>& p,
+      ParamVec* deriv_p,
+      const Teuchos::RCP<Thyra_Vector>& g,
+      const Teuchos::RCP<Thyra_MultiVector>& dg_dx,
+      const Teuchos::RCP<Thyra_MultiVector>& dg_dxdot,
+      const Teuchos::RCP<Thyra_MultiVector>& dg_dxdotdot,
+      const Teuchos::RCP<Thyra_MultiVector>& dg_dp);
+
+    //! Evaluate distributed parameter derivative dg/dp
+    virtual void
+    evaluateDistParamDeriv(
+      const double current_time,
+      const Teuchos::RCP<const Thyra_Vector>& x,
+      const Teuchos::RCP<const Thyra_Vector>& xdot,
+      const Teuchos::RCP<const Thyra_Vector>& xdotdot,
+      const Teuchos::Array<ParamVec>& param_array,
+      const std::string& dist_param_name,
+      const Teuchos::RCP<Thyra_MultiVector>& dg_dp);
+
+  private:
+
+    //! Private to prohibit copying
+    FusedScalarResponseFunction(const FusedScalarResponseFunction&);
+
+    //! Private to prohibit copying
+    FusedScalarResponseFunction& operator=(const FusedScalarResponseFunction&);
+
+    //! The workset outputs of one response
+    struct Outputs {
+      Teuchos::RCP<Thyra_Vector>      g;
+      Teuchos::RCP<Thyra_MultiVector> dgdx;
+      Teuchos::RCP<Thyra_MultiVector> dgdxdot;
+      Teuchos::RCP<Thyra_MultiVector> dgdxdotdot;
+      Teuchos::RCP<Thyra_MultiVector> dgdp;
+      Teuchos::RCP<Thyra_MultiVector> overlapped_dgdx;
+      Teuchos::RCP<Thyra_MultiVector> overlapped_dgdxdot;
+      Teuchos::RCP<Thyra_MultiVector> overlapped_dgdxdotdot;
+      Teuchos::RCP<Thyra_MultiVector> overlapped_dgdp;
+    };
+
+    //! Point the workset to the outputs of one response
+    static void setOutputs(PHAL::Workset& workset, const Outputs& outputs);
+
+    //! Evaluate all the field managers in one pass over the worksets.
+    //! The values are left summed over the local cells only.
+    template <typename EvalT>
+    void evaluate(PHAL::Workset& workset, const Teuchos::Array<Outputs>& outputs);
+
+    //! Sum the locally replicated (multi)vectors over the ranks, in one collective
+    void sumOverRanks(const Teuchos::Array< Teuchos::RCP<Thyra_MultiVector> >& mvs) const;
+
+    //! Check the field managers are set up
+    void checkPostRegSetup() const;
+
+    //! Application class
+    Teuchos::RCP<Albany::Application> application;
+
+    //! Response functions to fuse
+    Teuchos::Array< Teuchos::RCP<FieldManagerScalarResponseFunction> > responses;
+
+    //! Handed to the evaluators, so that their reductions are local
+    Teuchos::RCP<const Teuchos_Comm> serialComm;
+  };
+
+}
+
+#endif // ALBANY_FUSED_SCALAR_RESPONSE_FUNCTION_HPP
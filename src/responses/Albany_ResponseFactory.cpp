@@ -20,6 +20,7 @@
 #include "Albany_CumulativeScalarResponseFunction.hpp"
 #include "Albany_FieldManagerScalarResponseFunction.hpp"
 #include "Albany_FieldManagerResidualOnlyResponseFunction.hpp"
+#include "Albany_FusedScalarResponseFunction.hpp"
 #include "Albany_SolutionResponseFunction.hpp"
 #include "Albany_KLResponseFunction.hpp"
 
@@ -104,6 +105,31 @@ createResponseFunction(
           "The aggregated response can only aggregate scalar response " << "functions!");
       scalar_responses[i] = Teuchos::rcp_dynamic_cast<ScalarResponseFunction>(aggregated_responses[i]);
     }
+    if (name == "Aggregate Responses" && responseParams.get<bool>("Fuse Responses", false)) {
+      // Evaluate consecutive field manager responses that are plain sums in one pass
+      Array< RCP<ScalarResponseFunction> > fused_responses;
+      Array< RCP<FieldManagerScalarResponseFunction> > fm_responses;
+      for (int i=0; i<=scalar_responses.size(); i++) {
+        RCP<FieldManagerScalarResponseFunction> fm_response;
+        if (i<scalar_responses.size()) {
+          fm_response = Teuchos::rcp_dynamic_cast<FieldManagerScalarResponseFunction>(scalar_responses[i]);
+        }
+        if (!fm_response.is_null() && fm_response->isSumSeparable()) {
+          fm_responses.push_back(fm_response);
+          continue;
+        }
+        if (fm_responses.size()==1) {
+          fused_responses.push_back(fm_responses[0]);
+        } else if (fm_responses.size()>1) {
+          fused_responses.push_back(rcp(new Albany::FusedScalarResponseFunction(app, fm_responses)));
+        }
+        fm_responses.clear();
+        if (i<scalar_responses.size()) {
+          fused_responses.push_back(scalar_responses[i]);
+        }
+      }
+      scalar_responses = fused_responses;
+    }
     if(name == "Aggregate Responses")
       responses.push_back(rcp(new Albany::AggregateScalarResponseFunction(comm, scalar_responses)));
     else
@@ -7,6 +7,7 @@
 
 #include "Albany_SolutionFileResponseFunction.hpp"
 #include "Albany_TpetraThyraUtils.hpp"
+#include "Albany_BinaryVectorIO.hpp"
 
 #include "Teuchos_CommHelpers.hpp"
 #include "Tpetra_DistObject.hpp"
@@ -47,7 +48,8 @@ evaluateResponse(const double /*current_time*/,
 
   // Read the reference solution for comparison from "reference_solution.dat"
 
-  // Note that this is of MatrixMarket array real general format
+  // Note that this is of MatrixMarket array real general format, or a
+  // binary vector file (see Albany_BinaryVectorIO.hpp)
 
   if (!solutionLoaded) {
     RefSoln = Thyra::createMember(x->space());
@@ -195,6 +197,12 @@ Albany::SolutionFileResponseFunction<Norm>::
 MatrixMarketFileToThyraVector( const char *filename, const Teuchos::RCP<Thyra_Vector>& v)
 {
   auto vT = Albany::getTpetraVector(v);
+
+  // Binary files are read in parallel, each rank reading only its own rows
+  if (Albany::isBinaryVectorFile(filename, vT->getMap()->getComm())) {
+    Albany::readBinaryMultiVector(filename, *vT);
+    return 0;
+  }
   return MatrixMarketFileToTpetraMultiVector(filename, *vT); 
 }
 
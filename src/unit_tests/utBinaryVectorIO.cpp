@@ -0,0 +1,170 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "Albany_BinaryVectorIO.hpp"
+#include "Albany_Utils.hpp"
+
+namespace {
+
+// Number of rows and vectors of the test files
+std::int64_t const num_rows    = 50;
+std::int64_t const num_vectors = 2;
+
+//
+// Value stored in row i of vector j
+//
+double
+value(std::int64_t const i, std::int64_t const j)
+{
+  return 100.0 * j + 0.5 * i;
+}
+
+//
+// GID of row i: the GIDs are sparse and do not start from 0, as on a
+// side mesh
+//
+Tpetra_GO
+gid(std::int64_t const i)
+{
+  return 7 + 3 * i;
+}
+
+//
+// Write the test file on rank 0, in the layout of Albany_BinaryVectorIO.hpp
+//
+void
+writeFile(std::string const& filename, Teuchos_Comm const& comm)
+{
+  if (comm.getRank() == 0) {
+    std::ofstream      ofile(filename.c_str(), std::ios::binary);
+    std::int64_t const dims[2] = {num_rows, num_vectors};
+    ofile.write("ALBVEC01", 8);
+    ofile.write(reinterpret_cast<char const*>(dims), sizeof(dims));
+    for (std::int64_t j = 0; j < num_vectors; ++j) {
+      for (std::int64_t i = 0; i < num_rows; ++i) {
+        double const v = value(i, j);
+        ofile.write(reinterpret_cast<char const*>(&v), sizeof(double));
+      }
+    }
+  }
+  comm.barrier();
+}
+
+//
+// Check all the entries of mv, whose GIDs are gid(i) for some row i
+//
+void
+checkValues(
+    Tpetra_MultiVector const& mv,
+    Teuchos::FancyOStream&    out,
+    bool&                     success)
+{
+  Tpetra_Map const& map = *mv.getMap();
+  for (std::int64_t j = 0; j < num_vectors; ++j) {
+    Teuchos::ArrayRCP<ST const> vals = mv.getData(j);
+    for (Tpetra_LO lid = 0; lid < map.getNodeNumElements(); ++lid) {
+      std::int64_t const i = (map.getGlobalElement(lid) - gid(0)) / 3;
+      TEST_EQUALITY(vals[lid], value(i, j));
+    }
+  }
+}
+
+//
+// Rows are dealt out round robin, in decreasing GID order, so that each
+// rank reads several runs of rows, in an order that is not the file order
+//
+TEUCHOS_UNIT_TEST(BinaryVectorIO, OneToOneSparseMap)
+{
+  Teuchos::RCP<Teuchos_Comm const> comm =
+      Albany::createTeuchosCommFromMpiComm(Albany_MPI_COMM_WORLD);
+  std::string const filename = "utBinaryVectorIO_1.bin";
+  writeFile(filename, *comm);
+
+  Teuchos::Array<Tpetra_GO> gids;
+  for (std::int64_t i = num_rows - 1; i >= 0; --i) {
+    if (i % comm->getSize() == comm->getRank()) gids.push_back(gid(i));
+  }
+  Tpetra::global_size_t const INVALID =
+      Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid();
+  Teuchos::RCP<Tpetra_Map const> map =
+      Teuchos::rcp(new Tpetra_Map(INVALID, gids(), 0, comm));
+
+  TEST_ASSERT(Albany::isBinaryVectorFile(filename, comm));
+  Teuchos::RCP<Tpetra_MultiVector> mv =
+      Albany::readBinaryMultiVector(filename, map);
+  TEST_EQUALITY(static_cast<std::int64_t>(mv->getNumVectors()), num_vectors);
+  checkValues(*mv, out, success);
+}
+
+//
+// Each rank holds a block of rows plus the first rows of the next rank, as
+// the overlapping node maps of a mesh do
+//
+TEUCHOS_UNIT_TEST(BinaryVectorIO, OverlappingMap)
+{
+  Teuchos::RCP<Teuchos_Comm const> comm =
+      Albany::createTeuchosCommFromMpiComm(Albany_MPI_COMM_WORLD);
+  std::string const filename = "utBinaryVectorIO_2.bin";
+  writeFile(filename, *comm);
+
+  std::int64_t const num_ranks = comm->getSize();
+  std::int64_t const rank      = comm->getRank();
+  std::int64_t const first     = rank * num_rows / num_ranks;
+  std::int64_t const last      = std::min(
+      (rank + 1) * num_rows / num_ranks + 2, num_rows);
+
+  Teuchos::Array<Tpetra_GO> gids;
+  for (std::int64_t i = first; i < last; ++i) gids.push_back(gid(i));
+  Tpetra::global_size_t const INVALID =
+      Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid();
+  Teuchos::RCP<Tpetra_Map const> map =
+      Teuchos::rcp(new Tpetra_Map(INVALID, gids(), 0, comm));
+
+  Tpetra_MultiVector mv(map, num_vectors);
+  Albany::readBinaryMultiVector(filename, mv);
+  checkValues(mv, out, success);
+}
+
+//
+// A map with a different number of distinct GIDs than the file rows
+//
+TEUCHOS_UNIT_TEST(BinaryVectorIO, WrongNumberOfRows)
+{
+  Teuchos::RCP<Teuchos_Comm const> comm =
+      Albany::createTeuchosCommFromMpiComm(Albany_MPI_COMM_WORLD);
+  std::string const filename = "utBinaryVectorIO_3.bin";
+  writeFile(filename, *comm);
+
+  Teuchos::RCP<Tpetra_Map const> map =
+      Teuchos::rcp(new Tpetra_Map(num_rows + 1, 0, comm));
+  Tpetra_MultiVector mv(map, num_vectors);
+  TEST_THROW(Albany::readBinaryMultiVector(filename, mv), std::runtime_error);
+}
+
+//
+// Files without the binary header are not binary vector files
+//
+TEUCHOS_UNIT_TEST(BinaryVectorIO, AsciiFile)
+{
+  Teuchos::RCP<Teuchos_Comm const> comm =
+      Albany::createTeuchosCommFromMpiComm(Albany_MPI_COMM_WORLD);
+  std::string const filename = "utBinaryVectorIO_4.ascii";
+  if (comm->getRank() == 0) {
+    std::ofstream ofile(filename.c_str());
+    ofile << "2\n1.0\n2.0\n";
+  }
+  comm->barrier();
+  TEST_ASSERT(!Albany::isBinaryVectorFile(filename, comm));
+}
+
+}  // anonymous namespace
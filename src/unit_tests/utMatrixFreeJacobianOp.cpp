@@ -0,0 +1,99 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include "Albany_Application.hpp"
+#include "Albany_MatrixFreeJacobianOp.hpp"
+#include "Albany_TpetraThyraUtils.hpp"
+#include "Albany_Utils.hpp"
+
+#include "Thyra_VectorStdOps.hpp"
+
+namespace {
+
+//
+// Nonlinear 2D heat problem, so that the Jacobian depends on the solution
+//
+Teuchos::RCP<Albany::Application>
+createHeatApplication()
+{
+  Teuchos::RCP<Teuchos::ParameterList> params =
+      Teuchos::rcp(new Teuchos::ParameterList("params"));
+
+  Teuchos::ParameterList& problem_params = params->sublist("Problem");
+  problem_params.set<std::string>("Name", "Heat 2D");
+  Teuchos::ParameterList& dbc_params = problem_params.sublist("Dirichlet BCs");
+  dbc_params.set<double>("DBC on NS NodeSet0 for DOF T", 1.5);
+  dbc_params.set<double>("DBC on NS NodeSet1 for DOF T", 1.0);
+  problem_params.sublist("Source Functions")
+      .sublist("Quadratic")
+      .set<double>("Nonlinear Factor", 3.4);
+
+  Teuchos::ParameterList& disc_params = params->sublist("Discretization");
+  disc_params.set<std::string>("Method", "STK2D");
+  disc_params.set<int>("1D Elements", 8);
+  disc_params.set<int>("2D Elements", 8);
+
+  Teuchos::RCP<Teuchos_Comm> comm =
+      Albany::createTeuchosCommFromMpiComm(Albany_MPI_COMM_WORLD);
+
+  return Teuchos::rcp(new Albany::Application(comm, params));
+}
+
+//
+// The matrix-free operator must give the product of the assembled
+// Jacobian with a vector, at the same point, in both apply() paths.
+//
+TEUCHOS_UNIT_TEST(MatrixFreeJacobianOp, MatchesAssembledJacobian)
+{
+  Teuchos::RCP<Albany::Application> app = createHeatApplication();
+  Teuchos::RCP<const Thyra_VectorSpace> space = app->getVectorSpace();
+  Teuchos::Array<ParamVec> const scalar_params;
+
+  Teuchos::RCP<Thyra_Vector> x = Thyra::createMember(space);
+  Thyra::randomize(0.5, 2.0, x.ptr());
+
+  // Assembled Jacobian at x
+  Teuchos::RCP<Thyra_LinearOp> W = Albany::createThyraLinearOp(
+      Teuchos::rcp(new Tpetra_CrsMatrix(app->getJacobianGraphT())));
+  Teuchos::RCP<Thyra_Vector> f = Thyra::createMember(space);
+  app->computeGlobalJacobian(
+      0.0, 1.0, 0.0, 0.0, x, Teuchos::null, Teuchos::null, scalar_params, f,
+      W);
+
+  Albany::MatrixFreeJacobianOp W_mf(app);
+  W_mf.set(
+      0.0, 1.0, 0.0, 0.0, x, Teuchos::null, Teuchos::null, scalar_params);
+
+  // Changing x after set() must not change the operator
+  Thyra::assign(x.ptr(), 0.0);
+
+  Teuchos::RCP<Thyra_Vector> v = Thyra::createMember(space);
+  Thyra::randomize(-1.0, 1.0, v.ptr());
+
+  Teuchos::RCP<Thyra_Vector> Wv = Thyra::createMember(space);
+  W->apply(Thyra::NOTRANS, *v, Wv.ptr(), 1.0, 0.0);
+  ST const scale = Thyra::norm_2(*Wv);
+  TEST_ASSERT(scale > 0.0);
+
+  ST const tol = 1.0e-10;
+
+  // Y = W*X
+  Teuchos::RCP<Thyra_Vector> Jv = Thyra::createMember(space);
+  W_mf.apply(Thyra::NOTRANS, *v, Jv.ptr(), 1.0, 0.0);
+  Thyra::Vp_StV(Jv.ptr(), -1.0, *Wv);
+  TEST_COMPARE(Thyra::norm_2(*Jv), <=, tol * scale);
+
+  // Y = a*W*X + b*Y, with Y = W*X on entry
+  Teuchos::RCP<Thyra_Vector> y = Wv->clone_v();
+  W_mf.apply(Thyra::NOTRANS, *v, y.ptr(), 2.0, -3.0);
+  Thyra::Vp_StV(y.ptr(), 1.0, *Wv);
+  TEST_COMPARE(Thyra::norm_2(*y), <=, tol * scale);
+}
+
+}  // anonymous namespace
@@ -0,0 +1,302 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_BinaryVectorIO.hpp"
+
+#include "Albany_Utils.hpp"
+
+#include "Teuchos_CommHelpers.hpp"
+#include "Tpetra_Import.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace Albany
+{
+
+namespace
+{
+
+const char binary_vector_magic[8] = {'A','L','B','V','E','C','0','1'};
+
+// Read the header on rank 0 and broadcast it.
+// header[0] is 1 if the file could be opened and has the right magic.
+void readHeader (const std::string& filename,
+                 const Teuchos::RCP<const Teuchos_Comm>& comm,
+                 long long header[3])
+{
+  header[0] = header[1] = header[2] = 0;
+  if (comm->getRank()==0) {
+    std::ifstream ifile(filename.c_str(), std::ios::binary);
+    char magic[8];
+    std::int64_t dims[2];
+    if (ifile.read(magic,8) && std::memcmp(magic,binary_vector_magic,8)==0 &&
+        ifile.read(reinterpret_cast<char*>(dims),sizeof(dims))) {
+      header[0] = 1;
+      header[1] = dims[0];
+      header[2] = dims[1];
+    }
+  }
+  Teuchos::broadcast(*comm,0,3,header);
+}
+
+// MPI takes int counts: make sure a (per rank) count fits
+int checkedCount (const std::size_t count, const std::string& filename)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION (count>static_cast<std::size_t>(INT_MAX), std::runtime_error,
+                              "Error! Reading binary vector file '" << filename << "' needs " << count <<
+                              " entries on one rank, which does not fit in an MPI count. Use more ranks.\n");
+  return static_cast<int>(count);
+}
+
+// The row of each GID in the file, i.e., its position among all the GIDs of
+// the (one-to-one) map, in ascending order. Also returns the number of GIDs.
+//
+// With MPI, the range of GIDs is split evenly among the ranks, each rank
+// sends its GIDs to the rank owning their part of the range, which counts
+// and sorts the GIDs it receives and sends back their rows. So no rank ever
+// holds all the GIDs, and they need not be dense (e.g., side meshes).
+std::vector<long long>
+fileRows (const Tpetra_Map& map, const std::string& filename, long long& num_rows)
+{
+  const Tpetra_LO num_local = map.getNodeNumElements();
+  std::vector<std::int64_t> gids(num_local);
+  for (Tpetra_LO lid=0; lid<num_local; ++lid) {
+    gids[lid] = map.getGlobalElement(lid);
+  }
+
+  // Sort the local GIDs, keeping their local ids
+  std::vector<Tpetra_LO> perm(num_local);
+  for (Tpetra_LO lid=0; lid<num_local; ++lid) {
+    perm[lid] = lid;
+  }
+  std::sort(perm.begin(),perm.end(),
+            [&gids](const Tpetra_LO a, const Tpetra_LO b) { return gids[a]<gids[b]; });
+
+  std::vector<long long> rows(num_local);
+
+#ifdef ALBANY_MPI
+  Teuchos::RCP<const Teuchos_Comm> comm = map.getComm();
+  Albany_MPI_Comm mpi_comm = getMpiCommFromTeuchosComm(comm);
+  const int num_ranks = comm->getSize();
+
+  // Split [min_gid,max_gid] in num_ranks chunks
+  const std::int64_t min_gid = map.getMinAllGlobalIndex();
+  const std::int64_t max_gid = map.getMaxAllGlobalIndex();
+  const std::uint64_t range = static_cast<std::uint64_t>(max_gid-min_gid)+1;
+  const std::uint64_t chunk = (range+num_ranks-1)/num_ranks;
+
+  // Send the sorted GIDs to the owners of their chunk
+  std::vector<int> send_counts(num_ranks,0), recv_counts(num_ranks,0);
+  std::vector<std::int64_t> send_gids(num_local);
+  for (Tpetra_LO k=0; k<num_local; ++k) {
+    send_gids[k] = gids[perm[k]];
+    ++send_counts[static_cast<std::uint64_t>(send_gids[k]-min_gid)/chunk];
+  }
+  MPI_Alltoall(send_counts.data(),1,MPI_INT,recv_counts.data(),1,MPI_INT,mpi_comm);
+
+  std::vector<int> send_displs(num_ranks,0), recv_displs(num_ranks,0);
+  std::size_t num_recv = recv_counts[0];
+  for (int p=1; p<num_ranks; ++p) {
+    send_displs[p] = send_displs[p-1] + send_counts[p-1];
+    recv_displs[p] = checkedCount(num_recv,filename);
+    num_recv += recv_counts[p];
+  }
+  checkedCount(num_recv,filename);
+
+  std::vector<std::int64_t> recv_gids(num_recv);
+  MPI_Alltoallv(send_gids.data(),send_counts.data(),send_displs.data(),MPI_INT64_T,
+                recv_gids.data(),recv_counts.data(),recv_displs.data(),MPI_INT64_T,mpi_comm);
+
+  // The chunks are ordered by rank, and the map is one-to-one, so the row of
+  // a received GID is the number of GIDs in the previous chunks plus its
+  // position in this chunk
+  std::vector<std::int64_t> chunk_gids(recv_gids);
+  std::sort(chunk_gids.begin(),chunk_gids.end());
+  std::int64_t chunk_size = chunk_gids.size();
+  std::int64_t chunk_offset = 0;
+  std::int64_t total = 0;
+  MPI_Exscan(&chunk_size,&chunk_offset,1,MPI_INT64_T,MPI_SUM,mpi_comm);
+  MPI_Allreduce(&chunk_size,&total,1,MPI_INT64_T,MPI_SUM,mpi_comm);
+  if (comm->getRank()==0) {
+    chunk_offset = 0;
+  }
+
+  std::vector<std::int64_t> recv_rows(num_recv);
+  for (std::size_t i=0; i<num_recv; ++i) {
+    recv_rows[i] = chunk_offset +
+        (std::lower_bound(chunk_gids.begin(),chunk_gids.end(),recv_gids[i]) - chunk_gids.begin());
+  }
+
+  // Send the rows back, in the order the GIDs came
+  std::vector<std::int64_t> send_rows(num_local);
+  MPI_Alltoallv(recv_rows.data(),recv_counts.data(),recv_displs.data(),MPI_INT64_T,
+                send_rows.data(),send_counts.data(),send_displs.data(),MPI_INT64_T,mpi_comm);
+
+  for (Tpetra_LO k=0; k<num_local; ++k) {
+    rows[perm[k]] = send_rows[k];
+  }
+  num_rows = total;
+#else
+  (void) filename;
+  for (Tpetra_LO k=0; k<num_local; ++k) {
+    rows[perm[k]] = k;
+  }
+  num_rows = num_local;
+#endif
+
+  return rows;
+}
+
+// Read the rows of a one-to-one map
+void readOneToOne (const std::string& filename, const long long M, const long long N,
+                   Tpetra_MultiVector& mv)
+{
+  const Tpetra_Map& map = *mv.getMap();
+
+  long long num_rows = 0;
+  const std::vector<long long> file_rows = fileRows(map,filename,num_rows);
+  TEUCHOS_TEST_FOR_EXCEPTION (M!=num_rows, std::runtime_error,
+                              "Error! File '" << filename << "' stores vectors with " << M << " rows, "
+                              "but the map has " << num_rows << " distinct entries.\n");
+
+  // Sort the owned rows, so the values are read in file order
+  const Tpetra_LO num_local = map.getNodeNumElements();
+  std::vector<std::pair<long long,Tpetra_LO>> rows(num_local);
+  for (Tpetra_LO lid=0; lid<num_local; ++lid) {
+    rows[lid] = std::make_pair(file_rows[lid],lid);
+  }
+  std::sort(rows.begin(),rows.end());
+
+  // Group consecutive rows into runs: (first row, length)
+  std::vector<std::pair<long long,long long>> runs;
+  for (const auto& r : rows) {
+    if (!runs.empty() && runs.back().first+runs.back().second==r.first) {
+      ++runs.back().second;
+    } else {
+      runs.push_back(std::make_pair(r.first,1LL));
+    }
+  }
+
+  std::vector<double> buffer(N*num_local);
+
+#ifdef ALBANY_MPI
+  Teuchos::RCP<const Teuchos_Comm> comm = map.getComm();
+  Albany_MPI_Comm mpi_comm = getMpiCommFromTeuchosComm(comm);
+
+  // One block per run per vector, with byte displacements relative to the
+  // end of the header
+  const int num_blocks = checkedCount(runs.size()*N,filename);
+  std::vector<int> block_lengths(num_blocks);
+  std::vector<MPI_Aint> displacements(num_blocks);
+  for (long long j=0, b=0; j<N; ++j) {
+    for (const auto& run : runs) {
+      block_lengths[b] = checkedCount(run.second,filename);
+      displacements[b] = static_cast<MPI_Aint>((j*M + run.first)*sizeof(double));
+      ++b;
+    }
+  }
+
+  MPI_Datatype file_type;
+  MPI_Type_create_hindexed(num_blocks,block_lengths.data(),displacements.data(),MPI_DOUBLE,&file_type);
+  MPI_Type_commit(&file_type);
+
+  MPI_File fh;
+  int ierr = MPI_File_open(mpi_comm,const_cast<char*>(filename.c_str()),MPI_MODE_RDONLY,MPI_INFO_NULL,&fh);
+  TEUCHOS_TEST_FOR_EXCEPTION (ierr!=MPI_SUCCESS, std::runtime_error,
+                              "Error! Could not open binary vector file '" << filename << "'.\n");
+
+  const MPI_Offset header_size = binary_vector_header_size;
+  MPI_File_set_view(fh,header_size,MPI_DOUBLE,file_type,const_cast<char*>("native"),MPI_INFO_NULL);
+  MPI_Status status;
+  ierr = MPI_File_read_all(fh,buffer.data(),checkedCount(buffer.size(),filename),MPI_DOUBLE,&status);
+  MPI_File_close(&fh);
+  MPI_Type_free(&file_type);
+
+  TEUCHOS_TEST_FOR_EXCEPTION (ierr!=MPI_SUCCESS, std::runtime_error,
+                              "Error! Could not read binary vector file '" << filename << "'.\n");
+#else
+  std::ifstream ifile(filename.c_str(), std::ios::binary);
+  TEUCHOS_TEST_FOR_EXCEPTION (!ifile.is_open(), std::runtime_error,
+                              "Error! Could not open binary vector file '" << filename << "'.\n");
+
+  double* data = buffer.data();
+  for (long long j=0; j<N; ++j) {
+    for (const auto& run : runs) {
+      ifile.seekg(binary_vector_header_size + (j*M + run.first)*sizeof(double));
+      ifile.read(reinterpret_cast<char*>(data),run.second*sizeof(double));
+      data += run.second;
+    }
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION (!ifile, std::runtime_error,
+                              "Error! Could not read binary vector file '" << filename << "'.\n");
+#endif
+
+  // Scatter the values from file order to local ids
+  for (long long j=0; j<N; ++j) {
+    Teuchos::ArrayRCP<ST> vals = mv.getDataNonConst(j);
+    const double* col = buffer.data() + j*num_local;
+    for (Tpetra_LO k=0; k<num_local; ++k) {
+      vals[rows[k].second] = col[k];
+    }
+  }
+}
+
+} // anonymous namespace
+
+bool isBinaryVectorFile (const std::string& filename,
+                         const Teuchos::RCP<const Teuchos_Comm>& comm)
+{
+  long long header[3];
+  readHeader(filename,comm,header);
+  return header[0]==1;
+}
+
+void readBinaryMultiVector (const std::string& filename, Tpetra_MultiVector& mv)
+{
+  const Teuchos::RCP<const Tpetra_Map> map = mv.getMap();
+
+  long long header[3];
+  readHeader(filename,map->getComm(),header);
+  TEUCHOS_TEST_FOR_EXCEPTION (header[0]!=1, std::runtime_error,
+                              "Error! File '" << filename << "' is not a binary vector file.\n");
+
+  const long long M = header[1];
+  const long long N = header[2];
+  TEUCHOS_TEST_FOR_EXCEPTION (N!=static_cast<long long>(mv.getNumVectors()), std::runtime_error,
+                              "Error! File '" << filename << "' stores " << N << " vectors, "
+                              "but the multivector has " << mv.getNumVectors() << ".\n");
+
+  // Each row is read by one rank only, then shared with the other ones
+  if (map->isOneToOne()) {
+    readOneToOne(filename,M,N,mv);
+  } else {
+    const Teuchos::RCP<const Tpetra_Map> owned_map = Tpetra::createOneToOne(map);
+    Tpetra_MultiVector owned_mv(owned_map,N);
+    readOneToOne(filename,M,N,owned_mv);
+    mv.doImport(owned_mv,Tpetra_Import(owned_map,map),Tpetra::INSERT);
+  }
+}
+
+Teuchos::RCP<Tpetra_MultiVector>
+readBinaryMultiVector (const std::string& filename, const Teuchos::RCP<const Tpetra_Map>& map)
+{
+  long long header[3];
+  readHeader(filename,map->getComm(),header);
+  TEUCHOS_TEST_FOR_EXCEPTION (header[0]!=1, std::runtime_error,
+                              "Error! File '" << filename << "' is not a binary vector file.\n");
+
+  Teuchos::RCP<Tpetra_MultiVector> mv = Teuchos::rcp(new Tpetra_MultiVector(map,header[2]));
+  readBinaryMultiVector(filename,*mv);
+  return mv;
+}
+
+} // namespace Albany
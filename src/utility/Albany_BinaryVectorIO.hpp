@@ -0,0 +1,52 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_BINARY_VECTOR_IO_HPP
+#define ALBANY_BINARY_VECTOR_IO_HPP
+
+#include "Albany_TpetraTypes.hpp"
+
+#include <string>
+
+namespace Albany
+{
+
+// Binary multivector files.
+//
+// Layout (native byte order):
+//   char    magic[8]   "ALBVEC01"
+//   int64   M          number of rows
+//   int64   N          number of vectors
+//   double  values[N][M]
+//
+// The vectors are stored one after the other (the same ordering as a
+// MatrixMarket 'array' file), so the value of row i of vector j sits at a
+// fixed offset, and each rank can read its own rows without parsing the
+// rest of the file. Row i of the file holds the entry with the i-th smallest
+// GID of the map (as in the ASCII field files); the GIDs need not be dense.
+//
+// Use the mm2bin utility to convert a MatrixMarket array file.
+
+constexpr int binary_vector_header_size = 24;
+
+// True if the file exists and starts with the binary vector magic string.
+// Only rank 0 opens the file. Collective on comm.
+bool isBinaryVectorFile (const std::string& filename,
+                         const Teuchos::RCP<const Teuchos_Comm>& comm);
+
+// Fill mv from a binary vector file. The map of mv may be overlapping: the
+// rows are read once, on a one-to-one map, and then imported. With MPI, the
+// rows are read with a single collective MPI-IO call. Collective on the
+// communicator of mv's map.
+void readBinaryMultiVector (const std::string& filename, Tpetra_MultiVector& mv);
+
+// Same as above, creating a multivector on map with as many vectors as the file holds
+Teuchos::RCP<Tpetra_MultiVector>
+readBinaryMultiVector (const std::string& filename, const Teuchos::RCP<const Tpetra_Map>& map);
+
+} // namespace Albany
+
+#endif // ALBANY_BINARY_VECTOR_IO_HPP
@@ -8,6 +8,12 @@
 #include "Thyra_DefaultSpmdVectorSpace.hpp"
 #include "Thyra_DefaultSpmdVector.hpp"
 
+#include "Teuchos_SerialDenseMatrix.hpp"
+#include "Teuchos_SerialDenseSolver.hpp"
+
+#include <algorithm>
+#include <vector>
+
 #if defined(ALBANY_EPETRA)
 #include "Albany_EpetraThyraUtils.hpp"
 #include "AztecOO_ConditionNumber.h"
@@ -199,6 +205,122 @@ void setLocalRowValues (const Teuchos::RCP<Thyra_LinearOp>& lop,
   TEUCHOS_TEST_FOR_EXCEPTION (true, std::runtime_error, "Error! Could not cast Thyra_LinearOp to any of the supported concrete types.\n");
 }
 
+void linearCombination (const Teuchos::RCP<Thyra_LinearOp>& lop,
+                        const Teuchos::ArrayView<const ST> coeffs,
+                        const Teuchos::ArrayView<const Teuchos::RCP<const Thyra_LinearOp>> ops)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION (coeffs.size()!=ops.size() || ops.size()==0, std::logic_error,
+                              "Error! linearCombination needs one coefficient per operator, and at least one operator.\n");
+
+  // Allow failure, since we don't know what the underlying linear algebra is
+  auto tmat = getTpetraMatrix(lop,false);
+  if (!tmat.is_null()) {
+    Teuchos::Array<Teuchos::RCP<const Tpetra_CrsMatrix>> tops(ops.size());
+    for (int i=0; i<ops.size(); ++i) {
+      tops[i] = getConstTpetraMatrix(ops[i],true);
+    }
+
+    Teuchos::ArrayView<const LO> indices, op_indices;
+    Teuchos::ArrayView<const ST> op_values;
+    Teuchos::Array<ST> values;
+    const LO num_rows = tmat->getNodeNumRows();
+    for (LO lrow=0; lrow<num_rows; ++lrow) {
+      // Same graph, so the entries of a row come in the same order in all operators
+      tops[0]->getLocalRowView(lrow,indices,op_values);
+      values.resize(op_values.size());
+      for (int k=0; k<op_values.size(); ++k) {
+        values[k] = coeffs[0]*op_values[k];
+      }
+      for (int i=1; i<tops.size(); ++i) {
+        tops[i]->getLocalRowView(lrow,op_indices,op_values);
+        TEUCHOS_TEST_FOR_EXCEPTION (op_values.size()!=values.size(), std::logic_error,
+                                    "Error! The operators in linearCombination do not share the same graph.\n");
+        for (int k=0; k<op_values.size(); ++k) {
+          values[k] += coeffs[i]*op_values[k];
+        }
+      }
+      tmat->replaceLocalValues(lrow,indices,values());
+    }
+    return;
+  }
+
+#ifdef ALBANY_EPETRA
+  // TODO: add epetra
+#endif
+
+  // If all the tries above are not successful, throw an error.
+  TEUCHOS_TEST_FOR_EXCEPTION (true, std::runtime_error, "Error! Could not cast Thyra_LinearOp to any of the supported concrete types.\n");
+}
+
+void invertDiagonalBlocks (const Teuchos::RCP<Thyra_LinearOp>& lop)
+{
+  // Allow failure, since we don't know what the underlying linear algebra is
+  auto tmat = getTpetraMatrix(lop,false);
+  if (!tmat.is_null()) {
+    const auto row_map = tmat->getRowMap();
+    const auto col_map = tmat->getColMap();
+    const LO num_rows = tmat->getNodeNumRows();
+
+    std::vector<bool> done(num_rows,false);
+    Teuchos::ArrayView<const LO> indices, row_indices;
+    Teuchos::ArrayView<const ST> row_values;
+    Teuchos::Array<LO> rows;
+    Teuchos::Array<ST> values;
+    Teuchos::SerialDenseMatrix<int,ST> block;
+    Teuchos::SerialDenseSolver<int,ST> solver;
+    for (LO lrow=0; lrow<num_rows; ++lrow) {
+      if (done[lrow]) {
+        continue;
+      }
+
+      // The columns of the row are the dofs of its block, and so are the rows of the block
+      tmat->getLocalRowView(lrow,indices,row_values);
+      const int n = indices.size();
+      rows.resize(n);
+      for (int i=0; i<n; ++i) {
+        rows[i] = row_map->getLocalElement(col_map->getGlobalElement(indices[i]));
+        TEUCHOS_TEST_FOR_EXCEPTION (rows[i]==Teuchos::OrdinalTraits<LO>::invalid(), std::logic_error,
+                                    "Error! The diagonal block of row " << row_map->getGlobalElement(lrow) << " is not owned by this rank.\n");
+      }
+
+      block.shape(n,n);
+      for (int i=0; i<n; ++i) {
+        tmat->getLocalRowView(rows[i],row_indices,row_values);
+        TEUCHOS_TEST_FOR_EXCEPTION (row_indices.size()!=n, std::logic_error,
+                                    "Error! The matrix is not block diagonal.\n");
+        for (int k=0; k<n; ++k) {
+          const int j = std::find(indices.begin(),indices.end(),row_indices[k]) - indices.begin();
+          TEUCHOS_TEST_FOR_EXCEPTION (j==n, std::logic_error,
+                                      "Error! The matrix is not block diagonal.\n");
+          block(i,j) = row_values[k];
+        }
+        done[rows[i]] = true;
+      }
+
+      solver.setMatrix(Teuchos::rcpFromRef(block));
+      const int info = solver.invert();
+      TEUCHOS_TEST_FOR_EXCEPTION (info!=0, std::runtime_error,
+                                  "Error! The diagonal block of row " << row_map->getGlobalElement(lrow) << " is singular.\n");
+
+      values.resize(n);
+      for (int i=0; i<n; ++i) {
+        for (int j=0; j<n; ++j) {
+          values[j] = block(i,j);
+        }
+        tmat->replaceLocalValues(rows[i],indices,values());
+      }
+    }
+    return;
+  }
+
+#ifdef ALBANY_EPETRA
+  // TODO: add epetra
+#endif
+
+  // If all the tries above are not successful, throw an error.
+  TEUCHOS_TEST_FOR_EXCEPTION (true, std::runtime_error, "Error! Could not cast Thyra_LinearOp to any of the supported concrete types.\n");
+}
+
 double computeConditionNumber (const Teuchos::RCP<const Thyra_LinearOp>& lop)
 {
   double condest = std::numeric_limits<double>::quiet_NaN();
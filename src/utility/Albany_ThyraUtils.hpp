@@ -63,6 +63,14 @@ void addToLocalRowValues (const Teuchos::RCP<Thyra_LinearOp>& lop,
                           const LO lrow,
                           const Teuchos::ArrayView<const LO> indices,
                           const Teuchos::ArrayView<const ST> values);
+// Set the entries of lop to sum_i coeffs[i]*ops[i]. All the operators must
+// have been built on the same graph as lop, and be fill complete.
+void linearCombination (const Teuchos::RCP<Thyra_LinearOp>& lop,
+                        const Teuchos::ArrayView<const ST> coeffs,
+                        const Teuchos::ArrayView<const Teuchos::RCP<const Thyra_LinearOp>> ops);
+// Replace each diagonal block of a block diagonal lop with its inverse.
+// The fill of lop must be active.
+void invertDiagonalBlocks (const Teuchos::RCP<Thyra_LinearOp>& lop);
 
 // Math properties helpers
 double computeConditionNumber (const Teuchos::RCP<const Thyra_LinearOp>& lop);
@@ -0,0 +1,150 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+// @HEADER
+
+#include "EvaluatorMonitor.hpp"
+
+#include <Teuchos_CommHelpers.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace util {
+
+namespace {
+
+// Entries are exchanged as lines of tab separated fields
+string pack (const EvaluatorMonitor::entry_map& entries) {
+  std::ostringstream strm;
+  strm << std::setprecision(17);
+  for (const auto& it : entries) {
+    strm << std::get<0>(it.first) << '\t' << std::get<1>(it.first) << '\t'
+         << std::get<2>(it.first) << '\t' << it.second.calls << '\t'
+         << it.second.cells << '\t' << it.second.bytes << '\t'
+         << it.second.time << '\n';
+  }
+  return strm.str();
+}
+
+void unpackAndSum (const string& packed, EvaluatorMonitor::entry_map& entries) {
+  std::istringstream strm(packed);
+  string line;
+  while (std::getline(strm, line)) {
+    std::istringstream fields(line);
+    string eval_type, block, item;
+    EvaluatorMonitor::Entry in;
+    std::getline(fields, eval_type, '\t');
+    std::getline(fields, block, '\t');
+    std::getline(fields, item, '\t');
+    fields >> in.calls >> in.cells >> in.bytes >> in.time;
+
+    auto& entry = entries[std::make_tuple(eval_type, block, item)];
+    entry.calls += in.calls;
+    entry.cells += in.cells;
+    entry.bytes += in.bytes;
+    entry.time  += in.time;
+    entry.max_time = std::max(entry.max_time, in.time);
+  }
+}
+
+string quoted (const string& s) {
+  string q = "\"";
+  for (const char c : s) {
+    if (c == '"' || c == '\\') q += '\\';
+    q += c;
+  }
+  return q + "\"";
+}
+
+}
+
+void EvaluatorMonitor::add (const string& eval_type, const string& block,
+                            const string& item, const long long calls,
+                            const long long cells, const double bytes,
+                            const double time) {
+  auto& entry = entries_[std::make_tuple(eval_type, block, item)];
+  entry.calls += calls;
+  entry.cells += cells;
+  entry.bytes += bytes;
+  entry.time  += time;
+  entry.max_time = std::max(entry.max_time, entry.time);
+}
+
+EvaluatorMonitor::entry_map
+EvaluatorMonitor::reduce (const Teuchos::Comm<int>& comm) const {
+  const int rank = comm.getRank();
+  const int nprocs = comm.getSize();
+
+  entry_map reduced;
+  if (rank == 0) {
+    unpackAndSum(pack(entries_), reduced);
+    for (int proc = 1; proc < nprocs; ++proc) {
+      int size = 0;
+      Teuchos::receive<int, int>(comm, proc, &size);
+      std::vector<char> buffer(size);
+      if (size > 0)
+        Teuchos::receive<int, char>(comm, proc, size, buffer.data());
+      unpackAndSum(string(buffer.begin(), buffer.end()), reduced);
+    }
+  } else {
+    const string packed = pack(entries_);
+    const int size = packed.size();
+    Teuchos::send<int, int>(comm, size, 0);
+    if (size > 0)
+      Teuchos::send<int, char>(comm, size, packed.data(), 0);
+  }
+  return reduced;
+}
+
+void EvaluatorMonitor::summarize (Teuchos::Ptr<const Teuchos::Comm<int> > comm,
+                                  std::ostream &out, const bool json) const {
+  const entry_map reduced = reduce(*comm);
+
+  if (comm->getRank() != 0) return;
+
+  if (json)
+    writeJSON(reduced, out);
+  else
+    writeCSV(reduced, out);
+}
+
+void EvaluatorMonitor::writeCSV (const entry_map& entries,
+                                 std::ostream& out) const {
+  out << "Evaluation Type,Element Block,Evaluator,Calls,Cells,"
+      << "Estimated Bytes,Total Time (s),Max Rank Time (s)\n";
+  out << std::setprecision(9);
+  for (const auto& it : entries) {
+    out << quoted(std::get<0>(it.first)) << ','
+        << quoted(std::get<1>(it.first)) << ','
+        << quoted(std::get<2>(it.first)) << ',' << it.second.calls << ','
+        << it.second.cells << ',' << it.second.bytes << ',' << it.second.time
+        << ',' << it.second.max_time << '\n';
+  }
+}
+
+void EvaluatorMonitor::writeJSON (const entry_map& entries,
+                                  std::ostream& out) const {
+  out << "[";
+  out << std::setprecision(9);
+  bool first = true;
+  for (const auto& it : entries) {
+    out << (first ? "\n" : ",\n");
+    out << "  {\"evaluation_type\": " << quoted(std::get<0>(it.first))
+        << ", \"element_block\": " << quoted(std::get<1>(it.first))
+        << ", \"evaluator\": " << quoted(std::get<2>(it.first))
+        << ", \"calls\": " << it.second.calls
+        << ", \"cells\": " << it.second.cells
+        << ", \"estimated_bytes\": " << it.second.bytes
+        << ", \"total_time\": " << it.second.time
+        << ", \"max_rank_time\": " << it.second.max_time << "}";
+    first = false;
+  }
+  out << "\n]\n";
+}
+
+}
@@ -0,0 +1,78 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+// @HEADER
+
+#ifndef UTIL_EVALUATORMONITOR_HPP
+#define UTIL_EVALUATORMONITOR_HPP
+
+/**
+ *  \file EvaluatorMonitor.hpp
+ *
+ *  \brief Accumulates time, call counts, cells and estimated bytes moved
+ *         by evaluation type, element block and evaluator.
+ */
+
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_PtrDecl.hpp>
+#include <iostream>
+#include <map>
+#include <tuple>
+
+#include "string.hpp"
+
+namespace util {
+
+class EvaluatorMonitor {
+public:
+
+  struct Entry {
+    long long calls = 0;
+    long long cells = 0;
+    double    bytes = 0.0;
+    double    time  = 0.0;
+    // Largest time on a single rank (only meaningful after reduction)
+    double    max_time = 0.0;
+  };
+
+  // (evaluation type, element block, evaluator)
+  typedef std::tuple<string, string, string> key_type;
+  typedef std::map<key_type, Entry> entry_map;
+
+  void add (const string& eval_type, const string& block, const string& item,
+            const long long calls, const long long cells, const double bytes,
+            const double time);
+
+  bool empty () const {
+    return entries_.empty();
+  }
+
+  void clear () {
+    entries_.clear();
+  }
+
+  const entry_map& entries () const {
+    return entries_;
+  }
+
+  //! Sum the entries of all ranks on rank 0 and write them there, as CSV
+  //! or as JSON. Collective on comm.
+  void summarize (Teuchos::Ptr<const Teuchos::Comm<int> > comm,
+                  std::ostream &out, const bool json = false) const;
+
+private:
+
+  entry_map reduce (const Teuchos::Comm<int>& comm) const;
+
+  void writeCSV (const entry_map& entries, std::ostream& out) const;
+  void writeJSON (const entry_map& entries, std::ostream& out) const;
+
+  entry_map entries_;
+};
+
+}
+
+#endif  // UTIL_EVALUATORMONITOR_HPP
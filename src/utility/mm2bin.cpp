@@ -0,0 +1,77 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+// Convert an ASCII vector file to the binary vector format read by
+// Albany::readBinaryMultiVector (see Albany_BinaryVectorIO.hpp).
+//
+// Accepted inputs are MatrixMarket 'array real general' files (such as
+// reference_solution.dat) and the ASCII field files read by the STK mesh
+// structs ('numNodes [numComponents]' followed by the values).
+//
+// Usage: mm2bin input output
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " input output\n";
+    return 1;
+  }
+
+  std::ifstream ifile(argv[1]);
+  if (!ifile.is_open()) {
+    std::cerr << "Error! Cannot open file '" << argv[1] << "'.\n";
+    return 1;
+  }
+
+  std::string line;
+  std::getline(ifile, line);
+  if (line.compare(0, 14, "%%MatrixMarket") == 0) {
+    if (line.find("array") == std::string::npos) {
+      std::cerr << "Error! Only MatrixMarket array files are supported.\n";
+      return 1;
+    }
+    // Skip the comment lines
+    while (std::getline(ifile, line) && line[0] == '%') {}
+  }
+
+  std::int64_t dims[2] = {0, 1};
+  std::istringstream dims_stream(line);
+  dims_stream >> dims[0];
+  dims_stream >> dims[1];
+  if (dims[0] <= 0 || dims[1] <= 0) {
+    std::cerr << "Error! Cannot read the dimensions in file '" << argv[1] << "'.\n";
+    return 1;
+  }
+
+  std::ofstream ofile(argv[2], std::ios::binary);
+  if (!ofile.is_open()) {
+    std::cerr << "Error! Cannot open file '" << argv[2] << "'.\n";
+    return 1;
+  }
+  ofile.write("ALBVEC01", 8);
+  ofile.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+
+  const std::int64_t size = dims[0] * dims[1];
+  for (std::int64_t i = 0; i < size; ++i) {
+    double value;
+    if (!(ifile >> value)) {
+      std::cerr << "Error! File '" << argv[1] << "' holds " << i
+                << " values, expected " << size << ".\n";
+      return 1;
+    }
+    ofile.write(reinterpret_cast<const char*>(&value), sizeof(double));
+  }
+
+  std::cout << "Wrote " << dims[1] << " vectors with " << dims[0]
+            << " rows to '" << argv[2] << "'.\n";
+  return 0;
+}
@@ -0,0 +1,39 @@
+# Run the problem with Lumped Mass Explicit Stepping, then compare the Exodus
+# files of every rank with the ones of the consistent-mass run REF_OUTPUT
+
+message("Running the command:")
+message("${TEST_PROG} " " ${TEST_ARGS}")
+
+EXECUTE_PROCESS(COMMAND ${TEST_PROG} ${TEST_ARGS}
+                RESULT_VARIABLE HAD_ERROR)
+
+if(HAD_ERROR)
+	message(FATAL_ERROR "Albany didn't run: test failed")
+endif()
+
+if (NOT SEACAS_EXODIFF)
+  message(FATAL_ERROR "Cannot find exodiff")
+endif()
+
+# One file per rank, or a single file in serial
+file(GLOB REF_FILES ${REF_OUTPUT} ${REF_OUTPUT}.*)
+list(LENGTH REF_FILES NUM_FILES)
+if(NUM_FILES EQUAL 0)
+	message(FATAL_ERROR "Cannot find the output of ${REF_OUTPUT}")
+endif()
+
+foreach(REF_FILE ${REF_FILES})
+  string(REPLACE ${REF_OUTPUT} ${TEST_OUTPUT} TEST_FILE ${REF_FILE})
+  SET(EXODIFF_TEST ${SEACAS_EXODIFF} ${TEST_FILE} ${REF_FILE})
+
+  message("Running the command:")
+  message("${EXODIFF_TEST}")
+
+  EXECUTE_PROCESS(
+      COMMAND ${EXODIFF_TEST}
+      RESULT_VARIABLE HAD_ERROR)
+
+  if(HAD_ERROR)
+	  message(FATAL_ERROR "Test failed")
+  endif()
+endforeach()